@@ -941,6 +941,26 @@ extern "C" {
  */
 #define GLFW_POSITION_Y             0x0002000F
 
+/*! @brief Frame throttling window attribute.
+ *
+ *  Frame throttling [window attribute](@ref GLFW_THROTTLED_attrib).
+ */
+#define GLFW_THROTTLED              0x00020010
+
+/*! @brief Window occlusion window attribute.
+ *
+ *  Window occlusion [window attribute](@ref GLFW_OCCLUDED_attrib).
+ */
+#define GLFW_OCCLUDED               0x00020011
+
+/*! @brief Occluded buffer swap skipping window hint and attribute.
+ *
+ *  Occluded buffer swap skipping
+ *  [window hint](@ref GLFW_SKIP_OCCLUDED_SWAP_hint) and
+ *  [window attribute](@ref GLFW_SKIP_OCCLUDED_SWAP_attrib).
+ */
+#define GLFW_SKIP_OCCLUDED_SWAP     0x00020012
+
 /*! @brief Framebuffer bit depth hint.
  *
  *  Framebuffer bit depth [hint](@ref GLFW_RED_BITS).
@@ -1182,6 +1202,52 @@ extern "C" {
 
 #define GLFW_ANY_POSITION           0x80000000
 
+/*! @defgroup event_masks Window event mask bits
+ *  @brief Window event mask bits.
+ *
+ *  See [window event masks](@ref window_event_mask) for how these are used.
+ *
+ *  @ingroup window
+ *  @{ */
+
+/*! @brief Key and character input events.
+ *
+ *  Key, character and character with modifiers events.
+ */
+#define GLFW_EVENT_MASK_KEY           0x0001
+/*! @brief Mouse button and scroll events.
+ *
+ *  Mouse button and scroll events.
+ */
+#define GLFW_EVENT_MASK_MOUSE_BUTTON  0x0002
+/*! @brief Cursor motion events.
+ *
+ *  Cursor position events.
+ */
+#define GLFW_EVENT_MASK_CURSOR_POS    0x0004
+/*! @brief Cursor enter and leave events.
+ *
+ *  Cursor enter and leave events.
+ */
+#define GLFW_EVENT_MASK_CURSOR_ENTER  0x0008
+/*! @brief Window content damage events.
+ *
+ *  Window refresh events.
+ */
+#define GLFW_EVENT_MASK_REFRESH       0x0010
+/*! @brief All event categories.
+ *
+ *  All of the above event categories.  This is the default.
+ */
+#define GLFW_EVENT_MASK_ALL           0x001f
+/*! @brief Derive the event mask from the installed callbacks.
+ *
+ *  If this bit is set, GLFW adds every event category that has a callback
+ *  installed or that is needed by the current cursor mode.
+ */
+#define GLFW_EVENT_MASK_AUTO          0x0100
+/*! @} */
+
 /*! @defgroup shapes Standard cursor shapes
  *  @brief Standard system cursor shapes.
  *
@@ -1291,6 +1357,20 @@ extern "C" {
 #define GLFW_CONNECTED              0x00040001
 #define GLFW_DISCONNECTED           0x00040002
 
+/*! @addtogroup init
+ *  @{ */
+/*! @brief The beginning of a traced span.
+ *
+ *  The beginning of a [traced span](@ref tracing) of work.
+ */
+#define GLFW_TRACE_BEGIN            0x00070001
+/*! @brief The end of a traced span.
+ *
+ *  The end of a [traced span](@ref tracing) of work.
+ */
+#define GLFW_TRACE_END              0x00070002
+/*! @} */
+
 /*! @addtogroup init
  *  @{ */
 /*! @brief Joystick hat buttons init hint.
@@ -1308,6 +1388,21 @@ extern "C" {
  *  Platform selection [init hint](@ref GLFW_PLATFORM).
  */
 #define GLFW_PLATFORM               0x00050003
+/*! @brief Joystick service thread init hint.
+ *
+ *  Joystick service thread [init hint](@ref GLFW_JOYSTICK_THREAD_hint).
+ */
+#define GLFW_JOYSTICK_THREAD        0x00050004
+/*! @brief Event wait spin margin init hint.
+ *
+ *  Event wait spin margin [init hint](@ref GLFW_WAIT_SPIN_MARGIN_hint).
+ */
+#define GLFW_WAIT_SPIN_MARGIN       0x00050005
+/*! @brief Library retention init hint.
+ *
+ *  Library retention [init hint](@ref GLFW_RETAIN_LIBRARIES_hint).
+ */
+#define GLFW_RETAIN_LIBRARIES       0x00050006
 /*! @brief macOS specific init hint.
  *
  *  macOS specific [init hint](@ref GLFW_COCOA_CHDIR_RESOURCES_hint).
@@ -1323,11 +1418,21 @@ extern "C" {
  *  X11 specific [init hint](@ref GLFW_X11_XCB_VULKAN_SURFACE_hint).
  */
 #define GLFW_X11_XCB_VULKAN_SURFACE 0x00052001
+/*! @brief X11 specific init hint.
+ *
+ *  X11 specific [init hint](@ref GLFW_X11_STRICT_QUERIES_hint).
+ */
+#define GLFW_X11_STRICT_QUERIES     0x00052002
 /*! @brief Wayland specific init hint.
  *
  *  Wayland specific [init hint](@ref GLFW_WAYLAND_LIBDECOR_hint).
  */
 #define GLFW_WAYLAND_LIBDECOR       0x00053001
+/*! @brief Wayland specific init hint.
+ *
+ *  Wayland specific [init hint](@ref GLFW_WAYLAND_KEYMAP_THREAD_hint).
+ */
+#define GLFW_WAYLAND_KEYMAP_THREAD  0x00053002
 /*! @} */
 
 /*! @addtogroup init
@@ -1590,6 +1695,32 @@ typedef void (* GLFWdeallocatefun)(void* block, void* user);
  */
 typedef void (* GLFWerrorfun)(int error_code, const char* description);
 
+/*! @brief The function pointer type for trace callbacks.
+ *
+ *  This is the function pointer type for trace callbacks.  A trace callback
+ *  function has the following signature:
+ *  @code
+ *  void callback_name(int event, const char* name, uint64_t time)
+ *  @endcode
+ *
+ *  @param[in] event One of `GLFW_TRACE_BEGIN` or `GLFW_TRACE_END`.
+ *  @param[in] name The name of the span.  Spans with the same name are
+ *  properly nested on each thread.
+ *  @param[in] time The time of the event, as the value @ref
+ *  glfwGetTimerValue would have returned.
+ *
+ *  @pointer_lifetime The name string is static and remains valid until the
+ *  library is unloaded.
+ *
+ *  @sa @ref tracing
+ *  @sa @ref glfwSetTraceCallback
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup init
+ */
+typedef void (* GLFWtracefun)(int event, const char* name, uint64_t time);
+
 /*! @brief The function pointer type for window position callbacks.
  *
  *  This is the function pointer type for window position callbacks.  A window
@@ -1738,6 +1869,27 @@ typedef void (* GLFWwindowiconifyfun)(GLFWwindow* window, int iconified);
  */
 typedef void (* GLFWwindowmaximizefun)(GLFWwindow* window, int maximized);
 
+/*! @brief The function pointer type for window occlusion callbacks.
+ *
+ *  This is the function pointer type for window occlusion callbacks.  A window
+ *  occlusion callback function has the following signature:
+ *  @code
+ *  void function_name(GLFWwindow* window, int occluded)
+ *  @endcode
+ *
+ *  @param[in] window The window whose occlusion state changed.
+ *  @param[in] occluded `GLFW_TRUE` if the window can no longer be seen, or
+ *  `GLFW_FALSE` if it can be seen again.
+ *
+ *  @sa @ref window_occlusion
+ *  @sa @ref glfwSetWindowOcclusionCallback
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup window
+ */
+typedef void (* GLFWwindowocclusionfun)(GLFWwindow* window, int occluded);
+
 /*! @brief The function pointer type for framebuffer size callbacks.
  *
  *  This is the function pointer type for framebuffer size callbacks.
@@ -2106,6 +2258,7 @@ typedef struct GLFWimage
  *
  *  @sa @ref gamepad
  *  @sa @ref glfwGetGamepadState
+ *  @sa @ref glfwGetGamepadStateSnapshot
  *
  *  @since Added in version 3.3.
  *
@@ -2123,6 +2276,111 @@ typedef struct GLFWgamepadstate
     float axes[6];
 } GLFWgamepadstate;
 
+/*! @brief Keyboard and mouse input state
+ *
+ *  This describes the keyboard and mouse input state of a window, as retrieved
+ *  by @ref glfwGetInputSnapshot.  Key and mouse button states are packed as
+ *  bitsets, where the state of a key is bit `key % 32` of `keys[key / 32]` and
+ *  the state of a mouse button is bit `button` of `mouseButtons`.
+ *
+ *  @sa @ref input_snapshot
+ *  @sa @ref glfwGetInputSnapshot
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup input
+ */
+typedef struct GLFWinputsnapshot
+{
+    /*! The [keys](@ref keys) that are reported as pressed, one bit per key.
+     */
+    uint32_t keys[(GLFW_KEY_LAST + 32) / 32];
+    /*! The [mouse buttons](@ref buttons) that are reported as pressed, one bit
+     *  per button.
+     */
+    uint32_t mouseButtons;
+    /*! The [modifier keys](@ref mods) that are held down.
+     */
+    int mods;
+    /*! The cursor position, in screen coordinates relative to the upper-left
+     *  corner of the content area.
+     */
+    double cursorX;
+    /*! See `cursorX`.
+     */
+    double cursorY;
+    /*! The horizontal scroll offset accumulated since the last snapshot.
+     */
+    double scrollX;
+    /*! The vertical scroll offset accumulated since the last snapshot.
+     */
+    double scrollY;
+} GLFWinputsnapshot;
+
+/*! @brief The number of buckets in a frame time histogram.
+ *
+ *  The number of one millisecond buckets in the frame time histogram of @ref
+ *  GLFWframestats.
+ *
+ *  @ingroup window
+ */
+#define GLFW_FRAME_HISTOGRAM_SIZE 64
+
+/*! @brief Buffer swap statistics
+ *
+ *  This describes the buffer swap timing of a window, as retrieved by @ref
+ *  glfwGetFrameStats.  All times are in seconds.
+ *
+ *  @sa @ref buffer_swap_stats
+ *  @sa @ref glfwGetFrameStats
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup window
+ */
+typedef struct GLFWframestats
+{
+    /*! The number of times @ref glfwSwapBuffers has been called for the
+     *  window.
+     */
+    uint64_t frames;
+    /*! The time spent in the most recent call to @ref glfwSwapBuffers.
+     */
+    double swapTime;
+    /*! The average time spent in @ref glfwSwapBuffers.
+     */
+    double averageSwapTime;
+    /*! The longest time spent in @ref glfwSwapBuffers.
+     */
+    double maxSwapTime;
+    /*! The time between the two most recent buffer swaps.
+     */
+    double frameTime;
+    /*! The average time between buffer swaps.
+     */
+    double averageFrameTime;
+    /*! The number of frame times, the times between buffer swaps, that fell
+     *  in each millisecond.  Element `i` counts frame times of at least `i`
+     *  and less than `i + 1` milliseconds, except the last element, which
+     *  counts all longer frame times as well.
+     */
+    unsigned int histogram[GLFW_FRAME_HISTOGRAM_SIZE];
+    /*! `GLFW_TRUE` if the following presentation counters are available, or
+     *  `GLFW_FALSE` otherwise.
+     */
+    int syncValues;
+    /*! The unadjusted system time of the most recent vertical retrace, in
+     *  microseconds.
+     */
+    int64_t ust;
+    /*! The media stream counter, the number of vertical retraces.
+     */
+    int64_t msc;
+    /*! The swap buffer counter, the number of completed buffer swaps.
+     */
+    int64_t sbc;
+} GLFWframestats;
+
 /*! @brief Custom heap memory allocator.
  *
  *  This describes a custom heap memory allocator for GLFW.  To set an allocator, pass it
@@ -2503,6 +2761,50 @@ GLFWAPI int glfwGetError(const char** description);
  */
 GLFWAPI GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun callback);
 
+/*! @brief Sets the trace callback.
+ *
+ *  This function sets the trace callback, which is called at the beginning and
+ *  end of spans of work inside GLFW that commonly affect frame times.  These
+ *  include event processing and the dispatch of each event, buffer swaps,
+ *  making contexts current, the stages of window creation and joystick
+ *  polling.  This lets a frame profiler attribute time spent inside GLFW.
+ *
+ *  The trace callback is called on the thread doing the work.  If you are
+ *  using GLFW from multiple threads, your trace callback needs to be written
+ *  accordingly.  It should return quickly, as it is called very often.
+ *
+ *  The callback is read without synchronization by every thread doing traced
+ *  work, so it should be set before any windows are created or other threads
+ *  call GLFW, and not changed while they may be running.
+ *
+ *  If the library was built without tracing support, the callback is never
+ *  called.
+ *
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void callback_name(int event, const char* name, uint64_t time)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [callback pointer type](@ref GLFWtracefun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread,
+ *  while no other thread may be doing traced work.
+ *
+ *  @sa @ref tracing
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup init
+ */
+GLFWAPI GLFWtracefun glfwSetTraceCallback(GLFWtracefun callback);
+
 /*! @brief Returns the currently selected platform.
  *
  *  This function returns the platform that was selected during initialization.  The
@@ -4121,6 +4423,7 @@ GLFWAPI int glfwGetWindowAttrib(GLFWwindow* window, int attrib);
  *  [GLFW_AUTO_ICONIFY](@ref GLFW_AUTO_ICONIFY_attrib) and
  *  [GLFW_FOCUS_ON_SHOW](@ref GLFW_FOCUS_ON_SHOW_attrib).
  *  [GLFW_MOUSE_PASSTHROUGH](@ref GLFW_MOUSE_PASSTHROUGH_attrib)
+ *  [GLFW_SKIP_OCCLUDED_SWAP](@ref GLFW_SKIP_OCCLUDED_SWAP_attrib)
  *
  *  Some of these attributes are ignored for full screen windows.  The new
  *  value will take effect if the window is later made windowed.
@@ -4197,6 +4500,69 @@ GLFWAPI void glfwSetWindowUserPointer(GLFWwindow* window, void* pointer);
  */
 GLFWAPI void* glfwGetWindowUserPointer(GLFWwindow* window);
 
+/*! @brief Sets the event categories delivered to the specified window.
+ *
+ *  This function sets which categories of input events the window system
+ *  should deliver to the specified window.  Windows that never need cursor
+ *  motion, like hidden helper windows or video previews, can use this to avoid
+ *  being woken for events nobody will handle.
+ *
+ *  Focus, close, size, position and other window state events are always
+ *  delivered, as GLFW needs them to keep its own state correct.
+ *
+ *  If the mask includes @ref GLFW_EVENT_MASK_AUTO, GLFW adds to it every
+ *  category with a callback installed for the window and updates it as
+ *  callbacks are set and removed.  The cursor position category is also added
+ *  while the cursor is disabled.
+ *
+ *  Key and mouse button state as reported by @ref glfwGetKey and @ref
+ *  glfwGetMouseButton is only updated for delivered categories.  Any keys
+ *  still held down when the key category stops being delivered are released.
+ *
+ *  @param[in] window The window whose event mask to set.
+ *  @param[in] mask A bit field of [event mask bits](@ref event_masks), or
+ *  `GLFW_EVENT_MASK_ALL` to deliver all events.  The initial value is
+ *  `GLFW_EVENT_MASK_ALL`.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @remark __Windows, macOS:__ This function only records the mask, as these
+ *  window systems do not allow selecting input events per window.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref window_event_mask
+ *  @sa @ref glfwGetWindowEventMask
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwSetWindowEventMask(GLFWwindow* window, int mask);
+
+/*! @brief Returns the event mask of the specified window.
+ *
+ *  This function returns the event mask most recently set with @ref
+ *  glfwSetWindowEventMask for the specified window.
+ *
+ *  @param[in] window The window whose event mask to query.
+ *  @return The event mask, or zero if an [error](@ref error_handling)
+ *  occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref window_event_mask
+ *  @sa @ref glfwSetWindowEventMask
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwGetWindowEventMask(GLFWwindow* window);
+
 /*! @brief Sets the position callback for the specified window.
  *
  *  This function sets the position callback of the specified window, which is
@@ -4435,6 +4801,49 @@ GLFWAPI GLFWwindowiconifyfun glfwSetWindowIconifyCallback(GLFWwindow* window, GL
  */
 GLFWAPI GLFWwindowmaximizefun glfwSetWindowMaximizeCallback(GLFWwindow* window, GLFWwindowmaximizefun callback);
 
+/*! @brief Sets the occlusion callback for the specified window.
+ *
+ *  This function sets the occlusion callback of the specified window, which is
+ *  called when the window can no longer be seen or can be seen again, for
+ *  example when it is covered by other windows, iconified or hidden.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(GLFWwindow* window, int occluded)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWwindowocclusionfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark @x11 A window is occluded while it is unmapped, iconified, hidden by
+ *  the window manager or fully obscured by other windows.  Most compositing
+ *  window managers never report windows as obscured.
+ *
+ *  @remark @macos A window is occluded while no part of it is visible on
+ *  screen, as reported by the window occlusion state.
+ *
+ *  @remark @win32 A window is only occluded while it is hidden or iconified.
+ *
+ *  @remark @wayland A window is only occluded while it is hidden, as the
+ *  compositor does not tell clients whether their windows can be seen.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref window_occlusion
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup window
+ */
+GLFWAPI GLFWwindowocclusionfun glfwSetWindowOcclusionCallback(GLFWwindow* window, GLFWwindowocclusionfun callback);
+
 /*! @brief Sets the framebuffer resize callback for the specified window.
  *
  *  This function sets the framebuffer resize callback of the specified window,
@@ -4628,6 +5037,47 @@ GLFWAPI void glfwWaitEvents(void);
  */
 GLFWAPI void glfwWaitEventsTimeout(double timeout);
 
+/*! @brief Waits until events are queued or the deadline is reached and
+ *  processes them.
+ *
+ *  This function puts the calling thread to sleep until at least one event is
+ *  available in the event queue, or until the specified deadline is reached.
+ *  If one or more events are available, it behaves exactly like @ref
+ *  glfwPollEvents, i.e. the events in the queue are processed and the function
+ *  then returns immediately.  Processing events will cause the window and
+ *  input callbacks associated with those events to be called.
+ *
+ *  The deadline is an absolute time in the units of the raw timer, as returned
+ *  by @ref glfwGetTimerValue.  Unlike a relative timeout, the deadline of
+ *  a frame limiter does not drift with the time spent rendering.  If the
+ *  deadline has already passed, this function behaves like @ref glfwPollEvents.
+ *
+ *  If the [GLFW_WAIT_SPIN_MARGIN](@ref GLFW_WAIT_SPIN_MARGIN_hint) init hint is
+ *  set, this function only sleeps until that many microseconds before the
+ *  deadline and then polls for events in a busy loop until any arrive or the
+ *  deadline is reached.  This trades CPU time for sub-millisecond precision.
+ *
+ *  Event processing is not required for joystick input to work.
+ *
+ *  @param[in] deadline The time to wait until, in raw timer units.
+ *
+ *  @reentrancy This function must not be called from a callback.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref events
+ *  @sa @ref glfwWaitEventsTimeout
+ *  @sa @ref glfwGetTimerValue
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwWaitEventsUntil(uint64_t deadline);
+
 /*! @brief Posts an empty event to the event queue.
  *
  *  This function posts an empty event from the current thread to the event
@@ -4648,6 +5098,31 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout);
  */
 GLFWAPI void glfwPostEmptyEvent(void);
 
+/*! @brief Sends any pending window system requests.
+ *
+ *  This function sends any window system requests that GLFW has buffered but
+ *  not yet sent, for example from @ref glfwSetWindowTitle or @ref
+ *  glfwSetWindowPos.  Pending requests are also sent by @ref glfwPollEvents,
+ *  @ref glfwWaitEvents, @ref glfwWaitEventsTimeout and @ref glfwSwapBuffers,
+ *  so this is only needed when a change must take effect before the next call
+ *  to one of those.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark __Windows, macOS:__ This function does nothing, as requests are not
+ *  buffered on these platforms.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref events
+ *  @sa @ref glfwPollEvents
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwFlush(void);
+
 /*! @brief Returns the value of an input option for the specified window.
  *
  *  This function returns the value of an input option for the specified window.
@@ -4938,6 +5413,46 @@ GLFWAPI int glfwGetKey(GLFWwindow* window, int key);
  */
 GLFWAPI int glfwGetMouseButton(GLFWwindow* window, int button);
 
+/*! @brief Retrieves the keyboard and mouse input state of the specified window.
+ *
+ *  This function retrieves the state of all keys and mouse buttons, the
+ *  modifier keys, the cursor position and the scroll offset accumulated since
+ *  the last call for the specified window, in a single call.
+ *
+ *  Key and mouse button states are the same as those returned by @ref
+ *  glfwGetKey and @ref glfwGetMouseButton.  If the @ref GLFW_STICKY_KEYS or
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS input modes are enabled, any keys or mouse
+ *  buttons that were pressed and have since been released are reported as
+ *  pressed and then released, for all of them at once.
+ *
+ *  The caps lock and num lock modifier bits are only included if the @ref
+ *  GLFW_LOCK_KEY_MODS input mode is enabled, and reflect the last key or mouse
+ *  button event.
+ *
+ *  The cursor position is the same as that returned by @ref glfwGetCursorPos.
+ *
+ *  If an [error](@ref error_handling) occurs, all members of the snapshot are
+ *  set to zero.
+ *
+ *  @param[in] window The desired window.
+ *  @param[out] snapshot Where to store the input state of the window.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_snapshot
+ *  @sa @ref glfwGetKey
+ *  @sa @ref glfwGetMouseButton
+ *  @sa @ref glfwGetCursorPos
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwGetInputSnapshot(GLFWwindow* window, GLFWinputsnapshot* snapshot);
+
 /*! @brief Retrieves the position of the cursor relative to the content area of
  *  the window.
  *
@@ -5054,6 +5569,53 @@ GLFWAPI void glfwSetCursorPos(GLFWwindow* window, double xpos, double ypos);
  */
 GLFWAPI GLFWcursor* glfwCreateCursor(const GLFWimage* image, int xhot, int yhot);
 
+/*! @brief Creates an animated custom cursor.
+ *
+ *  Creates a new animated cursor from a sequence of images that can be set for
+ *  a window with @ref glfwSetCursor.  The cursor can be destroyed with @ref
+ *  glfwDestroyCursor.  Any remaining cursors are destroyed by @ref
+ *  glfwTerminate.
+ *
+ *  Every frame is converted and uploaded when the cursor is created.  The
+ *  frames are then stepped by the platform while the cursor is shown, without
+ *  any further calls by the application.  The animation loops forever.
+ *
+ *  All images must have the same size.  The pixels are in the same format as
+ *  for @ref glfwCreateCursor and the hotspot is shared by all frames.
+ *
+ *  @param[in] images The frames of the animation, in order.
+ *  @param[in] delays The time, in milliseconds, that each frame is shown.
+ *  @param[in] count The number of frames.
+ *  @param[in] xhot The desired x-coordinate, in pixels, of the cursor hotspot.
+ *  @param[in] yhot The desired y-coordinate, in pixels, of the cursor hotspot.
+ *  @return The handle of the created cursor, or `NULL` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_PLATFORM_ERROR and @ref
+ *  GLFW_FEATURE_UNIMPLEMENTED (see remarks).
+ *
+ *  @pointer_lifetime The specified image data and delays are copied before this
+ *  function returns.
+ *
+ *  @remark @win32 @macos Animated cursors are not yet implemented.  This
+ *  function will emit @ref GLFW_FEATURE_UNIMPLEMENTED.
+ *
+ *  @remark @x11 The animation requires version 0.8 of the XRender extension.
+ *  Without it, only the first frame is shown.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref cursor_animated
+ *  @sa @ref glfwDestroyCursor
+ *  @sa @ref glfwCreateCursor
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWcursor* glfwCreateAnimatedCursor(const GLFWimage* images, const int* delays, int count, int xhot, int yhot);
+
 /*! @brief Creates a cursor with a standard shape.
  *
  *  Returns a cursor with a standard shape, that can be set for a window with
@@ -5910,6 +6472,74 @@ GLFWAPI const char* glfwGetGamepadName(int jid);
  */
 GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state);
 
+/*! @brief Retrieves the state of all connected gamepads.
+ *
+ *  This function retrieves the state of every connected joystick that has
+ *  a gamepad mapping, remapped to an Xbox-like gamepad, in a single call.  The
+ *  state of the joystick with ID `jid` is written to `states[jid]`.  Entries
+ *  for joysticks that are not present or have no gamepad mapping are zeroed.
+ *
+ *  This is equivalent to calling @ref glfwGetGamepadState for every joystick
+ *  ID less than `count`, but cheaper when polling many joysticks each frame.
+ *
+ *  @param[out] states An array of at least `count` gamepad input states.
+ *  @param[in] count The number of elements in the array.  Elements beyond
+ *  `GLFW_JOYSTICK_LAST + 1` are left untouched.
+ *  @return A bit mask with bit `jid` set for every joystick whose state was
+ *  retrieved, or zero if none were or an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref gamepad
+ *  @sa @ref glfwGetGamepadState
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetAllGamepadStates(GLFWgamepadstate* states, int count);
+
+/*! @brief Retrieves the most recently published gamepad state of a joystick.
+ *
+ *  This function retrieves the most recently published state of the specified
+ *  joystick remapped to an Xbox-like gamepad.  Unlike @ref glfwGetGamepadState,
+ *  it does not poll the device and makes no system calls.  It only copies a
+ *  snapshot that GLFW publishes each time it updates the joystick state, so it
+ *  takes no locks and may be called from any thread.  It is not wait-free, as
+ *  it retries the copy if it races with an update, which is brief.
+ *
+ *  If the [GLFW_JOYSTICK_THREAD](@ref GLFW_JOYSTICK_THREAD_hint) init hint was
+ *  set and is supported on the current platform, the snapshot is published by
+ *  a joystick service thread as soon as new device events arrive.  Otherwise it
+ *  is published when the joystick is connected or disconnected and whenever
+ *  @ref glfwGetGamepadState is called.
+ *
+ *  If the specified joystick is not present or does not have a gamepad mapping
+ *  this function will return `GLFW_FALSE` but will not generate an error.
+ *
+ *  @param[in] jid The [joystick](@ref joysticks) to query.
+ *  @param[out] state The gamepad input state of the joystick.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if no joystick is
+ *  connected, it has no gamepad mapping or an [error](@ref error_handling)
+ *  occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_ENUM.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref gamepad_snapshot
+ *  @sa @ref glfwGetGamepadState
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetGamepadStateSnapshot(int jid, GLFWgamepadstate* state);
+
 /*! @brief Sets the clipboard to the specified string.
  *
  *  This function sets the system clipboard to the specified, UTF-8 encoded
@@ -6177,6 +6807,228 @@ GLFWAPI GLFWwindow* glfwGetCurrentContext(void);
  */
 GLFWAPI void glfwSwapBuffers(GLFWwindow* window);
 
+/*! @brief Swaps the buffers of the specified window, specifying the changed
+ *  areas.
+ *
+ *  This function swaps the front and back buffers of the specified window like
+ *  @ref glfwSwapBuffers, but also tells the window system which parts of the
+ *  new frame have changed since the previous one.  This lets a compositor
+ *  redraw only those parts of the screen.
+ *
+ *  Each damage rectangle is four integers; x, y, width and height, in pixels of
+ *  the framebuffer, with the origin in the lower-left corner as in OpenGL.  If
+ *  no rectangles are specified, the whole frame is considered changed.
+ *
+ *  The damage rectangles are passed on to the window system with the
+ *  `EGL_KHR_swap_buffers_with_damage` or `EGL_EXT_swap_buffers_with_damage`
+ *  extension.  Where neither is available, this function performs a regular
+ *  buffer swap.
+ *
+ *  The specified window must have an OpenGL or OpenGL ES context.  Specifying
+ *  a window without a context will generate a @ref GLFW_NO_WINDOW_CONTEXT
+ *  error.
+ *
+ *  @param[in] window The window whose buffers to swap.
+ *  @param[in] rects The damage rectangles, or `NULL` if the whole frame has
+ *  changed.
+ *  @param[in] count The number of damage rectangles.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT, @ref GLFW_INVALID_VALUE and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @pointer_lifetime The specified rectangles are not referenced after this
+ *  function returns.
+ *
+ *  @remark __EGL:__ The context of the specified window must be current on the
+ *  calling thread.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref buffer_damage
+ *  @sa @ref glfwSwapBuffers
+ *  @sa @ref glfwGetBufferAge
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwSwapBuffersWithDamage(GLFWwindow* window, const int* rects, int count);
+
+/*! @brief Returns the age of the back buffer of the specified window.
+ *
+ *  This function returns the number of buffer swaps since the current back
+ *  buffer of the specified window was last the front buffer.  If the age is
+ *  one, the back buffer holds the previous frame, and so on.  This lets you
+ *  redraw only the parts of the frame that have changed since then.
+ *
+ *  An age of zero means the contents of the back buffer are undefined and the
+ *  whole frame must be redrawn.  This is also returned if the buffer age cannot
+ *  be queried, which requires the `EGL_EXT_buffer_age` extension.
+ *
+ *  The specified window must have an OpenGL or OpenGL ES context.  Specifying
+ *  a window without a context will generate a @ref GLFW_NO_WINDOW_CONTEXT
+ *  error.
+ *
+ *  @param[in] window The window whose back buffer to query.
+ *  @return The age of the back buffer, or zero if it is unknown or an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT and @ref GLFW_NO_CURRENT_CONTEXT.
+ *
+ *  @remark __EGL:__ The context of the specified window must be current on the
+ *  calling thread.  Otherwise a @ref GLFW_NO_CURRENT_CONTEXT error is
+ *  generated.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref buffer_damage
+ *  @sa @ref glfwSwapBuffersWithDamage
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwGetBufferAge(GLFWwindow* window);
+
+/*! @brief Presents software rendered pixels in the specified window.
+ *
+ *  This function displays an image rendered on the CPU in the content area of
+ *  the specified window, without the need for an OpenGL or OpenGL ES context.
+ *  The image is placed at the upper-left corner of the framebuffer, with one
+ *  image pixel per framebuffer pixel.  The image should normally be the size of
+ *  the [framebuffer](@ref window_fbsize).
+ *
+ *  The pixels are 32-bit, little-endian BGRX, i.e. eight bits per channel with
+ *  the blue channel first and the fourth byte ignored.  They are arranged as
+ *  rows, starting from the top-left corner, with the specified number of bytes
+ *  from the start of one row to the next.
+ *
+ *  The damage rectangles tell GLFW which parts of the image have changed since
+ *  the previous call, so that only those parts need to be copied and redrawn.
+ *  Each rectangle is four integers; x, y, width and height, in pixels.  If no
+ *  rectangles are specified, the whole image is presented.
+ *
+ *  The specified window must have been created with the
+ *  [GLFW_CLIENT_API](@ref GLFW_CLIENT_API_hint) hint set to `GLFW_NO_API`.
+ *  A window with a Vulkan surface must not present pixels with this function.
+ *
+ *  @param[in] window The window to present the pixels in.
+ *  @param[in] width The width, in pixels, of the image.
+ *  @param[in] height The height, in pixels, of the image.
+ *  @param[in] pixels The image data.
+ *  @param[in] stride The number of bytes from the start of one row to the
+ *  next, which must be at least four times the width.
+ *  @param[in] rects The damage rectangles, or `NULL` to present the whole
+ *  image.
+ *  @param[in] count The number of damage rectangles.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_FORMAT_UNAVAILABLE, @ref GLFW_PLATFORM_ERROR
+ *  and @ref GLFW_FEATURE_UNIMPLEMENTED (see remarks).
+ *
+ *  @pointer_lifetime The specified pixels and rectangles are copied before
+ *  this function returns.
+ *
+ *  @remark @win32 @macos This function is not yet implemented and will emit
+ *  @ref GLFW_FEATURE_UNIMPLEMENTED.
+ *
+ *  @remark @x11 The pixels are copied into shared memory with the MIT-SHM
+ *  extension when the server supports it, otherwise they are sent over the
+ *  connection.  The window visual must be a 24-bit or 32-bit TrueColor visual
+ *  with the usual channel masks, otherwise this function emits @ref
+ *  GLFW_FORMAT_UNAVAILABLE.
+ *
+ *  @remark @wayland The image is attached to the window surface, so a window
+ *  is not shown by the compositor until pixels have been presented to it.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref buffer_present
+ *  @sa @ref glfwSwapBuffers
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwPresentPixels(GLFWwindow* window, int width, int height, const unsigned char* pixels, int stride, const int* rects, int count);
+
+/*! @brief Waits until the window system is ready for a new frame.
+ *
+ *  This function processes events until the window system is ready to show
+ *  a new frame of the specified window or the timeout has passed.  A window is
+ *  not ready while its [GLFW_THROTTLED](@ref GLFW_THROTTLED_attrib) attribute
+ *  is set.  If the window is already ready, this function returns immediately
+ *  without processing any events.
+ *
+ *  Events are processed as by @ref glfwWaitEventsTimeout, so window and input
+ *  callbacks may be called before this function returns.
+ *
+ *  @param[in] window The window to wait for.
+ *  @param[in] timeout The maximum amount of time, in seconds, to wait.
+ *  @return `GLFW_TRUE` if the window is ready for a new frame, or `GLFW_FALSE`
+ *  if the timeout passed or an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @wayland The window is ready once the compositor signals that it is
+ *  a good time to draw the next frame, which it will not do while the window
+ *  cannot be seen.  This only tracks frames presented with @ref glfwSwapBuffers
+ *  or @ref glfwPresentPixels.
+ *
+ *  @reentrancy This function must not be called from a callback, and the
+ *  window must not be destroyed by a callback while waiting.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref buffer_throttle
+ *  @sa @ref GLFW_THROTTLED_attrib
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwWaitForFrame(GLFWwindow* window, double timeout);
+
+/*! @brief Retrieves the buffer swap statistics of the specified window.
+ *
+ *  This function retrieves the buffer swap statistics of the specified window.
+ *  These include the time spent in @ref glfwSwapBuffers, the time between
+ *  swaps and a histogram of those frame times.  The time is measured on the
+ *  CPU by GLFW, so it is available with every context creation API.
+ *
+ *  If the `GLX_OML_sync_control` or `EGL_CHROMIUM_sync_control` extension is
+ *  available, the presentation counters of the window are also retrieved.  By
+ *  comparing how the media stream counter and swap buffer counter advance
+ *  between calls, you can detect missed vertical retraces.
+ *
+ *  If an [error](@ref error_handling) occurs, all members of the statistics
+ *  are set to zero.
+ *
+ *  @param[in] window The window whose statistics to retrieve.
+ *  @param[out] stats Where to store the statistics of the window.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_NO_WINDOW_CONTEXT.
+ *
+ *  @remark __GLX, EGL:__ The context of the specified window must be current on
+ *  the calling thread for the presentation counters to be retrieved.
+ *
+ *  @thread_safety This function must only be called from the main thread or
+ *  the thread on which the context of the specified window is current.  It
+ *  must not be called while another thread swaps the buffers of the window.
+ *
+ *  @sa @ref buffer_swap_stats
+ *  @sa @ref glfwSwapBuffers
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwGetFrameStats(GLFWwindow* window, GLFWframestats* stats);
+
 /*! @brief Sets the swap interval for the current context.
  *
  *  This function sets the swap interval for the current OpenGL or OpenGL ES
@@ -6303,6 +7155,49 @@ GLFWAPI int glfwExtensionSupported(const char* extension);
  */
 GLFWAPI GLFWglproc glfwGetProcAddress(const char* procname);
 
+/*! @brief Returns the addresses of the specified functions for the current
+ *  context.
+ *
+ *  This function retrieves the addresses of several OpenGL or OpenGL ES
+ *  [core or extension functions](@ref context_glext) for the current context
+ *  in a single call.  Each element of `procs` is set to the address of the
+ *  function named by the corresponding element of `names`, or to `NULL` if
+ *  that function is not supported.
+ *
+ *  Where the context creation API returns the same addresses for every context
+ *  of a given client API, the addresses are resolved only once and are then
+ *  shared by all such contexts.  This makes loading the entry points of
+ *  additional contexts considerably cheaper.
+ *
+ *  A context must be current on the calling thread.  Calling this function
+ *  without a current context will cause a @ref GLFW_NO_CURRENT_CONTEXT error.
+ *
+ *  @param[in] names The ASCII encoded names of the functions.
+ *  @param[out] procs Where to store the addresses of the functions.
+ *  @param[in] count The number of elements in `names` and `procs`.
+ *  @return The number of functions that were found, or zero if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_CURRENT_CONTEXT and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark The same caveats apply to the returned addresses as to those
+ *  returned by @ref glfwGetProcAddress.
+ *
+ *  @pointer_lifetime The returned function pointers are valid until the
+ *  context is destroyed or the library is terminated.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref context_glext
+ *  @sa @ref glfwGetProcAddress
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup context
+ */
+GLFWAPI int glfwGetProcAddresses(const char* const* names, GLFWglproc* procs, int count);
+
 /*! @brief Returns whether the Vulkan loader and an ICD have been found.
  *
  *  This function returns whether the Vulkan loader and any minimally functional
@@ -503,6 +503,7 @@ GLFWbool _glfwConnectCocoa(int platformID, _GLFWplatform* platform)
         .rawMouseMotionSupported = _glfwRawMouseMotionSupportedCocoa,
         .createCursor = _glfwCreateCursorCocoa,
         .createStandardCursor = _glfwCreateStandardCursorCocoa,
+        .createAnimatedCursor = _glfwCreateAnimatedCursorCocoa,
         .destroyCursor = _glfwDestroyCursorCocoa,
         .setCursor = _glfwSetCursorCocoa,
         .getScancodeName = _glfwGetScancodeNameCocoa,
@@ -548,6 +549,8 @@ GLFWbool _glfwConnectCocoa(int platformID, _GLFWplatform* platform)
         .windowVisible = _glfwWindowVisibleCocoa,
         .windowMaximized = _glfwWindowMaximizedCocoa,
         .windowHovered = _glfwWindowHoveredCocoa,
+        .windowThrottled = _glfwWindowThrottledCocoa,
+        .windowOccluded = _glfwWindowOccludedCocoa,
         .framebufferTransparent = _glfwFramebufferTransparentCocoa,
         .getWindowOpacity = _glfwGetWindowOpacityCocoa,
         .setWindowResizable = _glfwSetWindowResizableCocoa,
@@ -555,10 +558,13 @@ GLFWbool _glfwConnectCocoa(int platformID, _GLFWplatform* platform)
         .setWindowFloating = _glfwSetWindowFloatingCocoa,
         .setWindowOpacity = _glfwSetWindowOpacityCocoa,
         .setWindowMousePassthrough = _glfwSetWindowMousePassthroughCocoa,
+        .setWindowEventMask = _glfwSetWindowEventMaskCocoa,
+        .presentPixels = _glfwPresentPixelsCocoa,
         .pollEvents = _glfwPollEventsCocoa,
         .waitEvents = _glfwWaitEventsCocoa,
         .waitEventsTimeout = _glfwWaitEventsTimeoutCocoa,
         .postEmptyEvent = _glfwPostEmptyEventCocoa,
+        .flush = _glfwFlushCocoa,
         .getEGLPlatform = _glfwGetEGLPlatformCocoa,
         .getEGLNativeDisplay = _glfwGetEGLNativeDisplayCocoa,
         .getEGLNativeWindow = _glfwGetEGLNativeWindowCocoa,
@@ -240,6 +240,8 @@ GLFWbool _glfwWindowIconifiedCocoa(_GLFWwindow* window);
 GLFWbool _glfwWindowVisibleCocoa(_GLFWwindow* window);
 GLFWbool _glfwWindowMaximizedCocoa(_GLFWwindow* window);
 GLFWbool _glfwWindowHoveredCocoa(_GLFWwindow* window);
+GLFWbool _glfwWindowThrottledCocoa(_GLFWwindow* window);
+GLFWbool _glfwWindowOccludedCocoa(_GLFWwindow* window);
 GLFWbool _glfwFramebufferTransparentCocoa(_GLFWwindow* window);
 void _glfwSetWindowResizableCocoa(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowDecoratedCocoa(_GLFWwindow* window, GLFWbool enabled);
@@ -247,6 +249,8 @@ void _glfwSetWindowFloatingCocoa(_GLFWwindow* window, GLFWbool enabled);
 float _glfwGetWindowOpacityCocoa(_GLFWwindow* window);
 void _glfwSetWindowOpacityCocoa(_GLFWwindow* window, float opacity);
 void _glfwSetWindowMousePassthroughCocoa(_GLFWwindow* window, GLFWbool enabled);
+void _glfwSetWindowEventMaskCocoa(_GLFWwindow* window, int mask);
+void _glfwPresentPixelsCocoa(_GLFWwindow* window, int width, int height, const unsigned char* pixels, int stride, const int* rects, int count);
 
 void _glfwSetRawMouseMotionCocoa(_GLFWwindow *window, GLFWbool enabled);
 GLFWbool _glfwRawMouseMotionSupportedCocoa(void);
@@ -255,6 +259,7 @@ void _glfwPollEventsCocoa(void);
 void _glfwWaitEventsCocoa(void);
 void _glfwWaitEventsTimeoutCocoa(double timeout);
 void _glfwPostEmptyEventCocoa(void);
+void _glfwFlushCocoa(void);
 
 void _glfwGetCursorPosCocoa(_GLFWwindow* window, double* xpos, double* ypos);
 void _glfwSetCursorPosCocoa(_GLFWwindow* window, double xpos, double ypos);
@@ -263,6 +268,7 @@ const char* _glfwGetScancodeNameCocoa(int scancode);
 int _glfwGetKeyScancodeCocoa(int key);
 GLFWbool _glfwCreateCursorCocoa(_GLFWcursor* cursor, const GLFWimage* image, int xhot, int yhot);
 GLFWbool _glfwCreateStandardCursorCocoa(_GLFWcursor* cursor, int shape);
+GLFWbool _glfwCreateAnimatedCursorCocoa(_GLFWcursor* cursor, const GLFWimage* images, const int* delays, int count, int xhot, int yhot);
 void _glfwDestroyCursorCocoa(_GLFWcursor* cursor);
 void _glfwSetCursorCocoa(_GLFWwindow* window, _GLFWcursor* cursor);
 void _glfwSetClipboardStringCocoa(const char* string);
@@ -318,6 +318,8 @@ static const NSRange kEmptyRange = { NSNotFound, 0 };
             window->ns.occluded = GLFW_FALSE;
         else
             window->ns.occluded = GLFW_TRUE;
+
+        _glfwInputWindowOcclusion(window, window->ns.occluded);
     }
 }
 
@@ -581,7 +583,7 @@ static const NSRange kEmptyRange = { NSNotFound, 0 };
 
     if (keyFlag & modifierFlags)
     {
-        if (window->keys[key] == GLFW_PRESS)
+        if (_GLFW_BIT_TEST(window->keyBits, key))
             action = GLFW_RELEASE;
         else
             action = GLFW_PRESS;
@@ -900,6 +902,15 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
     return GLFW_TRUE;
 }
 
+// Dispatches an event to the application
+//
+static void sendEvent(NSEvent* event)
+{
+    _GLFW_TRACE_BEGIN("sendEvent");
+    [NSApp sendEvent:event];
+    _GLFW_TRACE_END("sendEvent");
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -924,7 +935,10 @@ GLFWbool _glfwCreateWindowCocoa(_GLFWwindow* window,
 {
     @autoreleasepool {
 
-    if (!createNativeWindow(window, wndconfig, fbconfig))
+    _GLFW_TRACE_BEGIN("createNativeWindow");
+    const GLFWbool created = createNativeWindow(window, wndconfig, fbconfig);
+    _GLFW_TRACE_END("createNativeWindow");
+    if (!created)
         return GLFW_FALSE;
 
     if (ctxconfig->client != GLFW_NO_API)
@@ -1419,6 +1433,20 @@ GLFWbool _glfwWindowHoveredCocoa(_GLFWwindow* window)
     } // autoreleasepool
 }
 
+GLFWbool _glfwWindowThrottledCocoa(_GLFWwindow* window)
+{
+    @autoreleasepool {
+    return window->ns.occluded ||
+           ![window->ns.object isVisible] ||
+           [window->ns.object isMiniaturized];
+    } // autoreleasepool
+}
+
+GLFWbool _glfwWindowOccludedCocoa(_GLFWwindow* window)
+{
+    return window->ns.occluded;
+}
+
 GLFWbool _glfwFramebufferTransparentCocoa(_GLFWwindow* window)
 {
     @autoreleasepool {
@@ -1489,6 +1517,21 @@ void _glfwSetWindowMousePassthroughCocoa(_GLFWwindow* window, GLFWbool enabled)
     }
 }
 
+void _glfwSetWindowEventMaskCocoa(_GLFWwindow* window, int mask)
+{
+}
+
+void _glfwPresentPixelsCocoa(_GLFWwindow* window,
+                             int width, int height,
+                             const unsigned char* pixels,
+                             int stride,
+                             const int* rects,
+                             int count)
+{
+    _glfwInputError(GLFW_FEATURE_UNIMPLEMENTED,
+                    "Cocoa: Presenting pixels not yet implemented");
+}
+
 float _glfwGetWindowOpacityCocoa(_GLFWwindow* window)
 {
     @autoreleasepool {
@@ -1527,7 +1570,8 @@ void _glfwPollEventsCocoa(void)
         if (event == nil)
             break;
 
-        [NSApp sendEvent:event];
+        _glfw.eventCount++;
+        sendEvent(event);
     }
 
     } // autoreleasepool
@@ -1544,7 +1588,7 @@ void _glfwWaitEventsCocoa(void)
                                         untilDate:[NSDate distantFuture]
                                            inMode:NSDefaultRunLoopMode
                                           dequeue:YES];
-    [NSApp sendEvent:event];
+    sendEvent(event);
 
     _glfwPollEventsCocoa();
 
@@ -1561,7 +1605,7 @@ void _glfwWaitEventsTimeoutCocoa(double timeout)
                                            inMode:NSDefaultRunLoopMode
                                           dequeue:YES];
     if (event)
-        [NSApp sendEvent:event];
+        sendEvent(event);
 
     _glfwPollEventsCocoa();
 
@@ -1586,6 +1630,11 @@ void _glfwPostEmptyEventCocoa(void)
     } // autoreleasepool
 }
 
+void _glfwFlushCocoa(void)
+{
+    // Window requests take effect immediately on macOS
+}
+
 void _glfwGetCursorPosCocoa(_GLFWwindow* window, double* xpos, double* ypos)
 {
     @autoreleasepool {
@@ -1827,6 +1876,17 @@ GLFWbool _glfwCreateStandardCursorCocoa(_GLFWcursor* cursor, int shape)
     } // autoreleasepool
 }
 
+GLFWbool _glfwCreateAnimatedCursorCocoa(_GLFWcursor* cursor,
+                                        const GLFWimage* images,
+                                        const int* delays,
+                                        int count,
+                                        int xhot, int yhot)
+{
+    _glfwInputError(GLFW_FEATURE_UNIMPLEMENTED,
+                    "Cocoa: Animated cursors not yet implemented");
+    return GLFW_FALSE;
+}
+
 void _glfwDestroyCursorCocoa(_GLFWcursor* cursor)
 {
     @autoreleasepool {
@@ -32,12 +32,250 @@
 #include <string.h>
 #include <limits.h>
 #include <stdio.h>
+#include <float.h>
+
+
+// Records the timing of a buffer swap that started and ended at the specified
+// timer values
+//
+static void updateFrameStats(_GLFWwindow* window, uint64_t start, uint64_t end)
+{
+    const uint64_t swapTime = end - start;
+
+    window->frameStats.swapTime = swapTime;
+    window->frameStats.totalSwapTime += swapTime;
+    if (swapTime > window->frameStats.maxSwapTime)
+        window->frameStats.maxSwapTime = swapTime;
+
+    if (window->frameStats.frames)
+    {
+        const uint64_t frameTime = end - window->frameStats.lastSwapEnd;
+        uint64_t bucket = frameTime * 1000 / _glfwPlatformGetTimerFrequency();
+
+        if (bucket >= GLFW_FRAME_HISTOGRAM_SIZE)
+            bucket = GLFW_FRAME_HISTOGRAM_SIZE - 1;
+
+        window->frameStats.frameTime = frameTime;
+        window->frameStats.totalFrameTime += frameTime;
+        window->frameStats.histogram[bucket]++;
+    }
+
+    window->frameStats.lastSwapEnd = end;
+    window->frameStats.frames++;
+}
+
+// Swaps the buffers of the window, passing any damage rectangles to the context
+// if it supports them, and traces the swap as the specified span
+//
+static void swapBuffers(_GLFWwindow* window,
+                        const int* rects,
+                        int count,
+                        const char* span)
+{
+    // Send any window requests made since the last event processing so they
+    // take effect along with this frame
+    _glfw.platform.flush();
+
+    if (window->skipOccludedSwap && _glfw.platform.windowOccluded(window))
+        return;
+
+    _GLFW_TRACE_BEGIN(span);
+    const uint64_t start = _glfwPlatformGetTimerValue();
+
+    if (count && window->context.swapBuffersWithDamage)
+        window->context.swapBuffersWithDamage(window, rects, count);
+    else
+        window->context.swapBuffers(window);
+
+    _GLFW_TRACE_END(span);
+    updateFrameStats(window, start, _glfwPlatformGetTimerValue());
+}
+
+// Returns a 32-bit FNV-1a hash of the specified entry point name
+//
+static uint32_t hashProcName(const char* name)
+{
+    uint32_t hash = 2166136261u;
+
+    while (*name)
+        hash = (hash ^ (unsigned char) *name++) * 16777619u;
+
+    return hash;
+}
+
+// Finds or creates the entry point cache for contexts of the same kind as the
+// specified one and adds a reference to it
+// The cache lock must be held
+//
+static _GLFWproccache* acquireProcCache(_GLFWwindow* window)
+{
+    const GLFWbool gles1 = window->context.client == GLFW_OPENGL_ES_API &&
+                           window->context.major == 1;
+    _GLFWproccache* cache;
+
+    for (cache = _glfw.procCacheListHead;  cache;  cache = cache->next)
+    {
+        if (cache->source == window->context.source &&
+            cache->client == window->context.client &&
+            cache->gles1 == gles1)
+        {
+            break;
+        }
+    }
+
+    if (!cache)
+    {
+        cache = _glfw_calloc(1, sizeof(_GLFWproccache));
+        if (!cache)
+            return NULL;
+
+        cache->source = window->context.source;
+        cache->client = window->context.client;
+        cache->gles1 = gles1;
+        cache->next = _glfw.procCacheListHead;
+        _glfw.procCacheListHead = cache;
+    }
+
+    cache->references++;
+    return cache;
+}
+
+// Doubles the size of the hash table of the specified entry point cache
+// The cache lock must be held
+//
+static GLFWbool growProcCache(_GLFWproccache* cache)
+{
+    const uint32_t size = cache->size ? cache->size * 2 : 512;
+    uint32_t i;
+
+    _GLFWprocentry* entries = _glfw_calloc(size, sizeof(_GLFWprocentry));
+    if (!entries)
+        return GLFW_FALSE;
+
+    for (i = 0;  i < cache->size;  i++)
+    {
+        const _GLFWprocentry* entry = cache->entries + i;
+        uint32_t slot;
+
+        if (!entry->name)
+            continue;
+
+        for (slot = entry->hash & (size - 1);
+             entries[slot].name;
+             slot = (slot + 1) & (size - 1))
+        {
+        }
+
+        entries[slot] = *entry;
+    }
+
+    _glfw_free(cache->entries);
+    cache->entries = entries;
+    cache->size = size;
+    return GLFW_TRUE;
+}
+
+// Returns the address of the specified entry point for the context of the
+// specified window, resolving it only once for all contexts of its kind
+// The cache lock must be held if the entry points of the context are shared
+//
+static GLFWglproc getProc(_GLFWwindow* window, const char* name)
+{
+    if (!window->context.sharedProcs)
+        return window->context.getProcAddress(name);
+
+    if (!window->context.procCache)
+    {
+        window->context.procCache = acquireProcCache(window);
+        if (!window->context.procCache)
+            return window->context.getProcAddress(name);
+    }
+
+    _GLFWproccache* cache = window->context.procCache;
+    const uint32_t hash = hashProcName(name);
+    uint32_t slot;
+
+    if (cache->size)
+    {
+        for (slot = hash & (cache->size - 1);
+             cache->entries[slot].name;
+             slot = (slot + 1) & (cache->size - 1))
+        {
+            const _GLFWprocentry* entry = cache->entries + slot;
+            if (entry->hash == hash && strcmp(entry->name, name) == 0)
+                return entry->proc;
+        }
+    }
+
+    // Resolve and remember the entry point, including whether it is missing
+    const GLFWglproc proc = window->context.getProcAddress(name);
+
+    // Keep the load factor of the table at or below one half
+    if ((cache->count + 1) * 2 > cache->size)
+    {
+        if (!growProcCache(cache))
+            return proc;
+    }
+
+    char* copy = _glfw_strdup(name);
+    if (!copy)
+        return proc;
+
+    for (slot = hash & (cache->size - 1);
+         cache->entries[slot].name;
+         slot = (slot + 1) & (cache->size - 1))
+    {
+    }
+
+    cache->entries[slot].hash = hash;
+    cache->entries[slot].name = copy;
+    cache->entries[slot].proc = proc;
+    cache->count++;
+
+    return proc;
+}
 
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
 
+// Releases the reference of the specified window to its entry point cache,
+// destroying the cache if it was the last
+//
+// This is called before the context is destroyed, as the client library and
+// with it the cached addresses may be unloaded along with the last context
+//
+void _glfwReleaseProcCache(_GLFWwindow* window)
+{
+    _GLFWproccache* cache = window->context.procCache;
+    if (!cache)
+        return;
+
+    _glfwPlatformLockMutex(&_glfw.procCacheLock);
+
+    window->context.procCache = NULL;
+
+    if (--cache->references == 0)
+    {
+        _GLFWproccache** prev = &_glfw.procCacheListHead;
+        uint32_t i;
+
+        while (*prev != cache)
+            prev = &((*prev)->next);
+
+        *prev = cache->next;
+
+        for (i = 0;  i < cache->size;  i++)
+            _glfw_free(cache->entries[i].name);
+
+        _glfw_free(cache->entries);
+        _glfw_free(cache);
+    }
+
+    _glfwPlatformUnlockMutex(&_glfw.procCacheLock);
+}
+
 // Checks whether the desired context attributes are valid
 //
 // This function checks things like whether the specified client API version
@@ -629,6 +867,8 @@ GLFWAPI void glfwMakeContextCurrent(GLFWwindow* handle)
         return;
     }
 
+    _GLFW_TRACE_BEGIN("glfwMakeContextCurrent");
+
     if (previous)
     {
         if (!window || window->context.source != previous->context.source)
@@ -637,6 +877,8 @@ GLFWAPI void glfwMakeContextCurrent(GLFWwindow* handle)
 
     if (window)
         window->context.makeCurrent(window);
+
+    _GLFW_TRACE_END("glfwMakeContextCurrent");
 }
 
 GLFWAPI GLFWwindow* glfwGetCurrentContext(void)
@@ -659,7 +901,224 @@ GLFWAPI void glfwSwapBuffers(GLFWwindow* handle)
         return;
     }
 
-    window->context.swapBuffers(window);
+    swapBuffers(window, NULL, 0, "glfwSwapBuffers");
+}
+
+GLFWAPI void glfwSwapBuffersWithDamage(GLFWwindow* handle,
+                                       const int* rects,
+                                       int count)
+{
+    _GLFW_REQUIRE_INIT();
+
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(count >= 0);
+    assert(rects != NULL || count == 0);
+
+    if (window->context.client == GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                        "Cannot swap buffers of a window that has no OpenGL or OpenGL ES context");
+        return;
+    }
+
+    if (count < 0 || (count > 0 && !rects))
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid damage rectangle count %i", count);
+        return;
+    }
+
+    for (int i = 0;  i < count;  i++)
+    {
+        const int* rect = rects + i * 4;
+
+        if (rect[2] < 0 || rect[3] < 0)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "Invalid damage rectangle size %ix%i",
+                            rect[2], rect[3]);
+            return;
+        }
+    }
+
+    swapBuffers(window, rects, count, "glfwSwapBuffersWithDamage");
+}
+
+GLFWAPI int glfwGetBufferAge(GLFWwindow* handle)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (window->context.client == GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                        "Cannot query the buffer age of a window that has no OpenGL or OpenGL ES context");
+        return 0;
+    }
+
+    if (!window->context.getBufferAge)
+        return 0;
+
+    return window->context.getBufferAge(window);
+}
+
+GLFWAPI void glfwPresentPixels(GLFWwindow* handle,
+                               int width, int height,
+                               const unsigned char* pixels,
+                               int stride,
+                               const int* rects,
+                               int count)
+{
+    _GLFW_REQUIRE_INIT();
+
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(pixels != NULL);
+    assert(count >= 0);
+
+    if (window->context.client != GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Cannot present pixels to a window that has an OpenGL or OpenGL ES context");
+        return;
+    }
+
+    if (width <= 0 || height <= 0 || width > INT_MAX / 4 || stride < width * 4)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid image dimensions %ix%i with stride %i",
+                        width, height, stride);
+        return;
+    }
+
+    if (count < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid damage rectangle count %i", count);
+        return;
+    }
+
+    // Without damage rectangles the whole image is presented
+    const int whole[4] = { 0, 0, width, height };
+    if (!rects || !count)
+    {
+        rects = whole;
+        count = 1;
+    }
+
+    for (int i = 0;  i < count;  i++)
+    {
+        const int* rect = rects + i * 4;
+
+        // The extents are compared by subtraction so they cannot overflow
+        if (rect[0] < 0 || rect[1] < 0 || rect[2] <= 0 || rect[3] <= 0 ||
+            rect[0] > width || rect[1] > height ||
+            rect[2] > width - rect[0] || rect[3] > height - rect[1])
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "Invalid damage rectangle %i,%i %ix%i",
+                            rect[0], rect[1], rect[2], rect[3]);
+            return;
+        }
+    }
+
+    // Send any window requests made since the last event processing so they
+    // take effect along with this frame
+    _glfw.platform.flush();
+
+    _GLFW_TRACE_BEGIN("glfwPresentPixels");
+    _glfw.platform.presentPixels(window, width, height, pixels, stride, rects, count);
+    _GLFW_TRACE_END("glfwPresentPixels");
+}
+
+GLFWAPI int glfwWaitForFrame(GLFWwindow* handle, double timeout)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(timeout == timeout);
+    assert(timeout >= 0.0);
+    assert(timeout <= DBL_MAX);
+
+    if (timeout != timeout || timeout < 0.0 || timeout > DBL_MAX)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid time %f", timeout);
+        return GLFW_FALSE;
+    }
+
+    if (!_glfw.platform.windowThrottled(window))
+        return GLFW_TRUE;
+
+    _GLFW_TRACE_BEGIN("glfwWaitForFrame");
+
+    const uint64_t frequency = _glfwPlatformGetTimerFrequency();
+    const uint64_t start = _glfwPlatformGetTimerValue();
+    GLFWbool ready = GLFW_TRUE;
+
+    while (_glfw.platform.windowThrottled(window))
+    {
+        const double elapsed =
+            (_glfwPlatformGetTimerValue() - start) / (double) frequency;
+        if (elapsed >= timeout)
+        {
+            ready = GLFW_FALSE;
+            break;
+        }
+
+        _glfw.platform.waitEventsTimeout(timeout - elapsed);
+    }
+
+    _GLFW_TRACE_END("glfwWaitForFrame");
+    return ready;
+}
+
+GLFWAPI void glfwGetFrameStats(GLFWwindow* handle, GLFWframestats* stats)
+{
+    assert(stats != NULL);
+
+    memset(stats, 0, sizeof(GLFWframestats));
+
+    _GLFW_REQUIRE_INIT();
+
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (window->context.client == GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                        "Cannot query frame statistics of a window that has no OpenGL or OpenGL ES context");
+        return;
+    }
+
+    const double frequency = (double) _glfwPlatformGetTimerFrequency();
+    const uint64_t frames = window->frameStats.frames;
+
+    stats->frames = frames;
+    stats->swapTime = window->frameStats.swapTime / frequency;
+    stats->maxSwapTime = window->frameStats.maxSwapTime / frequency;
+    stats->frameTime = window->frameStats.frameTime / frequency;
+
+    if (frames > 0)
+        stats->averageSwapTime = window->frameStats.totalSwapTime / frequency / frames;
+    if (frames > 1)
+        stats->averageFrameTime = window->frameStats.totalFrameTime / frequency / (frames - 1);
+
+    memcpy(stats->histogram,
+           window->frameStats.histogram,
+           sizeof(stats->histogram));
+
+    if (window->context.getSyncValues)
+    {
+        stats->syncValues = window->context.getSyncValues(window,
+                                                          &stats->ust,
+                                                          &stats->msc,
+                                                          &stats->sbc);
+
+        if (!stats->syncValues)
+            stats->ust = stats->msc = stats->sbc = 0;
+    }
 }
 
 GLFWAPI void glfwSwapInterval(int interval)
@@ -760,6 +1219,53 @@ GLFWAPI GLFWglproc glfwGetProcAddress(const char* procname)
         return NULL;
     }
 
-    return window->context.getProcAddress(procname);
+    if (!window->context.sharedProcs)
+        return window->context.getProcAddress(procname);
+
+    _glfwPlatformLockMutex(&_glfw.procCacheLock);
+    const GLFWglproc proc = getProc(window, procname);
+    _glfwPlatformUnlockMutex(&_glfw.procCacheLock);
+
+    return proc;
+}
+
+GLFWAPI int glfwGetProcAddresses(const char* const* names, GLFWglproc* procs, int count)
+{
+    _GLFWwindow* window;
+    int i, found = 0;
+
+    assert(count >= 0);
+    assert(count == 0 || names != NULL);
+    assert(count == 0 || procs != NULL);
+
+    for (i = 0;  i < count;  i++)
+        procs[i] = NULL;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    window = _glfwPlatformGetTls(&_glfw.contextSlot);
+    if (!window)
+    {
+        _glfwInputError(GLFW_NO_CURRENT_CONTEXT,
+                        "Cannot query entry points without a current OpenGL or OpenGL ES context");
+        return 0;
+    }
+
+    if (window->context.sharedProcs)
+        _glfwPlatformLockMutex(&_glfw.procCacheLock);
+
+    for (i = 0;  i < count;  i++)
+    {
+        assert(names[i] != NULL);
+
+        procs[i] = getProc(window, names[i]);
+        if (procs[i])
+            found++;
+    }
+
+    if (window->context.sharedProcs)
+        _glfwPlatformUnlockMutex(&_glfw.procCacheLock);
+
+    return found;
 }
 
@@ -272,7 +272,9 @@ static void makeContextCurrentEGL(_GLFWwindow* window)
     _glfwPlatformSetTls(&_glfw.contextSlot, window);
 }
 
-static void swapBuffersEGL(_GLFWwindow* window)
+static void swapBuffersWithDamageEGL(_GLFWwindow* window,
+                                     const int* rects,
+                                     int count)
 {
     if (window != _glfwPlatformGetTls(&_glfw.contextSlot))
     {
@@ -287,17 +289,74 @@ static void swapBuffersEGL(_GLFWwindow* window)
         // NOTE: Swapping buffers on a hidden window on Wayland makes it visible
         if (!window->wl.visible)
             return;
+
+        // The frame request is committed along with the new buffer
+        _glfwRequestFrameWayland(window);
     }
 #endif
 
+    if (count && _glfw.egl.KHR_swap_buffers_with_damage)
+    {
+        // EGLint is int, so the rectangles can be passed on unconverted
+        eglSwapBuffersWithDamageKHR(_glfw.egl.display,
+                                    window->context.egl.surface,
+                                    (const EGLint*) rects, count);
+        return;
+    }
+
     eglSwapBuffers(_glfw.egl.display, window->context.egl.surface);
 }
 
+static void swapBuffersEGL(_GLFWwindow* window)
+{
+    swapBuffersWithDamageEGL(window, NULL, 0);
+}
+
+static int getBufferAgeEGL(_GLFWwindow* window)
+{
+    EGLint age;
+
+    if (window != _glfwPlatformGetTls(&_glfw.contextSlot))
+    {
+        _glfwInputError(GLFW_NO_CURRENT_CONTEXT,
+                        "EGL: The context must be current on the calling thread when querying the buffer age");
+        return 0;
+    }
+
+    if (!eglQuerySurface(_glfw.egl.display,
+                         window->context.egl.surface,
+                         EGL_BUFFER_AGE_EXT,
+                         &age))
+    {
+        return 0;
+    }
+
+    return age;
+}
+
 static void swapIntervalEGL(int interval)
 {
     eglSwapInterval(_glfw.egl.display, interval);
 }
 
+static GLFWbool getSyncValuesEGL(_GLFWwindow* window,
+                                 int64_t* ust, int64_t* msc, int64_t* sbc)
+{
+    uint64_t values[3];
+
+    if (!eglGetSyncValuesCHROMIUM(_glfw.egl.display,
+                                  window->context.egl.surface,
+                                  values, values + 1, values + 2))
+    {
+        return GLFW_FALSE;
+    }
+
+    *ust = (int64_t) values[0];
+    *msc = (int64_t) values[1];
+    *sbc = (int64_t) values[2];
+    return GLFW_TRUE;
+}
+
 static int extensionSupportedEGL(const char* extension)
 {
     const char* extensions = eglQueryString(_glfw.egl.display, EGL_EXTENSIONS);
@@ -387,20 +446,30 @@ GLFWbool _glfwInitEGL(void)
     if (_glfw.egl.handle)
         return GLFW_TRUE;
 
-    for (i = 0;  sonames[i];  i++)
+    if (_glfw.retained.egl)
     {
-        _glfw.egl.handle = _glfwPlatformLoadModule(sonames[i]);
-        if (_glfw.egl.handle)
-            break;
+        // Reuse the library kept loaded by an earlier termination
+        _glfw.egl.handle = _glfw.retained.egl;
+        _glfw.egl.prefix = _glfw.retained.eglPrefix;
+        _glfw.retained.egl = NULL;
     }
-
-    if (!_glfw.egl.handle)
+    else
     {
-        _glfwInputError(GLFW_API_UNAVAILABLE, "EGL: Library not found");
-        return GLFW_FALSE;
-    }
+        for (i = 0;  sonames[i];  i++)
+        {
+            _glfw.egl.handle = _glfwPlatformLoadModule(sonames[i]);
+            if (_glfw.egl.handle)
+                break;
+        }
 
-    _glfw.egl.prefix = (strncmp(sonames[i], "lib", 3) == 0);
+        if (!_glfw.egl.handle)
+        {
+            _glfwInputError(GLFW_API_UNAVAILABLE, "EGL: Library not found");
+            return GLFW_FALSE;
+        }
+
+        _glfw.egl.prefix = (strncmp(sonames[i], "lib", 3) == 0);
+    }
 
     _glfw.egl.GetConfigAttrib = (PFN_eglGetConfigAttrib)
         _glfwPlatformGetModuleSymbol(_glfw.egl.handle, "eglGetConfigAttrib");
@@ -434,6 +503,8 @@ GLFWbool _glfwInitEGL(void)
         _glfwPlatformGetModuleSymbol(_glfw.egl.handle, "eglSwapInterval");
     _glfw.egl.QueryString = (PFN_eglQueryString)
         _glfwPlatformGetModuleSymbol(_glfw.egl.handle, "eglQueryString");
+    _glfw.egl.QuerySurface = (PFN_eglQuerySurface)
+        _glfwPlatformGetModuleSymbol(_glfw.egl.handle, "eglQuerySurface");
     _glfw.egl.GetProcAddress = (PFN_eglGetProcAddress)
         _glfwPlatformGetModuleSymbol(_glfw.egl.handle, "eglGetProcAddress");
 
@@ -453,6 +524,7 @@ GLFWbool _glfwInitEGL(void)
         !_glfw.egl.SwapBuffers ||
         !_glfw.egl.SwapInterval ||
         !_glfw.egl.QueryString ||
+        !_glfw.egl.QuerySurface ||
         !_glfw.egl.GetProcAddress)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -542,6 +614,32 @@ GLFWbool _glfwInitEGL(void)
     _glfw.egl.EXT_present_opaque =
         extensionSupportedEGL("EGL_EXT_present_opaque");
 
+    if (extensionSupportedEGL("EGL_CHROMIUM_sync_control"))
+    {
+        _glfw.egl.GetSyncValuesCHROMIUM = (PFNEGLGETSYNCVALUESCHROMIUMPROC)
+            eglGetProcAddress("eglGetSyncValuesCHROMIUM");
+
+        if (_glfw.egl.GetSyncValuesCHROMIUM)
+            _glfw.egl.CHROMIUM_sync_control = GLFW_TRUE;
+    }
+
+    // The KHR and EXT variants of swap with damage have identical semantics
+    if (extensionSupportedEGL("EGL_KHR_swap_buffers_with_damage"))
+    {
+        _glfw.egl.SwapBuffersWithDamageKHR = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)
+            eglGetProcAddress("eglSwapBuffersWithDamageKHR");
+    }
+    else if (extensionSupportedEGL("EGL_EXT_swap_buffers_with_damage"))
+    {
+        _glfw.egl.SwapBuffersWithDamageKHR = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)
+            eglGetProcAddress("eglSwapBuffersWithDamageEXT");
+    }
+
+    if (_glfw.egl.SwapBuffersWithDamageKHR)
+        _glfw.egl.KHR_swap_buffers_with_damage = GLFW_TRUE;
+
+    _glfw.egl.EXT_buffer_age = extensionSupportedEGL("EGL_EXT_buffer_age");
+
     return GLFW_TRUE;
 }
 
@@ -557,7 +655,14 @@ void _glfwTerminateEGL(void)
 
     if (_glfw.egl.handle)
     {
-        _glfwPlatformFreeModule(_glfw.egl.handle);
+        if (_glfw.hints.init.retainLibraries)
+        {
+            _glfw.retained.egl = _glfw.egl.handle;
+            _glfw.retained.eglPrefix = _glfw.egl.prefix;
+        }
+        else
+            _glfwPlatformFreeModule(_glfw.egl.handle);
+
         _glfw.egl.handle = NULL;
     }
 }
@@ -850,6 +955,14 @@ GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
     window->context.extensionSupported = extensionSupportedEGL;
     window->context.getProcAddress = getProcAddressEGL;
     window->context.destroy = destroyContextEGL;
+    window->context.sharedProcs = GLFW_TRUE;
+
+    if (_glfw.egl.CHROMIUM_sync_control)
+        window->context.getSyncValues = getSyncValuesEGL;
+    if (_glfw.egl.KHR_swap_buffers_with_damage)
+        window->context.swapBuffersWithDamage = swapBuffersWithDamageEGL;
+    if (_glfw.egl.EXT_buffer_age)
+        window->context.getBufferAge = getBufferAgeEGL;
 
     return GLFW_TRUE;
 }
@@ -207,6 +207,14 @@ static void swapIntervalGLX(int interval)
     }
 }
 
+static GLFWbool getSyncValuesGLX(_GLFWwindow* window,
+                                 int64_t* ust, int64_t* msc, int64_t* sbc)
+{
+    return _glfw.glx.GetSyncValuesOML(_glfw.x11.display,
+                                      window->context.glx.window,
+                                      ust, msc, sbc);
+}
+
 static int extensionSupportedGLX(const char* extension)
 {
     const char* extensions =
@@ -276,11 +284,20 @@ GLFWbool _glfwInitGLX(void)
     if (_glfw.glx.handle)
         return GLFW_TRUE;
 
-    for (int i = 0;  sonames[i];  i++)
+    if (_glfw.retained.glx)
+    {
+        // Reuse the library kept loaded by an earlier termination
+        _glfw.glx.handle = _glfw.retained.glx;
+        _glfw.retained.glx = NULL;
+    }
+    else
     {
-        _glfw.glx.handle = _glfwPlatformLoadModule(sonames[i]);
-        if (_glfw.glx.handle)
-            break;
+        for (int i = 0;  sonames[i];  i++)
+        {
+            _glfw.glx.handle = _glfwPlatformLoadModule(sonames[i]);
+            if (_glfw.glx.handle)
+                break;
+        }
     }
 
     if (!_glfw.glx.handle)
@@ -390,6 +407,15 @@ GLFWbool _glfwInitGLX(void)
             _glfw.glx.MESA_swap_control = GLFW_TRUE;
     }
 
+    if (extensionSupportedGLX("GLX_OML_sync_control"))
+    {
+        _glfw.glx.GetSyncValuesOML = (PFNGLXGETSYNCVALUESOMLPROC)
+            getProcAddressGLX("glXGetSyncValuesOML");
+
+        if (_glfw.glx.GetSyncValuesOML)
+            _glfw.glx.OML_sync_control = GLFW_TRUE;
+    }
+
     if (extensionSupportedGLX("GLX_ARB_multisample"))
         _glfw.glx.ARB_multisample = GLFW_TRUE;
 
@@ -435,7 +461,11 @@ void _glfwTerminateGLX(void)
 
     if (_glfw.glx.handle)
     {
-        _glfwPlatformFreeModule(_glfw.glx.handle);
+        if (_glfw.hints.init.retainLibraries)
+            _glfw.retained.glx = _glfw.glx.handle;
+        else
+            _glfwPlatformFreeModule(_glfw.glx.handle);
+
         _glfw.glx.handle = NULL;
     }
 }
@@ -632,6 +662,10 @@ GLFWbool _glfwCreateContextGLX(_GLFWwindow* window,
     window->context.extensionSupported = extensionSupportedGLX;
     window->context.getProcAddress = getProcAddressGLX;
     window->context.destroy = destroyContextGLX;
+    window->context.sharedProcs = GLFW_TRUE;
+
+    if (_glfw.glx.OML_sync_control)
+        window->context.getSyncValues = getSyncValuesGLX;
 
     return GLFW_TRUE;
 }
@@ -50,6 +50,9 @@ static GLFWallocator _glfwInitAllocator;
 static _GLFWinitconfig _glfwInitHints =
 {
     .hatButtons = GLFW_TRUE,
+    .joystickThread = GLFW_FALSE,
+    .waitSpinMargin = 0,
+    .retainLibraries = GLFW_FALSE,
     .angleType = GLFW_ANGLE_PLATFORM_TYPE_NONE,
     .platformID = GLFW_ANY_PLATFORM,
     .vulkanLoader = NULL,
@@ -61,10 +64,12 @@ static _GLFWinitconfig _glfwInitHints =
     .x11 =
     {
         .xcbVulkanSurface = GLFW_TRUE,
+        .strictQueries = GLFW_FALSE,
     },
     .wl =
     {
-        .libdecorMode = GLFW_WAYLAND_PREFER_LIBDECOR
+        .libdecorMode = GLFW_WAYLAND_PREFER_LIBDECOR,
+        .keymapThread = GLFW_FALSE
     },
 };
 
@@ -119,6 +124,15 @@ static void terminate(void)
     _glfw.mappings = NULL;
     _glfw.mappingCount = 0;
 
+    _glfw_free(_glfw.mappingNames);
+    _glfw_free(_glfw.mappingNameTable);
+    _glfw.mappingNames = NULL;
+    _glfw.mappingNamesSize = 0;
+    _glfw.mappingNamesCapacity = 0;
+    _glfw.mappingNameTable = NULL;
+    _glfw.mappingNameTableSize = 0;
+    _glfw.mappingNameCount = 0;
+
     _glfwTerminateVulkan();
     _glfw.platform.terminateJoysticks();
     _glfw.platform.terminate();
@@ -135,8 +149,25 @@ static void terminate(void)
     _glfwPlatformDestroyTls(&_glfw.contextSlot);
     _glfwPlatformDestroyTls(&_glfw.errorSlot);
     _glfwPlatformDestroyMutex(&_glfw.errorLock);
+    _glfwPlatformDestroyMutex(&_glfw.procCacheLock);
 
+    if (!_glfw.hints.init.retainLibraries)
+    {
+        // Unload any libraries retained by an earlier termination that were
+        // not needed this time
+        if (_glfw.retained.egl)
+            _glfwPlatformFreeModule(_glfw.retained.egl);
+        if (_glfw.retained.glx)
+            _glfwPlatformFreeModule(_glfw.retained.glx);
+        if (_glfw.retained.vk.handle)
+            _glfwPlatformFreeModule(_glfw.retained.vk.handle);
+
+        memset(&_glfw.retained, 0, sizeof(_glfw.retained));
+    }
+
+    const _GLFWretained retained = _glfw.retained;
     memset(&_glfw, 0, sizeof(_glfw));
+    _glfw.retained = retained;
 }
 
 
@@ -378,6 +409,15 @@ void _glfwInputError(int code, const char* format, ...)
         _glfwErrorCallback(code, description);
 }
 
+// Notifies shared code of the beginning or end of a traced span of work
+//
+void _glfwInputTrace(int event, const char* name)
+{
+    GLFWtracefun callback = _glfw.callbacks.trace;
+    if (callback)
+        callback(event, name, _glfwPlatformGetTimerValue());
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                        GLFW public API                       //////
@@ -409,6 +449,7 @@ GLFWAPI int glfwInit(void)
     }
 
     if (!_glfwPlatformCreateMutex(&_glfw.errorLock) ||
+        !_glfwPlatformCreateMutex(&_glfw.procCacheLock) ||
         !_glfwPlatformCreateTls(&_glfw.errorSlot) ||
         !_glfwPlatformCreateTls(&_glfw.contextSlot))
     {
@@ -444,6 +485,15 @@ GLFWAPI void glfwInitHint(int hint, int value)
         case GLFW_JOYSTICK_HAT_BUTTONS:
             _glfwInitHints.hatButtons = value;
             return;
+        case GLFW_JOYSTICK_THREAD:
+            _glfwInitHints.joystickThread = value;
+            return;
+        case GLFW_WAIT_SPIN_MARGIN:
+            _glfwInitHints.waitSpinMargin = value;
+            return;
+        case GLFW_RETAIN_LIBRARIES:
+            _glfwInitHints.retainLibraries = value;
+            return;
         case GLFW_ANGLE_PLATFORM_TYPE:
             _glfwInitHints.angleType = value;
             return;
@@ -459,9 +509,15 @@ GLFWAPI void glfwInitHint(int hint, int value)
         case GLFW_X11_XCB_VULKAN_SURFACE:
             _glfwInitHints.x11.xcbVulkanSurface = value;
             return;
+        case GLFW_X11_STRICT_QUERIES:
+            _glfwInitHints.x11.strictQueries = value;
+            return;
         case GLFW_WAYLAND_LIBDECOR:
             _glfwInitHints.wl.libdecorMode = value;
             return;
+        case GLFW_WAYLAND_KEYMAP_THREAD:
+            _glfwInitHints.wl.keymapThread = value;
+            return;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM,
@@ -526,3 +582,10 @@ GLFWAPI GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun cbfun)
     return cbfun;
 }
 
+GLFWAPI GLFWtracefun glfwSetTraceCallback(GLFWtracefun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP(GLFWtracefun, _glfw.callbacks.trace, cbfun);
+    return cbfun;
+}
+
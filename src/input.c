@@ -34,14 +34,19 @@
 #include <stdlib.h>
 #include <string.h>
 
-// Internal key state used for sticky keys
-#define _GLFW_STICK 3
-
 // Internal constants for gamepad mapping source types
 #define _GLFW_JOYSTICK_AXIS     1
 #define _GLFW_JOYSTICK_BUTTON   2
 #define _GLFW_JOYSTICK_HATBIT   3
 
+// Accessors for the packed source type, axis scale and axis offset of gamepad
+// mapping elements
+#define _GLFW_MAPELEMENT_TYPE(e)   ((e)->packed & 0x03)
+#define _GLFW_MAPELEMENT_SCALE(e)  ((int) (((e)->packed >> 2) & 0x07) - 2)
+#define _GLFW_MAPELEMENT_OFFSET(e) ((int) (((e)->packed >> 5) & 0x03) - 1)
+#define _GLFW_MAPELEMENT_PACK(type, scale, offset) \
+    ((uint8_t) ((type) | (((scale) + 2) << 2) | (((offset) + 1) << 5)))
+
 #define GLFW_MOD_MASK (GLFW_MOD_SHIFT | \
                        GLFW_MOD_CONTROL | \
                        GLFW_MOD_ALT | \
@@ -65,31 +70,172 @@ static GLFWbool initJoysticks(void)
     return _glfw.joysticksInitialized = GLFW_TRUE;
 }
 
-// Finds a mapping based on joystick GUID
+// Polls the platform joystick state selected by mode
+//
+static GLFWbool pollJoystick(_GLFWjoystick* js, int mode)
+{
+    _GLFW_TRACE_BEGIN("pollJoystick");
+    const GLFWbool present = _glfw.platform.pollJoystick(js, mode);
+    _GLFW_TRACE_END("pollJoystick");
+    return present;
+}
+
+// Converts a hexadecimal joystick GUID string to binary
+//
+static GLFWbool parseGUID(uint8_t* guid, const char* string)
+{
+    int i;
+
+    for (i = 0;  i < 32;  i++)
+    {
+        int value;
+        const char c = string[i];
+
+        if (c >= '0' && c <= '9')
+            value = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            value = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            value = c - 'A' + 10;
+        else
+            return GLFW_FALSE;
+
+        if (i & 1)
+            guid[i / 2] |= (uint8_t) value;
+        else
+            guid[i / 2] = (uint8_t) (value << 4);
+    }
+
+    return string[32] == '\0' || string[32] == ',';
+}
+
+// Finds a mapping based on binary joystick GUID
 //
-static _GLFWmapping* findMapping(const char* guid)
+static _GLFWmapping* findMapping(const uint8_t* guid)
 {
     int i;
 
     for (i = 0;  i < _glfw.mappingCount;  i++)
     {
-        if (strcmp(_glfw.mappings[i].guid, guid) == 0)
+        if (memcmp(_glfw.mappings[i].guid, guid, 16) == 0)
             return _glfw.mappings + i;
     }
 
     return NULL;
 }
 
+// Hashes a mapping name for the name pool lookup table
+//
+static uint32_t hashMappingName(const char* name, size_t length)
+{
+    size_t i;
+    uint32_t hash = 2166136261u;
+
+    for (i = 0;  i < length;  i++)
+        hash = (hash ^ (uint8_t) name[i]) * 16777619u;
+
+    return hash;
+}
+
+// Doubles the size of the name pool lookup table and rehashes its entries
+//
+static GLFWbool growMappingNameTable(void)
+{
+    uint32_t i;
+    const uint32_t size = _glfw.mappingNameTableSize ?
+        _glfw.mappingNameTableSize * 2 : 256;
+    uint32_t* table = _glfw_calloc(size, sizeof(uint32_t));
+    if (!table)
+        return GLFW_FALSE;
+
+    for (i = 0;  i < _glfw.mappingNameTableSize;  i++)
+    {
+        const uint32_t entry = _glfw.mappingNameTable[i];
+        if (entry)
+        {
+            const char* name = _glfw.mappingNames + entry - 1;
+            uint32_t j = hashMappingName(name, strlen(name)) & (size - 1);
+
+            while (table[j])
+                j = (j + 1) & (size - 1);
+
+            table[j] = entry;
+        }
+    }
+
+    _glfw_free(_glfw.mappingNameTable);
+    _glfw.mappingNameTable = table;
+    _glfw.mappingNameTableSize = size;
+    return GLFW_TRUE;
+}
+
+// Retrieves the offset of a mapping name in the shared name pool, adding it to
+// the pool if no mapping has used it before
+//
+static GLFWbool internMappingName(const char* name, size_t length, uint32_t* offset)
+{
+    uint32_t i, mask;
+
+    if ((_glfw.mappingNameCount + 1) * 2 > _glfw.mappingNameTableSize)
+    {
+        if (!growMappingNameTable())
+            return GLFW_FALSE;
+    }
+
+    mask = _glfw.mappingNameTableSize - 1;
+
+    // Table entries are pool offsets plus one so that zero marks empty slots
+    for (i = hashMappingName(name, length) & mask;
+         _glfw.mappingNameTable[i];
+         i = (i + 1) & mask)
+    {
+        const char* candidate = _glfw.mappingNames + _glfw.mappingNameTable[i] - 1;
+        if (strncmp(candidate, name, length) == 0 && candidate[length] == '\0')
+        {
+            *offset = _glfw.mappingNameTable[i] - 1;
+            return GLFW_TRUE;
+        }
+    }
+
+    if (_glfw.mappingNamesSize + length + 1 > _glfw.mappingNamesCapacity)
+    {
+        uint32_t capacity = _glfw.mappingNamesCapacity ?
+            _glfw.mappingNamesCapacity : 4096;
+        char* names;
+
+        while (_glfw.mappingNamesSize + length + 1 > capacity)
+            capacity *= 2;
+
+        names = _glfw_realloc(_glfw.mappingNames, capacity);
+        if (!names)
+            return GLFW_FALSE;
+
+        _glfw.mappingNames = names;
+        _glfw.mappingNamesCapacity = capacity;
+    }
+
+    *offset = _glfw.mappingNamesSize;
+    memcpy(_glfw.mappingNames + *offset, name, length);
+    _glfw.mappingNames[*offset + length] = '\0';
+    _glfw.mappingNamesSize += (uint32_t) length + 1;
+
+    _glfw.mappingNameTable[i] = *offset + 1;
+    _glfw.mappingNameCount++;
+    return GLFW_TRUE;
+}
+
 // Checks whether a gamepad mapping element is present in the hardware
 //
 static GLFWbool isValidElementForJoystick(const _GLFWmapelement* e,
                                           const _GLFWjoystick* js)
 {
-    if (e->type == _GLFW_JOYSTICK_HATBIT && (e->index >> 4) >= js->hatCount)
+    const int type = _GLFW_MAPELEMENT_TYPE(e);
+
+    if (type == _GLFW_JOYSTICK_HATBIT && (e->index >> 4) >= js->hatCount)
         return GLFW_FALSE;
-    else if (e->type == _GLFW_JOYSTICK_BUTTON && e->index >= js->buttonCount)
+    else if (type == _GLFW_JOYSTICK_BUTTON && e->index >= js->buttonCount)
         return GLFW_FALSE;
-    else if (e->type == _GLFW_JOYSTICK_AXIS && e->index >= js->axisCount)
+    else if (type == _GLFW_JOYSTICK_AXIS && e->index >= js->axisCount)
         return GLFW_FALSE;
 
     return GLFW_TRUE;
@@ -99,7 +245,13 @@ static GLFWbool isValidElementForJoystick(const _GLFWmapelement* e,
 //
 static _GLFWmapping* findValidMapping(const _GLFWjoystick* js)
 {
-    _GLFWmapping* mapping = findMapping(js->guid);
+    uint8_t guid[16];
+    _GLFWmapping* mapping;
+
+    if (!parseGUID(guid, js->guid))
+        return NULL;
+
+    mapping = findMapping(guid);
     if (mapping)
     {
         int i;
@@ -125,7 +277,9 @@ static _GLFWmapping* findValidMapping(const _GLFWjoystick* js)
 static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
 {
     const char* c = string;
-    size_t i, length;
+    const char* name;
+    size_t i, length, nameLength;
+    char guid[33];
     struct
     {
         const char* name;
@@ -163,18 +317,19 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
         return GLFW_FALSE;
     }
 
-    memcpy(mapping->guid, c, length);
+    memcpy(guid, c, length);
+    guid[length] = '\0';
     c += length + 1;
 
-    length = strcspn(c, ",");
-    if (length >= sizeof(mapping->name) || c[length] != ',')
+    nameLength = strcspn(c, ",");
+    if (nameLength >= 128 || c[nameLength] != ',')
     {
         _glfwInputError(GLFW_INVALID_VALUE, NULL);
         return GLFW_FALSE;
     }
 
-    memcpy(mapping->name, c, length);
-    c += length + 1;
+    name = c;
+    c += nameLength + 1;
 
     while (*c)
     {
@@ -195,6 +350,7 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
                 _GLFWmapelement* e = fields[i].element;
                 int8_t minimum = -1;
                 int8_t maximum = 1;
+                int type, scale = 0, offset = 0;
 
                 if (*c == '+')
                 {
@@ -208,15 +364,15 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
                 }
 
                 if (*c == 'a')
-                    e->type = _GLFW_JOYSTICK_AXIS;
+                    type = _GLFW_JOYSTICK_AXIS;
                 else if (*c == 'b')
-                    e->type = _GLFW_JOYSTICK_BUTTON;
+                    type = _GLFW_JOYSTICK_BUTTON;
                 else if (*c == 'h')
-                    e->type = _GLFW_JOYSTICK_HATBIT;
+                    type = _GLFW_JOYSTICK_HATBIT;
                 else
                     break;
 
-                if (e->type == _GLFW_JOYSTICK_HATBIT)
+                if (type == _GLFW_JOYSTICK_HATBIT)
                 {
                     const unsigned long hat = strtoul(c + 1, (char**) &c, 10);
                     const unsigned long bit = strtoul(c + 1, (char**) &c, 10);
@@ -225,23 +381,25 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
                 else
                     e->index = (uint8_t) strtoul(c + 1, (char**) &c, 10);
 
-                if (e->type == _GLFW_JOYSTICK_AXIS)
+                if (type == _GLFW_JOYSTICK_AXIS)
                 {
-                    e->axisScale = 2 / (maximum - minimum);
-                    e->axisOffset = -(maximum + minimum);
+                    scale = 2 / (maximum - minimum);
+                    offset = -(maximum + minimum);
 
                     if (*c == '~')
                     {
-                        e->axisScale = -e->axisScale;
-                        e->axisOffset = -e->axisOffset;
+                        scale = -scale;
+                        offset = -offset;
                     }
                 }
+
+                e->packed = _GLFW_MAPELEMENT_PACK(type, scale, offset);
             }
             else
             {
-                const char* name = _glfw.platform.getMappingName();
-                length = strlen(name);
-                if (strncmp(c, name, length) != 0)
+                const char* platform = _glfw.platform.getMappingName();
+                length = strlen(platform);
+                if (strncmp(c, platform, length) != 0)
                     return GLFW_FALSE;
             }
 
@@ -254,12 +412,19 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
 
     for (i = 0;  i < 32;  i++)
     {
-        if (mapping->guid[i] >= 'A' && mapping->guid[i] <= 'F')
-            mapping->guid[i] += 'a' - 'A';
+        if (guid[i] >= 'A' && guid[i] <= 'F')
+            guid[i] += 'a' - 'A';
     }
 
-    _glfw.platform.updateGamepadGUID(mapping->guid);
-    return GLFW_TRUE;
+    _glfw.platform.updateGamepadGUID(guid);
+
+    if (!parseGUID(mapping->guid, guid))
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, NULL);
+        return GLFW_FALSE;
+    }
+
+    return internMappingName(name, nameLength, &mapping->name);
 }
 
 
@@ -281,21 +446,34 @@ void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int m
     {
         GLFWbool repeated = GLFW_FALSE;
 
-        if (action == GLFW_RELEASE && window->keys[key] == GLFW_RELEASE)
+        if (action == GLFW_RELEASE &&
+            !_GLFW_BIT_TEST(window->keyBits, key) &&
+            !_GLFW_BIT_TEST(window->stuckKeyBits, key))
+        {
             return;
+        }
 
-        if (action == GLFW_PRESS && window->keys[key] == GLFW_PRESS)
+        if (action == GLFW_PRESS && _GLFW_BIT_TEST(window->keyBits, key))
             repeated = GLFW_TRUE;
 
-        if (action == GLFW_RELEASE && window->stickyKeys)
-            window->keys[key] = _GLFW_STICK;
+        if (action == GLFW_PRESS)
+        {
+            _GLFW_BIT_SET(window->keyBits, key);
+            _GLFW_BIT_CLEAR(window->stuckKeyBits, key);
+        }
         else
-            window->keys[key] = (char) action;
+        {
+            _GLFW_BIT_CLEAR(window->keyBits, key);
+            if (window->stickyKeys)
+                _GLFW_BIT_SET(window->stuckKeyBits, key);
+        }
 
         if (repeated)
             action = GLFW_REPEAT;
     }
 
+    window->lockMods = mods & (GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
+
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
@@ -338,6 +516,9 @@ void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset)
     assert(yoffset > -FLT_MAX);
     assert(yoffset < FLT_MAX);
 
+    window->scrollX += xoffset;
+    window->scrollY += yoffset;
+
     if (window->callbacks.scroll)
         window->callbacks.scroll((GLFWwindow*) window, xoffset, yoffset);
 }
@@ -354,15 +535,24 @@ void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
     if (button < 0 || (!window->disableMouseButtonLimit && button > GLFW_MOUSE_BUTTON_LAST))
         return;
 
+    window->lockMods = mods & (GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
+
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
     if (button <= GLFW_MOUSE_BUTTON_LAST)
     {
-        if (action == GLFW_RELEASE && window->stickyMouseButtons)
-            window->mouseButtons[button] = _GLFW_STICK;
+        if (action == GLFW_PRESS)
+        {
+            _GLFW_BIT_SET(window->mouseButtonBits, button);
+            _GLFW_BIT_CLEAR(window->stuckMouseButtonBits, button);
+        }
         else
-            window->mouseButtons[button] = (char) action;
+        {
+            _GLFW_BIT_CLEAR(window->mouseButtonBits, button);
+            if (window->stickyMouseButtons)
+                _GLFW_BIT_SET(window->stuckMouseButtonBits, button);
+        }
     }
 
     if (window->callbacks.mouseButton)
@@ -417,16 +607,26 @@ void _glfwInputDrop(_GLFWwindow* window, int count, const char** paths)
 //
 void _glfwInputJoystick(_GLFWjoystick* js, int event)
 {
+    int jid;
+    GLFWgamepadstate state;
+
     assert(js != NULL);
     assert(event == GLFW_CONNECTED || event == GLFW_DISCONNECTED);
 
+    jid = (int) (js - _glfw.joysticks);
+
     if (event == GLFW_CONNECTED)
         js->connected = GLFW_TRUE;
     else if (event == GLFW_DISCONNECTED)
         js->connected = GLFW_FALSE;
 
+    if (js->connected && _glfwApplyGamepadMapping(js, &state))
+        _glfwPublishGamepadState(jid, &state);
+    else
+        _glfwPublishGamepadState(jid, NULL);
+
     if (_glfw.callbacks.joystick)
-        _glfw.callbacks.joystick((int) (js - _glfw.joysticks), event);
+        _glfw.callbacks.joystick(jid, event);
 }
 
 // Notifies shared code of the new value of a joystick axis
@@ -530,6 +730,7 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
     strncpy(js->name, name, sizeof(js->name) - 1);
     strncpy(js->guid, guid, sizeof(js->guid) - 1);
     js->mapping = findValidMapping(js);
+    _glfwCompileGamepadMapping(js);
 
     return js;
 }
@@ -544,6 +745,171 @@ void _glfwFreeJoystick(_GLFWjoystick* js)
     memset(js, 0, sizeof(_GLFWjoystick));
 }
 
+// Compiles the gamepad mapping of the specified joystick into its transform
+//
+void _glfwCompileGamepadMapping(_GLFWjoystick* js)
+{
+    int slot, type, count = 0;
+    _GLFWtransform* t = &js->transform;
+
+    memset(t, 0, sizeof(_GLFWtransform));
+
+    // Unmapped buttons evaluate to released and unmapped axes to zero
+    for (slot = 0;  slot < _GLFW_TRANSFORM_BUTTONS;  slot++)
+        t->offset[slot] = -1.f;
+
+    if (!js->mapping)
+        return;
+
+    for (type = _GLFW_JOYSTICK_AXIS;  type <= _GLFW_JOYSTICK_HATBIT;  type++)
+    {
+        const int first = count;
+
+        for (slot = 0;  slot < _GLFW_TRANSFORM_SLOTS;  slot++)
+        {
+            const _GLFWmapelement* e;
+
+            if (slot <= GLFW_GAMEPAD_BUTTON_LAST)
+                e = js->mapping->buttons + slot;
+            else if (slot >= _GLFW_TRANSFORM_BUTTONS &&
+                     slot <= _GLFW_TRANSFORM_BUTTONS + GLFW_GAMEPAD_AXIS_LAST)
+            {
+                e = js->mapping->axes + slot - _GLFW_TRANSFORM_BUTTONS;
+            }
+            else
+                continue;
+
+            if (_GLFW_MAPELEMENT_TYPE(e) != type)
+                continue;
+
+            t->gathers[count].slot = (uint8_t) slot;
+
+            if (type == _GLFW_JOYSTICK_HATBIT)
+            {
+                t->gathers[count].index = e->index >> 4;
+                t->gathers[count].bit = e->index & 0xf;
+            }
+            else
+                t->gathers[count].index = e->index;
+
+            count++;
+
+            if (slot < _GLFW_TRANSFORM_BUTTONS)
+            {
+                if (type == _GLFW_JOYSTICK_AXIS)
+                {
+                    // Axes pressed towards the negative end are negated so
+                    // that every button is pressed at non-negative values
+                    const int scale = _GLFW_MAPELEMENT_SCALE(e);
+                    const int offset = _GLFW_MAPELEMENT_OFFSET(e);
+
+                    if (offset < 0 || (offset == 0 && scale > 0))
+                    {
+                        t->scale[slot] = (float) scale;
+                        t->offset[slot] = (float) offset;
+                    }
+                    else
+                    {
+                        t->scale[slot] = (float) -scale;
+                        t->offset[slot] = (float) -offset;
+                    }
+                }
+                else
+                {
+                    t->scale[slot] = 1.f;
+                    t->offset[slot] = -0.5f;
+                }
+            }
+            else
+            {
+                if (type == _GLFW_JOYSTICK_AXIS)
+                {
+                    t->scale[slot] = (float) _GLFW_MAPELEMENT_SCALE(e);
+                    t->offset[slot] = (float) _GLFW_MAPELEMENT_OFFSET(e);
+                }
+                else
+                {
+                    t->scale[slot] = 2.f;
+                    t->offset[slot] = -1.f;
+                }
+            }
+        }
+
+        if (type == _GLFW_JOYSTICK_AXIS)
+            t->axisGathers = count - first;
+        else if (type == _GLFW_JOYSTICK_BUTTON)
+            t->buttonGathers = count - first;
+        else
+            t->hatGathers = count - first;
+    }
+}
+
+// Applies the gamepad mapping of the specified joystick to its current state
+//
+GLFWbool _glfwApplyGamepadMapping(const _GLFWjoystick* js, GLFWgamepadstate* state)
+{
+    int i;
+    const _GLFWtransform* t = &js->transform;
+    const _GLFWgather* g = t->gathers;
+    float inputs[_GLFW_TRANSFORM_SLOTS] = {0};
+    float values[_GLFW_TRANSFORM_SLOTS];
+    unsigned char buttons[_GLFW_TRANSFORM_BUTTONS];
+
+    if (!js->mapping)
+    {
+        memset(state, 0, sizeof(GLFWgamepadstate));
+        return GLFW_FALSE;
+    }
+
+    for (i = 0;  i < t->axisGathers;  i++, g++)
+        inputs[g->slot] = js->axes[g->index];
+    for (i = 0;  i < t->buttonGathers;  i++, g++)
+        inputs[g->slot] = js->buttons[g->index];
+    for (i = 0;  i < t->hatGathers;  i++, g++)
+        inputs[g->slot] = (float) ((js->hats[g->index] & g->bit) != 0);
+
+    // These loops have fixed trip counts and no branches so that compilers
+    // can evaluate them with SIMD instructions
+    for (i = 0;  i < _GLFW_TRANSFORM_SLOTS;  i++)
+        values[i] = inputs[i] * t->scale[i] + t->offset[i];
+
+    for (i = 0;  i < _GLFW_TRANSFORM_BUTTONS;  i++)
+        buttons[i] = values[i] >= 0.f ? GLFW_PRESS : GLFW_RELEASE;
+
+    for (i = _GLFW_TRANSFORM_BUTTONS;  i < _GLFW_TRANSFORM_SLOTS;  i++)
+    {
+        values[i] = values[i] < -1.f ? -1.f : values[i];
+        values[i] = values[i] > 1.f ? 1.f : values[i];
+    }
+
+    memcpy(state->buttons, buttons, sizeof(state->buttons));
+    memcpy(state->axes, values + _GLFW_TRANSFORM_BUTTONS, sizeof(state->axes));
+    return GLFW_TRUE;
+}
+
+// Publishes the gamepad state of the specified joystick for lock-free readers
+// A NULL state marks the joystick as not present or not a gamepad
+//
+void _glfwPublishGamepadState(int jid, const GLFWgamepadstate* state)
+{
+    _GLFWsnapshot* snapshot = _glfw.snapshots + jid;
+
+    _glfwPlatformBeginSequenceWrite(&snapshot->sequence);
+
+    if (state)
+    {
+        snapshot->present = GLFW_TRUE;
+        snapshot->state = *state;
+    }
+    else
+    {
+        snapshot->present = GLFW_FALSE;
+        memset(&snapshot->state, 0, sizeof(GLFWgamepadstate));
+    }
+
+    _glfwPlatformEndSequenceWrite(&snapshot->sequence);
+}
+
 // Center the cursor in the content area of the specified window
 //
 void _glfwCenterCursorInContentArea(_GLFWwindow* window)
@@ -554,6 +920,55 @@ void _glfwCenterCursorInContentArea(_GLFWwindow* window)
     _glfw.platform.setCursorPos(window, width / 2.0, height / 2.0);
 }
 
+// Derives the active event mask of the specified window from its requested
+// mask, installed callbacks and cursor mode and applies it if it changed
+//
+void _glfwUpdateWindowEventMask(_GLFWwindow* window)
+{
+    int mask = window->eventMask & GLFW_EVENT_MASK_ALL;
+
+    if (window->eventMask & GLFW_EVENT_MASK_AUTO)
+    {
+        if (window->callbacks.key ||
+            window->callbacks.character ||
+            window->callbacks.charmods)
+        {
+            mask |= GLFW_EVENT_MASK_KEY;
+        }
+
+        if (window->callbacks.mouseButton || window->callbacks.scroll)
+            mask |= GLFW_EVENT_MASK_MOUSE_BUTTON;
+        if (window->callbacks.cursorPos || window->cursorMode == GLFW_CURSOR_DISABLED)
+            mask |= GLFW_EVENT_MASK_CURSOR_POS;
+        if (window->callbacks.cursorEnter)
+            mask |= GLFW_EVENT_MASK_CURSOR_ENTER;
+        if (window->callbacks.refresh)
+            mask |= GLFW_EVENT_MASK_REFRESH;
+    }
+
+    if (window->activeEventMask == mask)
+        return;
+
+    // Release any keys still held, as their release events will not be seen
+    if ((window->activeEventMask & GLFW_EVENT_MASK_KEY) &&
+        !(mask & GLFW_EVENT_MASK_KEY))
+    {
+        int key;
+
+        for (key = 0;  key <= GLFW_KEY_LAST;  key++)
+        {
+            if (_GLFW_BIT_TEST(window->keyBits, key))
+            {
+                const int scancode = _glfw.platform.getKeyScancode(key);
+                _glfwInputKey(window, key, scancode, GLFW_RELEASE, 0);
+            }
+        }
+    }
+
+    window->activeEventMask = mask;
+    _glfw.platform.setWindowEventMask(window, mask);
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                        GLFW public API                       //////
@@ -612,6 +1027,7 @@ GLFWAPI void glfwSetInputMode(GLFWwindow* handle, int mode, int value)
                 return;
 
             window->cursorMode = value;
+            _glfwUpdateWindowEventMask(window);
 
             _glfw.platform.getCursorPos(window,
                                         &window->virtualCursorPosX,
@@ -626,17 +1042,9 @@ GLFWAPI void glfwSetInputMode(GLFWwindow* handle, int mode, int value)
             if (window->stickyKeys == value)
                 return;
 
+            // Release all sticky keys
             if (!value)
-            {
-                int i;
-
-                // Release all sticky keys
-                for (i = 0;  i <= GLFW_KEY_LAST;  i++)
-                {
-                    if (window->keys[i] == _GLFW_STICK)
-                        window->keys[i] = GLFW_RELEASE;
-                }
-            }
+                memset(window->stuckKeyBits, 0, sizeof(window->stuckKeyBits));
 
             window->stickyKeys = value;
             return;
@@ -648,16 +1056,11 @@ GLFWAPI void glfwSetInputMode(GLFWwindow* handle, int mode, int value)
             if (window->stickyMouseButtons == value)
                 return;
 
+            // Release all sticky mouse buttons
             if (!value)
             {
-                int i;
-
-                // Release all sticky mouse buttons
-                for (i = 0;  i <= GLFW_MOUSE_BUTTON_LAST;  i++)
-                {
-                    if (window->mouseButtons[i] == _GLFW_STICK)
-                        window->mouseButtons[i] = GLFW_RELEASE;
-                }
+                memset(window->stuckMouseButtonBits, 0,
+                       sizeof(window->stuckMouseButtonBits));
             }
 
             window->stickyMouseButtons = value;
@@ -755,14 +1158,14 @@ GLFWAPI int glfwGetKey(GLFWwindow* handle, int key)
         return GLFW_RELEASE;
     }
 
-    if (window->keys[key] == _GLFW_STICK)
+    if (_GLFW_BIT_TEST(window->stuckKeyBits, key))
     {
         // Sticky mode: release key now
-        window->keys[key] = GLFW_RELEASE;
+        _GLFW_BIT_CLEAR(window->stuckKeyBits, key);
         return GLFW_PRESS;
     }
 
-    return (int) window->keys[key];
+    return _GLFW_BIT_TEST(window->keyBits, key) ? GLFW_PRESS : GLFW_RELEASE;
 }
 
 GLFWAPI int glfwGetMouseButton(GLFWwindow* handle, int button)
@@ -778,14 +1181,79 @@ GLFWAPI int glfwGetMouseButton(GLFWwindow* handle, int button)
         return GLFW_RELEASE;
     }
 
-    if (window->mouseButtons[button] == _GLFW_STICK)
+    if (_GLFW_BIT_TEST(window->stuckMouseButtonBits, button))
     {
         // Sticky mode: release mouse button now
-        window->mouseButtons[button] = GLFW_RELEASE;
+        _GLFW_BIT_CLEAR(window->stuckMouseButtonBits, button);
         return GLFW_PRESS;
     }
 
-    return (int) window->mouseButtons[button];
+    return _GLFW_BIT_TEST(window->mouseButtonBits, button) ? GLFW_PRESS : GLFW_RELEASE;
+}
+
+GLFWAPI void glfwGetInputSnapshot(GLFWwindow* handle, GLFWinputsnapshot* snapshot)
+{
+    int i;
+
+    assert(snapshot != NULL);
+
+    memset(snapshot, 0, sizeof(GLFWinputsnapshot));
+
+    _GLFW_REQUIRE_INIT();
+
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    // Report and release all sticky keys and mouse buttons at once
+    for (i = 0;  i < _GLFW_KEY_WORDS;  i++)
+    {
+        snapshot->keys[i] = window->keyBits[i] | window->stuckKeyBits[i];
+        window->stuckKeyBits[i] = 0;
+    }
+
+    snapshot->mouseButtons = window->mouseButtonBits[0] |
+                             window->stuckMouseButtonBits[0];
+    window->stuckMouseButtonBits[0] = 0;
+
+    if (_GLFW_BIT_TEST(window->keyBits, GLFW_KEY_LEFT_SHIFT) ||
+        _GLFW_BIT_TEST(window->keyBits, GLFW_KEY_RIGHT_SHIFT))
+    {
+        snapshot->mods |= GLFW_MOD_SHIFT;
+    }
+
+    if (_GLFW_BIT_TEST(window->keyBits, GLFW_KEY_LEFT_CONTROL) ||
+        _GLFW_BIT_TEST(window->keyBits, GLFW_KEY_RIGHT_CONTROL))
+    {
+        snapshot->mods |= GLFW_MOD_CONTROL;
+    }
+
+    if (_GLFW_BIT_TEST(window->keyBits, GLFW_KEY_LEFT_ALT) ||
+        _GLFW_BIT_TEST(window->keyBits, GLFW_KEY_RIGHT_ALT))
+    {
+        snapshot->mods |= GLFW_MOD_ALT;
+    }
+
+    if (_GLFW_BIT_TEST(window->keyBits, GLFW_KEY_LEFT_SUPER) ||
+        _GLFW_BIT_TEST(window->keyBits, GLFW_KEY_RIGHT_SUPER))
+    {
+        snapshot->mods |= GLFW_MOD_SUPER;
+    }
+
+    if (window->lockKeyMods)
+        snapshot->mods |= window->lockMods;
+
+    if (window->cursorMode == GLFW_CURSOR_DISABLED)
+    {
+        snapshot->cursorX = window->virtualCursorPosX;
+        snapshot->cursorY = window->virtualCursorPosY;
+    }
+    else
+        _glfw.platform.getCursorPos(window, &snapshot->cursorX, &snapshot->cursorY);
+
+    snapshot->scrollX = window->scrollX;
+    snapshot->scrollY = window->scrollY;
+    window->scrollX = 0.0;
+    window->scrollY = 0.0;
 }
 
 GLFWAPI void glfwGetCursorPos(GLFWwindow* handle, double* xpos, double* ypos)
@@ -871,6 +1339,61 @@ GLFWAPI GLFWcursor* glfwCreateCursor(const GLFWimage* image, int xhot, int yhot)
     return (GLFWcursor*) cursor;
 }
 
+GLFWAPI GLFWcursor* glfwCreateAnimatedCursor(const GLFWimage* images,
+                                            const int* delays,
+                                            int count,
+                                            int xhot, int yhot)
+{
+    _GLFWcursor* cursor;
+
+    assert(images != NULL);
+    assert(delays != NULL);
+    assert(count > 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (count <= 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid frame count %i for animated cursor", count);
+        return NULL;
+    }
+
+    for (int i = 0;  i < count;  i++)
+    {
+        assert(images[i].pixels != NULL);
+
+        if (images[i].width <= 0 || images[i].height <= 0 ||
+            images[i].width != images[0].width ||
+            images[i].height != images[0].height)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "Invalid image dimensions for animated cursor");
+            return NULL;
+        }
+
+        if (delays[i] <= 0)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "Invalid frame delay %i for animated cursor",
+                            delays[i]);
+            return NULL;
+        }
+    }
+
+    cursor = _glfw_calloc(1, sizeof(_GLFWcursor));
+    cursor->next = _glfw.cursorListHead;
+    _glfw.cursorListHead = cursor;
+
+    if (!_glfw.platform.createAnimatedCursor(cursor, images, delays, count, xhot, yhot))
+    {
+        glfwDestroyCursor((GLFWcursor*) cursor);
+        return NULL;
+    }
+
+    return (GLFWcursor*) cursor;
+}
+
 GLFWAPI GLFWcursor* glfwCreateStandardCursor(int shape)
 {
     _GLFWcursor* cursor;
@@ -961,6 +1484,7 @@ GLFWAPI GLFWkeyfun glfwSetKeyCallback(GLFWwindow* handle, GLFWkeyfun cbfun)
     assert(window != NULL);
 
     _GLFW_SWAP(GLFWkeyfun, window->callbacks.key, cbfun);
+    _glfwUpdateWindowEventMask(window);
     return cbfun;
 }
 
@@ -972,6 +1496,7 @@ GLFWAPI GLFWcharfun glfwSetCharCallback(GLFWwindow* handle, GLFWcharfun cbfun)
     assert(window != NULL);
 
     _GLFW_SWAP(GLFWcharfun, window->callbacks.character, cbfun);
+    _glfwUpdateWindowEventMask(window);
     return cbfun;
 }
 
@@ -983,6 +1508,7 @@ GLFWAPI GLFWcharmodsfun glfwSetCharModsCallback(GLFWwindow* handle, GLFWcharmods
     assert(window != NULL);
 
     _GLFW_SWAP(GLFWcharmodsfun, window->callbacks.charmods, cbfun);
+    _glfwUpdateWindowEventMask(window);
     return cbfun;
 }
 
@@ -995,6 +1521,7 @@ GLFWAPI GLFWmousebuttonfun glfwSetMouseButtonCallback(GLFWwindow* handle,
     assert(window != NULL);
 
     _GLFW_SWAP(GLFWmousebuttonfun, window->callbacks.mouseButton, cbfun);
+    _glfwUpdateWindowEventMask(window);
     return cbfun;
 }
 
@@ -1007,6 +1534,7 @@ GLFWAPI GLFWcursorposfun glfwSetCursorPosCallback(GLFWwindow* handle,
     assert(window != NULL);
 
     _GLFW_SWAP(GLFWcursorposfun, window->callbacks.cursorPos, cbfun);
+    _glfwUpdateWindowEventMask(window);
     return cbfun;
 }
 
@@ -1019,6 +1547,7 @@ GLFWAPI GLFWcursorenterfun glfwSetCursorEnterCallback(GLFWwindow* handle,
     assert(window != NULL);
 
     _GLFW_SWAP(GLFWcursorenterfun, window->callbacks.cursorEnter, cbfun);
+    _glfwUpdateWindowEventMask(window);
     return cbfun;
 }
 
@@ -1031,6 +1560,7 @@ GLFWAPI GLFWscrollfun glfwSetScrollCallback(GLFWwindow* handle,
     assert(window != NULL);
 
     _GLFW_SWAP(GLFWscrollfun, window->callbacks.scroll, cbfun);
+    _glfwUpdateWindowEventMask(window);
     return cbfun;
 }
 
@@ -1067,7 +1597,7 @@ GLFWAPI int glfwJoystickPresent(int jid)
     if (!js->connected)
         return GLFW_FALSE;
 
-    return _glfw.platform.pollJoystick(js, _GLFW_POLL_PRESENCE);
+    return pollJoystick(js, _GLFW_POLL_PRESENCE);
 }
 
 GLFWAPI const float* glfwGetJoystickAxes(int jid, int* count)
@@ -1095,7 +1625,7 @@ GLFWAPI const float* glfwGetJoystickAxes(int jid, int* count)
     if (!js->connected)
         return NULL;
 
-    if (!_glfw.platform.pollJoystick(js, _GLFW_POLL_AXES))
+    if (!pollJoystick(js, _GLFW_POLL_AXES))
         return NULL;
 
     *count = js->axisCount;
@@ -1127,7 +1657,7 @@ GLFWAPI const unsigned char* glfwGetJoystickButtons(int jid, int* count)
     if (!js->connected)
         return NULL;
 
-    if (!_glfw.platform.pollJoystick(js, _GLFW_POLL_BUTTONS))
+    if (!pollJoystick(js, _GLFW_POLL_BUTTONS))
         return NULL;
 
     if (_glfw.hints.init.hatButtons)
@@ -1163,7 +1693,7 @@ GLFWAPI const unsigned char* glfwGetJoystickHats(int jid, int* count)
     if (!js->connected)
         return NULL;
 
-    if (!_glfw.platform.pollJoystick(js, _GLFW_POLL_BUTTONS))
+    if (!pollJoystick(js, _GLFW_POLL_BUTTONS))
         return NULL;
 
     *count = js->hatCount;
@@ -1192,7 +1722,7 @@ GLFWAPI const char* glfwGetJoystickName(int jid)
     if (!js->connected)
         return NULL;
 
-    if (!_glfw.platform.pollJoystick(js, _GLFW_POLL_PRESENCE))
+    if (!pollJoystick(js, _GLFW_POLL_PRESENCE))
         return NULL;
 
     return js->name;
@@ -1220,7 +1750,7 @@ GLFWAPI const char* glfwGetJoystickGUID(int jid)
     if (!js->connected)
         return NULL;
 
-    if (!_glfw.platform.pollJoystick(js, _GLFW_POLL_PRESENCE))
+    if (!pollJoystick(js, _GLFW_POLL_PRESENCE))
         return NULL;
 
     return js->guid;
@@ -1323,7 +1853,20 @@ GLFWAPI int glfwUpdateGamepadMappings(const char* string)
     {
         _GLFWjoystick* js = _glfw.joysticks + jid;
         if (js->connected)
+        {
+            GLFWgamepadstate state;
+
             js->mapping = findValidMapping(js);
+            _glfwCompileGamepadMapping(js);
+
+            if (_glfw.snapshots[jid].threaded)
+                continue;
+
+            if (_glfwApplyGamepadMapping(js, &state))
+                _glfwPublishGamepadState(jid, &state);
+            else
+                _glfwPublishGamepadState(jid, NULL);
+        }
     }
 
     return GLFW_TRUE;
@@ -1351,7 +1894,7 @@ GLFWAPI int glfwJoystickIsGamepad(int jid)
     if (!js->connected)
         return GLFW_FALSE;
 
-    if (!_glfw.platform.pollJoystick(js, _GLFW_POLL_PRESENCE))
+    if (!pollJoystick(js, _GLFW_POLL_PRESENCE))
         return GLFW_FALSE;
 
     return js->mapping != NULL;
@@ -1379,18 +1922,17 @@ GLFWAPI const char* glfwGetGamepadName(int jid)
     if (!js->connected)
         return NULL;
 
-    if (!_glfw.platform.pollJoystick(js, _GLFW_POLL_PRESENCE))
+    if (!pollJoystick(js, _GLFW_POLL_PRESENCE))
         return NULL;
 
     if (!js->mapping)
         return NULL;
 
-    return js->mapping->name;
+    return _glfw.mappingNames + js->mapping->name;
 }
 
 GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state)
 {
-    int i;
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
@@ -1414,61 +1956,96 @@ GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state)
     if (!js->connected)
         return GLFW_FALSE;
 
-    if (!_glfw.platform.pollJoystick(js, _GLFW_POLL_ALL))
+    if (!pollJoystick(js, _GLFW_POLL_ALL))
         return GLFW_FALSE;
 
-    if (!js->mapping)
+    if (!_glfwApplyGamepadMapping(js, state))
         return GLFW_FALSE;
 
-    for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
+    if (!_glfw.snapshots[jid].threaded)
+        _glfwPublishGamepadState(jid, state);
+
+    return GLFW_TRUE;
+}
+
+GLFWAPI int glfwGetAllGamepadStates(GLFWgamepadstate* states, int count)
+{
+    int jid, present = 0;
+
+    assert(states != NULL);
+    assert(count >= 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (count < 0)
     {
-        const _GLFWmapelement* e = js->mapping->buttons + i;
-        if (e->type == _GLFW_JOYSTICK_AXIS)
-        {
-            const float value = js->axes[e->index] * e->axisScale + e->axisOffset;
-            // HACK: This should be baked into the value transform
-            // TODO: Bake into transform when implementing output modifiers
-            if (e->axisOffset < 0 || (e->axisOffset == 0 && e->axisScale > 0))
-            {
-                if (value >= 0.f)
-                    state->buttons[i] = GLFW_PRESS;
-            }
-            else
-            {
-                if (value <= 0.f)
-                    state->buttons[i] = GLFW_PRESS;
-            }
-        }
-        else if (e->type == _GLFW_JOYSTICK_HATBIT)
-        {
-            const unsigned int hat = e->index >> 4;
-            const unsigned int bit = e->index & 0xf;
-            if (js->hats[hat] & bit)
-                state->buttons[i] = GLFW_PRESS;
-        }
-        else if (e->type == _GLFW_JOYSTICK_BUTTON)
-            state->buttons[i] = js->buttons[e->index];
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid gamepad state count %i", count);
+        return 0;
     }
 
-    for (i = 0;  i <= GLFW_GAMEPAD_AXIS_LAST;  i++)
+    if (count > GLFW_JOYSTICK_LAST + 1)
+        count = GLFW_JOYSTICK_LAST + 1;
+
+    memset(states, 0, count * sizeof(GLFWgamepadstate));
+
+    if (!initJoysticks())
+        return 0;
+
+    for (jid = 0;  jid < count;  jid++)
     {
-        const _GLFWmapelement* e = js->mapping->axes + i;
-        if (e->type == _GLFW_JOYSTICK_AXIS)
-        {
-            const float value = js->axes[e->index] * e->axisScale + e->axisOffset;
-            state->axes[i] = fminf(fmaxf(value, -1.f), 1.f);
-        }
-        else if (e->type == _GLFW_JOYSTICK_HATBIT)
-        {
-            const unsigned int hat = e->index >> 4;
-            const unsigned int bit = e->index & 0xf;
-            if (js->hats[hat] & bit)
-                state->axes[i] = 1.f;
-            else
-                state->axes[i] = -1.f;
-        }
-        else if (e->type == _GLFW_JOYSTICK_BUTTON)
-            state->axes[i] = js->buttons[e->index] * 2.f - 1.f;
+        _GLFWjoystick* js = _glfw.joysticks + jid;
+        if (!js->connected || !js->mapping)
+            continue;
+
+        if (!pollJoystick(js, _GLFW_POLL_ALL))
+            continue;
+
+        if (!_glfwApplyGamepadMapping(js, states + jid))
+            continue;
+
+        if (!_glfw.snapshots[jid].threaded)
+            _glfwPublishGamepadState(jid, states + jid);
+
+        present |= 1 << jid;
+    }
+
+    return present;
+}
+
+GLFWAPI int glfwGetGamepadStateSnapshot(int jid, GLFWgamepadstate* state)
+{
+    _GLFWsnapshot* snapshot;
+    unsigned int start;
+    GLFWbool present;
+
+    assert(jid >= GLFW_JOYSTICK_1);
+    assert(jid <= GLFW_JOYSTICK_LAST);
+    assert(state != NULL);
+
+    memset(state, 0, sizeof(GLFWgamepadstate));
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
+        return GLFW_FALSE;
+    }
+
+    snapshot = _glfw.snapshots + jid;
+
+    do
+    {
+        start = _glfwPlatformBeginSequenceRead(&snapshot->sequence);
+        present = snapshot->present;
+        *state = snapshot->state;
+    }
+    while (!_glfwPlatformEndSequenceRead(&snapshot->sequence, start));
+
+    if (!present)
+    {
+        memset(state, 0, sizeof(GLFWgamepadstate));
+        return GLFW_FALSE;
     }
 
     return GLFW_TRUE;
@@ -60,6 +60,18 @@
 
 #define _GLFW_MESSAGE_SIZE      1024
 
+// Number of standard cursor shapes, indexed from GLFW_ARROW_CURSOR
+#define _GLFW_STANDARD_CURSOR_COUNT (GLFW_NOT_ALLOWED_CURSOR - GLFW_ARROW_CURSOR + 1)
+
+// Output slots of a compiled gamepad mapping, padded to whole SIMD vectors
+#define _GLFW_TRANSFORM_BUTTONS 16
+#define _GLFW_TRANSFORM_AXES    8
+#define _GLFW_TRANSFORM_SLOTS   (_GLFW_TRANSFORM_BUTTONS + _GLFW_TRANSFORM_AXES)
+
+// Sizes of the key and mouse button state bitsets, in 32-bit words
+#define _GLFW_KEY_WORDS          ((GLFW_KEY_LAST + 32) / 32)
+#define _GLFW_MOUSE_BUTTON_WORDS ((GLFW_MOUSE_BUTTON_LAST + 32) / 32)
+
 typedef int GLFWbool;
 typedef void (*GLFWproc)(void);
 
@@ -76,7 +88,14 @@ typedef struct _GLFWmonitor     _GLFWmonitor;
 typedef struct _GLFWcursor      _GLFWcursor;
 typedef struct _GLFWmapelement  _GLFWmapelement;
 typedef struct _GLFWmapping     _GLFWmapping;
+typedef struct _GLFWgather      _GLFWgather;
+typedef struct _GLFWtransform   _GLFWtransform;
 typedef struct _GLFWjoystick    _GLFWjoystick;
+typedef struct _GLFWsnapshot    _GLFWsnapshot;
+typedef struct _GLFWprocentry   _GLFWprocentry;
+typedef struct _GLFWproccache   _GLFWproccache;
+typedef struct _GLFWvulkan      _GLFWvulkan;
+typedef struct _GLFWretained    _GLFWretained;
 typedef struct _GLFWtls         _GLFWtls;
 typedef struct _GLFWmutex       _GLFWmutex;
 
@@ -174,6 +193,7 @@ typedef const GLubyte* (APIENTRY * PFNGLGETSTRINGIPROC)(GLenum,GLuint);
 #define EGL_CONTEXT_RELEASE_BEHAVIOR_KHR 0x2097
 #define EGL_CONTEXT_RELEASE_BEHAVIOR_NONE_KHR 0
 #define EGL_CONTEXT_RELEASE_BEHAVIOR_FLUSH_KHR 0x2098
+#define EGL_BUFFER_AGE_EXT 0x313d
 #define EGL_PLATFORM_X11_EXT 0x31d5
 #define EGL_PLATFORM_WAYLAND_EXT 0x31d8
 #define EGL_PRESENT_OPAQUE_EXT 0x31df
@@ -216,7 +236,10 @@ typedef EGLBoolean (APIENTRY * PFN_eglMakeCurrent)(EGLDisplay,EGLSurface,EGLSurf
 typedef EGLBoolean (APIENTRY * PFN_eglSwapBuffers)(EGLDisplay,EGLSurface);
 typedef EGLBoolean (APIENTRY * PFN_eglSwapInterval)(EGLDisplay,EGLint);
 typedef const char* (APIENTRY * PFN_eglQueryString)(EGLDisplay,EGLint);
+typedef EGLBoolean (APIENTRY * PFN_eglQuerySurface)(EGLDisplay,EGLSurface,EGLint,EGLint*);
 typedef GLFWglproc (APIENTRY * PFN_eglGetProcAddress)(const char*);
+typedef EGLBoolean (APIENTRY * PFNEGLGETSYNCVALUESCHROMIUMPROC)(EGLDisplay,EGLSurface,uint64_t*,uint64_t*,uint64_t*);
+typedef EGLBoolean (APIENTRY * PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)(EGLDisplay,EGLSurface,const EGLint*,EGLint);
 #define eglGetConfigAttrib _glfw.egl.GetConfigAttrib
 #define eglGetConfigs _glfw.egl.GetConfigs
 #define eglGetDisplay _glfw.egl.GetDisplay
@@ -233,7 +256,10 @@ typedef GLFWglproc (APIENTRY * PFN_eglGetProcAddress)(const char*);
 #define eglSwapBuffers _glfw.egl.SwapBuffers
 #define eglSwapInterval _glfw.egl.SwapInterval
 #define eglQueryString _glfw.egl.QueryString
+#define eglQuerySurface _glfw.egl.QuerySurface
 #define eglGetProcAddress _glfw.egl.GetProcAddress
+#define eglGetSyncValuesCHROMIUM _glfw.egl.GetSyncValuesCHROMIUM
+#define eglSwapBuffersWithDamageKHR _glfw.egl.SwapBuffersWithDamageKHR
 
 typedef EGLDisplay (APIENTRY * PFNEGLGETPLATFORMDISPLAYEXTPROC)(EGLenum,void*,const EGLint*);
 typedef EGLSurface (APIENTRY * PFNEGLCREATEPLATFORMWINDOWSURFACEEXTPROC)(EGLDisplay,EGLConfig,void*,const EGLint*);
@@ -350,6 +376,29 @@ typedef VkResult (APIENTRY * PFN_vkEnumerateInstanceExtensionProperties)(const c
         return x;                                    \
     }
 
+// Tests, sets and clears bits of key and mouse button state bitsets
+#define _GLFW_BIT_TEST(bits, n)  (((bits)[(n) / 32] >> ((n) % 32)) & 1u)
+#define _GLFW_BIT_SET(bits, n)   ((bits)[(n) / 32] |= 1u << ((n) % 32))
+#define _GLFW_BIT_CLEAR(bits, n) ((bits)[(n) / 32] &= ~(1u << ((n) % 32)))
+
+// Marks the beginning and end of a span of work for the trace callback
+// These compile to nothing unless the library is built with tracing support
+#if defined(_GLFW_TRACING)
+ #define _GLFW_TRACE_BEGIN(name)                          \
+    do {                                                  \
+        if (_glfw.callbacks.trace)                        \
+            _glfwInputTrace(GLFW_TRACE_BEGIN, name);      \
+    } while (0)
+ #define _GLFW_TRACE_END(name)                            \
+    do {                                                  \
+        if (_glfw.callbacks.trace)                        \
+            _glfwInputTrace(GLFW_TRACE_END, name);        \
+    } while (0)
+#else
+ #define _GLFW_TRACE_BEGIN(name) do {} while (0)
+ #define _GLFW_TRACE_END(name) do {} while (0)
+#endif
+
 // Swaps the provided pointers
 #define _GLFW_SWAP(type, x, y) \
     {                          \
@@ -375,6 +424,9 @@ struct _GLFWerror
 struct _GLFWinitconfig
 {
     GLFWbool      hatButtons;
+    GLFWbool      joystickThread;
+    int           waitSpinMargin;
+    GLFWbool      retainLibraries;
     int           angleType;
     int           platformID;
     PFN_vkGetInstanceProcAddr vulkanLoader;
@@ -384,9 +436,11 @@ struct _GLFWinitconfig
     } ns;
     struct {
         GLFWbool  xcbVulkanSurface;
+        GLFWbool  strictQueries;
     } x11;
     struct {
         int       libdecorMode;
+        GLFWbool  keymapThread;
     } wl;
 };
 
@@ -413,6 +467,7 @@ struct _GLFWwndconfig
     GLFWbool      centerCursor;
     GLFWbool      focusOnShow;
     GLFWbool      mousePassthrough;
+    GLFWbool      skipOccludedSwap;
     GLFWbool      scaleToMonitor;
     GLFWbool      scaleFramebuffer;
     struct {
@@ -502,11 +557,19 @@ struct _GLFWcontext
 
     void (*makeCurrent)(_GLFWwindow*);
     void (*swapBuffers)(_GLFWwindow*);
+    void (*swapBuffersWithDamage)(_GLFWwindow*,const int*,int);
+    int (*getBufferAge)(_GLFWwindow*);
     void (*swapInterval)(int);
+    GLFWbool (*getSyncValues)(_GLFWwindow*,int64_t*,int64_t*,int64_t*);
     int (*extensionSupported)(const char*);
     GLFWglproc (*getProcAddress)(const char*);
     void (*destroy)(_GLFWwindow*);
 
+    // Whether entry points are the same for all contexts of this kind, which
+    // allows them to be cached across contexts
+    GLFWbool            sharedProcs;
+    _GLFWproccache*     procCache;
+
     struct {
         EGLConfig       config;
         EGLContext      handle;
@@ -537,6 +600,9 @@ struct _GLFWwindow
     GLFWbool            autoIconify;
     GLFWbool            floating;
     GLFWbool            focusOnShow;
+    GLFWbool            skipOccludedSwap;
+    // The occlusion state last reported to the application
+    GLFWbool            occluded;
     GLFWbool            mousePassthrough;
     GLFWbool            shouldClose;
     void*               userPointer;
@@ -555,11 +621,30 @@ struct _GLFWwindow
     GLFWbool            lockKeyMods;
     GLFWbool            disableMouseButtonLimit;
     int                 cursorMode;
-    char                mouseButtons[GLFW_MOUSE_BUTTON_LAST + 1];
-    char                keys[GLFW_KEY_LAST + 1];
+    // Key and mouse button state bitsets, where the stuck sets hold releases
+    // not yet reported in sticky mode
+    uint32_t            mouseButtonBits[_GLFW_MOUSE_BUTTON_WORDS];
+    uint32_t            stuckMouseButtonBits[_GLFW_MOUSE_BUTTON_WORDS];
+    uint32_t            keyBits[_GLFW_KEY_WORDS];
+    uint32_t            stuckKeyBits[_GLFW_KEY_WORDS];
+    // Lock key modifiers of the last key or mouse button event
+    int                 lockMods;
+    // Scroll offsets accumulated since the last input snapshot
+    double              scrollX, scrollY;
     // Virtual cursor position when cursor is disabled
     double              virtualCursorPosX, virtualCursorPosY;
     GLFWbool            rawMouseMotion;
+    // Buffer swap timing for glfwGetFrameStats, in timer ticks
+    struct {
+        uint64_t        frames;
+        uint64_t        lastSwapEnd;
+        uint64_t        swapTime, totalSwapTime, maxSwapTime;
+        uint64_t        frameTime, totalFrameTime;
+        unsigned int    histogram[GLFW_FRAME_HISTOGRAM_SIZE];
+    } frameStats;
+    // Event mask set by the application and the mask derived from it
+    int                 eventMask;
+    int                 activeEventMask;
 
     _GLFWcontext        context;
 
@@ -571,6 +656,7 @@ struct _GLFWwindow
         GLFWwindowfocusfun        focus;
         GLFWwindowiconifyfun      iconify;
         GLFWwindowmaximizefun     maximize;
+        GLFWwindowocclusionfun    occlusion;
         GLFWframebuffersizefun    fbsize;
         GLFWwindowcontentscalefun scale;
         GLFWmousebuttonfun        mouseButton;
@@ -622,24 +708,54 @@ struct _GLFWcursor
 
 // Gamepad mapping element structure
 //
+// The source type, axis scale and axis offset are packed into a single byte,
+// see the _GLFW_MAPELEMENT_* macros in input.c
+//
 struct _GLFWmapelement
 {
-    uint8_t         type;
     uint8_t         index;
-    int8_t          axisScale;
-    int8_t          axisOffset;
+    uint8_t         packed;
 };
 
 // Gamepad mapping structure
 //
+// The name is an offset into the shared mapping name pool and the GUID is
+// stored as binary to keep each mapping within a single cache line
+//
 struct _GLFWmapping
 {
-    char            name[128];
-    char            guid[33];
+    uint8_t         guid[16];
+    uint32_t        name;
     _GLFWmapelement buttons[15];
     _GLFWmapelement axes[6];
 };
 
+// Compiled gamepad mapping gather element structure
+//
+struct _GLFWgather
+{
+    uint8_t         slot;
+    uint8_t         index;
+    uint8_t         bit;
+};
+
+// Compiled gamepad mapping transform structure
+//
+// Gathers are sorted by source type, axes then buttons then hat bits, so each
+// source is read by its own branch-free loop.  Every output slot is then
+// computed as input * scale + offset, with buttons pressed when the result is
+// non-negative and axes clamped to [-1, 1].
+//
+struct _GLFWtransform
+{
+    int             axisGathers;
+    int             buttonGathers;
+    int             hatGathers;
+    _GLFWgather     gathers[_GLFW_TRANSFORM_SLOTS];
+    float           scale[_GLFW_TRANSFORM_SLOTS];
+    float           offset[_GLFW_TRANSFORM_SLOTS];
+};
+
 // Joystick structure
 //
 struct _GLFWjoystick
@@ -656,11 +772,52 @@ struct _GLFWjoystick
     void*           userPointer;
     char            guid[33];
     _GLFWmapping*   mapping;
+    _GLFWtransform  transform;
 
     // This is defined in platform.h
     GLFW_PLATFORM_JOYSTICK_STATE
 };
 
+// Gamepad state snapshot structure
+//
+// This is written by whichever thread updates the joystick state and read
+// without locking from any thread, guarded by the sequence counter
+//
+struct _GLFWsnapshot
+{
+    volatile unsigned int sequence;
+    GLFWbool        present;
+    GLFWgamepadstate state;
+    // Whether a platform thread publishes this snapshot instead of the main
+    // thread, which would otherwise overwrite newer states with older ones
+    GLFWbool        threaded;
+};
+
+// Cached entry point
+//
+struct _GLFWprocentry
+{
+    uint32_t        hash;
+    char*           name;
+    GLFWglproc      proc;
+};
+
+// Entry point cache shared by all contexts of a kind
+//
+// This is a hash table with open addressing, guarded by the cache lock
+//
+struct _GLFWproccache
+{
+    _GLFWproccache* next;
+    int             source;
+    int             client;
+    GLFWbool        gles1;
+    int             references;
+    _GLFWprocentry* entries;
+    uint32_t        size;
+    uint32_t        count;
+};
+
 // Thread local storage structure
 //
 struct _GLFWtls
@@ -693,6 +850,7 @@ struct _GLFWplatform
     GLFWbool (*rawMouseMotionSupported)(void);
     GLFWbool (*createCursor)(_GLFWcursor*,const GLFWimage*,int,int);
     GLFWbool (*createStandardCursor)(_GLFWcursor*,int);
+    GLFWbool (*createAnimatedCursor)(_GLFWcursor*,const GLFWimage*,const int*,int,int,int);
     void (*destroyCursor)(_GLFWcursor*);
     void (*setCursor)(_GLFWwindow*,_GLFWcursor*);
     const char* (*getScancodeName)(int);
@@ -740,6 +898,8 @@ struct _GLFWplatform
     GLFWbool (*windowVisible)(_GLFWwindow*);
     GLFWbool (*windowMaximized)(_GLFWwindow*);
     GLFWbool (*windowHovered)(_GLFWwindow*);
+    GLFWbool (*windowThrottled)(_GLFWwindow*);
+    GLFWbool (*windowOccluded)(_GLFWwindow*);
     GLFWbool (*framebufferTransparent)(_GLFWwindow*);
     float (*getWindowOpacity)(_GLFWwindow*);
     void (*setWindowResizable)(_GLFWwindow*,GLFWbool);
@@ -747,10 +907,13 @@ struct _GLFWplatform
     void (*setWindowFloating)(_GLFWwindow*,GLFWbool);
     void (*setWindowOpacity)(_GLFWwindow*,float);
     void (*setWindowMousePassthrough)(_GLFWwindow*,GLFWbool);
+    void (*setWindowEventMask)(_GLFWwindow*,int);
+    void (*presentPixels)(_GLFWwindow*,int,int,const unsigned char*,int,const int*,int);
     void (*pollEvents)(void);
     void (*waitEvents)(void);
     void (*waitEventsTimeout)(double);
     void (*postEmptyEvent)(void);
+    void (*flush)(void);
     // EGL
     EGLenum (*getEGLPlatform)(EGLint**);
     EGLNativeDisplayType (*getEGLNativeDisplay)(void);
@@ -761,6 +924,39 @@ struct _GLFWplatform
     VkResult (*createWindowSurface)(VkInstance,_GLFWwindow*,const VkAllocationCallbacks*,VkSurfaceKHR*);
 };
 
+// Vulkan loader data
+//
+struct _GLFWvulkan
+{
+    GLFWbool        available;
+    void*           handle;
+    char*           extensions[2];
+    PFN_vkGetInstanceProcAddr GetInstanceProcAddr;
+    GLFWbool        KHR_surface;
+    GLFWbool        KHR_win32_surface;
+    GLFWbool        MVK_macos_surface;
+    GLFWbool        EXT_metal_surface;
+    GLFWbool        KHR_xlib_surface;
+    GLFWbool        KHR_xcb_surface;
+    GLFWbool        KHR_wayland_surface;
+    GLFWbool        EXT_headless_surface;
+};
+
+// Client API libraries kept loaded across termination
+//
+// These are moved back into the library state by the next initialization
+// that needs them, skipping the loading and enumeration work
+//
+struct _GLFWretained
+{
+    void*           egl;
+    GLFWbool        eglPrefix;
+    void*           glx;
+    // This includes the instance extensions, as enumerating them loads the
+    // installable client drivers
+    _GLFWvulkan     vk;
+};
+
 // Library global data
 //
 struct _GLFWlibrary
@@ -781,18 +977,30 @@ struct _GLFWlibrary
     _GLFWerror*         errorListHead;
     _GLFWcursor*        cursorListHead;
     _GLFWwindow*        windowListHead;
+    // Incremented for every window system event processed, so a spinning wait
+    // can tell whether any event arrived
+    uint64_t            eventCount;
 
     _GLFWmonitor**      monitors;
     int                 monitorCount;
 
     GLFWbool            joysticksInitialized;
     _GLFWjoystick       joysticks[GLFW_JOYSTICK_LAST + 1];
+    _GLFWsnapshot       snapshots[GLFW_JOYSTICK_LAST + 1];
     _GLFWmapping*       mappings;
     int                 mappingCount;
+    char*               mappingNames;
+    uint32_t            mappingNamesSize;
+    uint32_t            mappingNamesCapacity;
+    uint32_t*           mappingNameTable;
+    uint32_t            mappingNameTableSize;
+    uint32_t            mappingNameCount;
 
     _GLFWtls            errorSlot;
     _GLFWtls            contextSlot;
     _GLFWmutex          errorLock;
+    _GLFWmutex          procCacheLock;
+    _GLFWproccache*     procCacheListHead;
 
     struct {
         uint64_t        offset;
@@ -816,6 +1024,9 @@ struct _GLFWlibrary
         GLFWbool        EXT_platform_x11;
         GLFWbool        EXT_platform_wayland;
         GLFWbool        EXT_present_opaque;
+        GLFWbool        CHROMIUM_sync_control;
+        GLFWbool        KHR_swap_buffers_with_damage;
+        GLFWbool        EXT_buffer_age;
         GLFWbool        ANGLE_platform_angle;
         GLFWbool        ANGLE_platform_angle_opengl;
         GLFWbool        ANGLE_platform_angle_d3d;
@@ -841,10 +1052,13 @@ struct _GLFWlibrary
         PFN_eglSwapBuffers          SwapBuffers;
         PFN_eglSwapInterval         SwapInterval;
         PFN_eglQueryString          QueryString;
+        PFN_eglQuerySurface         QuerySurface;
         PFN_eglGetProcAddress       GetProcAddress;
 
         PFNEGLGETPLATFORMDISPLAYEXTPROC GetPlatformDisplayEXT;
         PFNEGLCREATEPLATFORMWINDOWSURFACEEXTPROC CreatePlatformWindowSurfaceEXT;
+        PFNEGLGETSYNCVALUESCHROMIUMPROC GetSyncValuesCHROMIUM;
+        PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC SwapBuffersWithDamageKHR;
     } egl;
 
     struct {
@@ -860,24 +1074,15 @@ struct _GLFWlibrary
 
     } osmesa;
 
-    struct {
-        GLFWbool        available;
-        void*           handle;
-        char*           extensions[2];
-        PFN_vkGetInstanceProcAddr GetInstanceProcAddr;
-        GLFWbool        KHR_surface;
-        GLFWbool        KHR_win32_surface;
-        GLFWbool        MVK_macos_surface;
-        GLFWbool        EXT_metal_surface;
-        GLFWbool        KHR_xlib_surface;
-        GLFWbool        KHR_xcb_surface;
-        GLFWbool        KHR_wayland_surface;
-        GLFWbool        EXT_headless_surface;
-    } vk;
+    _GLFWvulkan         vk;
+
+    // Libraries kept across termination, see GLFW_RETAIN_LIBRARIES
+    _GLFWretained       retained;
 
     struct {
         GLFWmonitorfun  monitor;
         GLFWjoystickfun joystick;
+        GLFWtracefun    trace;
     } callbacks;
 
     // These are defined in platform.h
@@ -909,6 +1114,12 @@ void _glfwPlatformDestroyMutex(_GLFWmutex* mutex);
 void _glfwPlatformLockMutex(_GLFWmutex* mutex);
 void _glfwPlatformUnlockMutex(_GLFWmutex* mutex);
 
+void _glfwPlatformBeginSequenceWrite(volatile unsigned int* sequence);
+void _glfwPlatformEndSequenceWrite(volatile unsigned int* sequence);
+unsigned int _glfwPlatformBeginSequenceRead(const volatile unsigned int* sequence);
+GLFWbool _glfwPlatformEndSequenceRead(const volatile unsigned int* sequence,
+                                      unsigned int start);
+
 void* _glfwPlatformLoadModule(const char* path);
 void _glfwPlatformFreeModule(void* module);
 GLFWproc _glfwPlatformGetModuleSymbol(void* module, const char* name);
@@ -926,6 +1137,7 @@ void _glfwInputWindowContentScale(_GLFWwindow* window,
                                   float xscale, float yscale);
 void _glfwInputWindowIconify(_GLFWwindow* window, GLFWbool iconified);
 void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized);
+void _glfwInputWindowOcclusion(_GLFWwindow* window, GLFWbool occluded);
 void _glfwInputWindowDamage(_GLFWwindow* window);
 void _glfwInputWindowCloseRequest(_GLFWwindow* window);
 void _glfwInputWindowMonitor(_GLFWwindow* window, _GLFWmonitor* monitor);
@@ -947,6 +1159,8 @@ void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value);
 void _glfwInputMonitor(_GLFWmonitor* monitor, int action, int placement);
 void _glfwInputMonitorWindow(_GLFWmonitor* monitor, _GLFWwindow* window);
 
+void _glfwInputTrace(int event, const char* name);
+
 #if defined(__GNUC__)
 void _glfwInputError(int code, const char* format, ...)
     __attribute__((format(printf, 2, 3)));
@@ -968,6 +1182,7 @@ const _GLFWfbconfig* _glfwChooseFBConfig(const _GLFWfbconfig* desired,
 GLFWbool _glfwRefreshContextAttribs(_GLFWwindow* window,
                                     const _GLFWctxconfig* ctxconfig);
 GLFWbool _glfwIsValidContextConfig(const _GLFWctxconfig* ctxconfig);
+void _glfwReleaseProcCache(_GLFWwindow* window);
 
 const GLFWvidmode* _glfwChooseVideoMode(_GLFWmonitor* monitor,
                                         const GLFWvidmode* desired);
@@ -985,7 +1200,11 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
                                   int buttonCount,
                                   int hatCount);
 void _glfwFreeJoystick(_GLFWjoystick* js);
+void _glfwCompileGamepadMapping(_GLFWjoystick* js);
+GLFWbool _glfwApplyGamepadMapping(const _GLFWjoystick* js, GLFWgamepadstate* state);
+void _glfwPublishGamepadState(int jid, const GLFWgamepadstate* state);
 void _glfwCenterCursorInContentArea(_GLFWwindow* window);
+void _glfwUpdateWindowEventMask(_GLFWwindow* window);
 
 GLFWbool _glfwInitEGL(void);
 void _glfwTerminateEGL(void);
@@ -32,9 +32,12 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/inotify.h>
+#include <sys/eventfd.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <dirent.h>
+#include <poll.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -45,6 +48,18 @@
 #define SYN_DROPPED 3
 #endif
 
+// Joystick state owned by the service thread
+//
+// The service thread reads device events into its own copy of each joystick so
+// that the state seen by the main thread only changes when it polls
+//
+struct _GLFWshadowLinux
+{
+    _GLFWjoystick           js;
+    _GLFWmapping            mapping;
+    GLFWbool                dropped;
+};
+
 // Apply an EV_KEY event to the specified joystick
 //
 static void handleKeyEvent(_GLFWjoystick* js, int code, int value)
@@ -120,6 +135,152 @@ static void pollAbsState(_GLFWjoystick* js)
     }
 }
 
+// Read all queued events (non-blocking)
+// Axis and hat state is only resynchronized with the device if axes or buttons
+// were requested
+// Returns GLFW_FALSE if the device has been disconnected
+//
+static GLFWbool readJoystickEvents(_GLFWjoystick* js, GLFWbool* dropped, int mode)
+{
+    for (;;)
+    {
+        struct input_event e;
+
+        errno = 0;
+        if (read(js->linjs.fd, &e, sizeof(e)) < 0)
+            break;
+
+        if (e.type == EV_SYN)
+        {
+            if (e.code == SYN_DROPPED)
+                *dropped = GLFW_TRUE;
+            else if (e.code == SYN_REPORT)
+            {
+                *dropped = GLFW_FALSE;
+                js->linjs.absStale = GLFW_TRUE;
+            }
+        }
+
+        if (*dropped)
+            continue;
+
+        if (e.type == EV_KEY)
+            handleKeyEvent(js, e.code, e.value);
+        else if (e.type == EV_ABS)
+            handleAbsEvent(js, e.code, e.value);
+    }
+
+    if (errno == ENODEV)
+        return GLFW_FALSE;
+
+    // Resynchronizing takes one ioctl per axis so it is done once per poll
+    // instead of once per report, and deferred until axes or hats are wanted
+    if ((mode & _GLFW_POLL_ALL) && js->linjs.absStale)
+    {
+        pollAbsState(js);
+        js->linjs.absStale = GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Wakes the service thread so it picks up changes to the set of joysticks
+//
+static void wakeServiceThread(void)
+{
+    const uint64_t value = 1;
+    while (write(_glfw.linjs.wakeup, &value, sizeof(value)) < 0 && errno == EINTR)
+        ;
+}
+
+// Copies the mapping of the specified joystick to its service thread copy
+// This must be called with the service thread lock held
+//
+static void updateShadowMapping(struct _GLFWshadowLinux* shadow,
+                                const _GLFWjoystick* js)
+{
+    if (js->mapping)
+    {
+        shadow->mapping = *js->mapping;
+        shadow->js.mapping = &shadow->mapping;
+    }
+    else
+        shadow->js.mapping = NULL;
+
+    shadow->js.transform = js->transform;
+}
+
+// Frees the specified shadow joystick
+//
+static void freeShadow(struct _GLFWshadowLinux* shadow)
+{
+    _glfw_free(shadow->js.axes);
+    _glfw_free(shadow->js.buttons);
+    _glfw_free(shadow->js.hats);
+    _glfw_free(shadow);
+}
+
+// Hands the specified joystick over to the service thread
+// If this fails the joystick is left to be read by the main thread
+//
+static void createShadow(_GLFWjoystick* js)
+{
+    const int jid = (int) (js - _glfw.joysticks);
+    struct _GLFWshadowLinux* shadow = _glfw_calloc(1, sizeof(struct _GLFWshadowLinux));
+    if (!shadow)
+        return;
+
+    shadow->js.allocated   = GLFW_TRUE;
+    shadow->js.connected   = GLFW_TRUE;
+    shadow->js.axes        = _glfw_calloc(js->axisCount, sizeof(float));
+    shadow->js.buttons     = _glfw_calloc(js->buttonCount + (size_t) js->hatCount * 4, 1);
+    shadow->js.hats        = _glfw_calloc(js->hatCount, 1);
+
+    if ((js->axisCount && !shadow->js.axes) ||
+        ((js->buttonCount || js->hatCount) && !shadow->js.buttons) ||
+        (js->hatCount && !shadow->js.hats))
+    {
+        freeShadow(shadow);
+        return;
+    }
+
+    shadow->js.axisCount   = js->axisCount;
+    shadow->js.buttonCount = js->buttonCount;
+    shadow->js.hatCount    = js->hatCount;
+    shadow->js.linjs       = js->linjs;
+
+    memcpy(shadow->js.axes, js->axes, js->axisCount * sizeof(float));
+    memcpy(shadow->js.buttons, js->buttons, js->buttonCount + (size_t) js->hatCount * 4);
+    memcpy(shadow->js.hats, js->hats, js->hatCount);
+
+    pthread_mutex_lock(&_glfw.linjs.lock);
+    updateShadowMapping(shadow, js);
+    _glfw.linjs.shadows[jid] = shadow;
+    _glfw.snapshots[jid].threaded = GLFW_TRUE;
+    pthread_mutex_unlock(&_glfw.linjs.lock);
+
+    wakeServiceThread();
+}
+
+// Takes the specified joystick back from the service thread
+//
+static void destroyShadow(_GLFWjoystick* js)
+{
+    const int jid = (int) (js - _glfw.joysticks);
+
+    pthread_mutex_lock(&_glfw.linjs.lock);
+    struct _GLFWshadowLinux* shadow = _glfw.linjs.shadows[jid];
+    _glfw.linjs.shadows[jid] = NULL;
+    _glfw.snapshots[jid].threaded = GLFW_FALSE;
+    pthread_mutex_unlock(&_glfw.linjs.lock);
+
+    if (!shadow)
+        return;
+
+    wakeServiceThread();
+    freeShadow(shadow);
+}
+
 #define isBitSet(bit, arr) (arr[(bit) / 8] & (1 << ((bit) % 8)))
 
 // Attempt to open the specified joystick device
@@ -236,6 +397,10 @@ static GLFWbool openJoystickDevice(const char* path)
     pollAbsState(js);
 
     _glfwInputJoystick(js, GLFW_CONNECTED);
+
+    if (_glfw.linjs.threaded)
+        createShadow(js);
+
     return GLFW_TRUE;
 }
 
@@ -245,11 +410,192 @@ static GLFWbool openJoystickDevice(const char* path)
 //
 static void closeJoystick(_GLFWjoystick* js)
 {
+    if (_glfw.linjs.threaded)
+        destroyShadow(js);
+
     _glfwInputJoystick(js, GLFW_DISCONNECTED);
     close(js->linjs.fd);
     _glfwFreeJoystick(js);
 }
 
+// Copies the requested parts of the latest state read by the service thread
+// to the specified joystick
+//
+static GLFWbool pullShadowState(_GLFWjoystick* js, int mode)
+{
+    const int jid = (int) (js - _glfw.joysticks);
+    GLFWbool connected = GLFW_FALSE;
+
+    pthread_mutex_lock(&_glfw.linjs.lock);
+
+    struct _GLFWshadowLinux* shadow = _glfw.linjs.shadows[jid];
+    if (shadow && shadow->js.connected)
+    {
+        if (mode & _GLFW_POLL_AXES)
+            memcpy(js->axes, shadow->js.axes, js->axisCount * sizeof(float));
+
+        if (mode & _GLFW_POLL_BUTTONS)
+        {
+            memcpy(js->buttons, shadow->js.buttons,
+                   js->buttonCount + (size_t) js->hatCount * 4);
+            memcpy(js->hats, shadow->js.hats, js->hatCount);
+        }
+
+        updateShadowMapping(shadow, js);
+        connected = GLFW_TRUE;
+    }
+
+    pthread_mutex_unlock(&_glfw.linjs.lock);
+
+    // Reset the joystick slot if the service thread lost the device
+    if (!connected)
+        closeJoystick(js);
+
+    return js->connected;
+}
+
+// Entry point of the joystick service thread
+//
+static void* serviceThreadMain(void* arg)
+{
+    struct pollfd fds[GLFW_JOYSTICK_LAST + 2];
+    int jids[GLFW_JOYSTICK_LAST + 2];
+
+    for (;;)
+    {
+        nfds_t count = 0;
+
+        fds[count].fd = _glfw.linjs.wakeup;
+        fds[count].events = POLLIN;
+        count++;
+
+        pthread_mutex_lock(&_glfw.linjs.lock);
+
+        if (_glfw.linjs.stopping)
+        {
+            pthread_mutex_unlock(&_glfw.linjs.lock);
+            break;
+        }
+
+        for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+        {
+            const struct _GLFWshadowLinux* shadow = _glfw.linjs.shadows[jid];
+            if (!shadow || !shadow->js.connected)
+                continue;
+
+            fds[count].fd = shadow->js.linjs.fd;
+            fds[count].events = POLLIN;
+            jids[count] = jid;
+            count++;
+        }
+
+        pthread_mutex_unlock(&_glfw.linjs.lock);
+
+        if (poll(fds, count, -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            break;
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            uint64_t value;
+            while (read(_glfw.linjs.wakeup, &value, sizeof(value)) == sizeof(value))
+                ;
+        }
+
+        pthread_mutex_lock(&_glfw.linjs.lock);
+
+        for (nfds_t i = 1;  i < count;  i++)
+        {
+            if (!fds[i].revents)
+                continue;
+
+            // The joystick may have been closed while the thread was waiting
+            struct _GLFWshadowLinux* shadow = _glfw.linjs.shadows[jids[i]];
+            if (!shadow || shadow->js.linjs.fd != fds[i].fd)
+                continue;
+
+            GLFWgamepadstate state;
+
+            if (!readJoystickEvents(&shadow->js, &shadow->dropped, _GLFW_POLL_ALL) ||
+                (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)))
+            {
+                // Let the main thread report the disconnection
+                shadow->js.connected = GLFW_FALSE;
+                _glfwPublishGamepadState(jids[i], NULL);
+            }
+            else if (_glfwApplyGamepadMapping(&shadow->js, &state))
+                _glfwPublishGamepadState(jids[i], &state);
+        }
+
+        pthread_mutex_unlock(&_glfw.linjs.lock);
+    }
+
+    return NULL;
+}
+
+// Starts the joystick service thread and hands it all connected joysticks
+//
+static GLFWbool startServiceThread(void)
+{
+    _glfw.linjs.wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_glfw.linjs.wakeup == -1)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Linux: Failed to create joystick thread event: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    if (pthread_mutex_init(&_glfw.linjs.lock, NULL) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Linux: Failed to create joystick thread lock");
+        close(_glfw.linjs.wakeup);
+        return GLFW_FALSE;
+    }
+
+    if (pthread_create(&_glfw.linjs.thread, NULL, serviceThreadMain, NULL) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Linux: Failed to create joystick thread");
+        pthread_mutex_destroy(&_glfw.linjs.lock);
+        close(_glfw.linjs.wakeup);
+        return GLFW_FALSE;
+    }
+
+    _glfw.linjs.threaded = GLFW_TRUE;
+
+    for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (_glfw.joysticks[jid].connected)
+            createShadow(_glfw.joysticks + jid);
+    }
+
+    return GLFW_TRUE;
+}
+
+// Stops the joystick service thread
+//
+static void stopServiceThread(void)
+{
+    pthread_mutex_lock(&_glfw.linjs.lock);
+    _glfw.linjs.stopping = GLFW_TRUE;
+    pthread_mutex_unlock(&_glfw.linjs.lock);
+
+    wakeServiceThread();
+    pthread_join(_glfw.linjs.thread, NULL);
+
+    pthread_mutex_destroy(&_glfw.linjs.lock);
+    close(_glfw.linjs.wakeup);
+
+    _glfw.linjs.threaded = GLFW_FALSE;
+    _glfw.linjs.stopping = GLFW_FALSE;
+}
+
 // Lexically compare joysticks by name; used by qsort
 //
 static int compareJoysticks(const void* fp, const void* sp)
@@ -359,11 +705,24 @@ GLFWbool _glfwInitJoysticksLinux(void)
     // Continue with no joysticks if enumeration fails
 
     qsort(_glfw.joysticks, count, sizeof(_GLFWjoystick), compareJoysticks);
+
+    // Continue without the service thread if it cannot be started
+    if (_glfw.hints.init.joystickThread)
+        startServiceThread();
+
     return GLFW_TRUE;
 }
 
 void _glfwTerminateJoysticksLinux(void)
 {
+    if (_glfw.linjs.threaded)
+    {
+        for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+            destroyShadow(_glfw.joysticks + jid);
+
+        stopServiceThread();
+    }
+
     for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
     {
         _GLFWjoystick* js = _glfw.joysticks + jid;
@@ -385,40 +744,17 @@ void _glfwTerminateJoysticksLinux(void)
 
 GLFWbool _glfwPollJoystickLinux(_GLFWjoystick* js, int mode)
 {
-    // Read all queued events (non-blocking)
-    for (;;)
-    {
-        struct input_event e;
+    // Joysticks the service thread could not be given are read directly
+    if (_glfw.linjs.threaded && _glfw.linjs.shadows[js - _glfw.joysticks])
+        return pullShadowState(js, mode);
 
-        errno = 0;
-        if (read(js->linjs.fd, &e, sizeof(e)) < 0)
-        {
-            // Reset the joystick slot if the device was disconnected
-            if (errno == ENODEV)
-                closeJoystick(js);
+    // Device removal is reported by inotify, which is drained by event
+    // processing, so presence can be answered from the connection state
+    if (mode == _GLFW_POLL_PRESENCE && _glfw.linjs.watch > 0)
+        return js->connected;
 
-            break;
-        }
-
-        if (e.type == EV_SYN)
-        {
-            if (e.code == SYN_DROPPED)
-                _glfw.linjs.dropped = GLFW_TRUE;
-            else if (e.code == SYN_REPORT)
-            {
-                _glfw.linjs.dropped = GLFW_FALSE;
-                pollAbsState(js);
-            }
-        }
-
-        if (_glfw.linjs.dropped)
-            continue;
-
-        if (e.type == EV_KEY)
-            handleKeyEvent(js, e.code, e.value);
-        else if (e.type == EV_ABS)
-            handleAbsEvent(js, e.code, e.value);
-    }
+    if (!readJoystickEvents(js, &_glfw.linjs.dropped, mode))
+        closeJoystick(js);
 
     return js->connected;
 }
@@ -26,6 +26,7 @@
 
 #include <linux/input.h>
 #include <linux/limits.h>
+#include <pthread.h>
 #include <regex.h>
 
 #define GLFW_LINUX_JOYSTICK_STATE         _GLFWjoystickLinux linjs;
@@ -41,6 +42,7 @@ typedef struct _GLFWjoystickLinux
     int                     absMap[ABS_CNT];
     struct input_absinfo    absInfo[ABS_CNT];
     int                     hats[4][2];
+    GLFWbool                absStale;
 } _GLFWjoystickLinux;
 
 // Linux-specific joystick API data
@@ -52,6 +54,14 @@ typedef struct _GLFWlibraryLinux
     regex_t                 regex;
     GLFWbool                regexCompiled;
     GLFWbool                dropped;
+
+    // Joystick service thread, see GLFW_JOYSTICK_THREAD
+    GLFWbool                threaded;
+    GLFWbool                stopping;
+    pthread_t               thread;
+    pthread_mutex_t         lock;
+    int                     wakeup;
+    struct _GLFWshadowLinux* shadows[GLFW_JOYSTICK_LAST + 1];
 } _GLFWlibraryLinux;
 
 void _glfwDetectJoystickConnectionLinux(void);
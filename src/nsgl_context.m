@@ -348,6 +348,7 @@ GLFWbool _glfwCreateContextNSGL(_GLFWwindow* window,
     window->context.extensionSupported = extensionSupportedNSGL;
     window->context.getProcAddress = getProcAddressNSGL;
     window->context.destroy = destroyContextNSGL;
+    window->context.sharedProcs = GLFW_TRUE;
 
     return GLFW_TRUE;
 }
@@ -49,6 +49,7 @@ GLFWbool _glfwConnectNull(int platformID, _GLFWplatform* platform)
         .rawMouseMotionSupported = _glfwRawMouseMotionSupportedNull,
         .createCursor = _glfwCreateCursorNull,
         .createStandardCursor = _glfwCreateStandardCursorNull,
+        .createAnimatedCursor = _glfwCreateAnimatedCursorNull,
         .destroyCursor = _glfwDestroyCursorNull,
         .setCursor = _glfwSetCursorNull,
         .getScancodeName = _glfwGetScancodeNameNull,
@@ -94,6 +95,8 @@ GLFWbool _glfwConnectNull(int platformID, _GLFWplatform* platform)
         .windowVisible = _glfwWindowVisibleNull,
         .windowMaximized = _glfwWindowMaximizedNull,
         .windowHovered = _glfwWindowHoveredNull,
+        .windowThrottled = _glfwWindowThrottledNull,
+        .windowOccluded = _glfwWindowOccludedNull,
         .framebufferTransparent = _glfwFramebufferTransparentNull,
         .getWindowOpacity = _glfwGetWindowOpacityNull,
         .setWindowResizable = _glfwSetWindowResizableNull,
@@ -101,10 +104,13 @@ GLFWbool _glfwConnectNull(int platformID, _GLFWplatform* platform)
         .setWindowFloating = _glfwSetWindowFloatingNull,
         .setWindowOpacity = _glfwSetWindowOpacityNull,
         .setWindowMousePassthrough = _glfwSetWindowMousePassthroughNull,
+        .setWindowEventMask = _glfwSetWindowEventMaskNull,
+        .presentPixels = _glfwPresentPixelsNull,
         .pollEvents = _glfwPollEventsNull,
         .waitEvents = _glfwWaitEventsNull,
         .waitEventsTimeout = _glfwWaitEventsTimeoutNull,
         .postEmptyEvent = _glfwPostEmptyEventNull,
+        .flush = _glfwFlushNull,
         .getEGLPlatform = _glfwGetEGLPlatformNull,
         .getEGLNativeDisplay = _glfwGetEGLNativeDisplayNull,
         .getEGLNativeWindow = _glfwGetEGLNativeWindowNull,
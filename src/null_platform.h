@@ -183,6 +183,9 @@ typedef struct _GLFWwindowNull
     GLFWbool        floating;
     GLFWbool        transparent;
     float           opacity;
+    // The last presented software image, tightly packed
+    unsigned char*  pixels;
+    int             pixelsWidth, pixelsHeight;
 } _GLFWwindowNull;
 
 // Null-specific per-monitor data
@@ -238,11 +241,15 @@ void _glfwRestoreWindowNull(_GLFWwindow* window);
 void _glfwMaximizeWindowNull(_GLFWwindow* window);
 GLFWbool _glfwWindowMaximizedNull(_GLFWwindow* window);
 GLFWbool _glfwWindowHoveredNull(_GLFWwindow* window);
+GLFWbool _glfwWindowThrottledNull(_GLFWwindow* window);
+GLFWbool _glfwWindowOccludedNull(_GLFWwindow* window);
 GLFWbool _glfwFramebufferTransparentNull(_GLFWwindow* window);
 void _glfwSetWindowResizableNull(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowDecoratedNull(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowFloatingNull(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowMousePassthroughNull(_GLFWwindow* window, GLFWbool enabled);
+void _glfwSetWindowEventMaskNull(_GLFWwindow* window, int mask);
+void _glfwPresentPixelsNull(_GLFWwindow* window, int width, int height, const unsigned char* pixels, int stride, const int* rects, int count);
 float _glfwGetWindowOpacityNull(_GLFWwindow* window);
 void _glfwSetWindowOpacityNull(_GLFWwindow* window, float opacity);
 void _glfwSetRawMouseMotionNull(_GLFWwindow *window, GLFWbool enabled);
@@ -258,11 +265,13 @@ void _glfwPollEventsNull(void);
 void _glfwWaitEventsNull(void);
 void _glfwWaitEventsTimeoutNull(double timeout);
 void _glfwPostEmptyEventNull(void);
+void _glfwFlushNull(void);
 void _glfwGetCursorPosNull(_GLFWwindow* window, double* xpos, double* ypos);
 void _glfwSetCursorPosNull(_GLFWwindow* window, double x, double y);
 void _glfwSetCursorModeNull(_GLFWwindow* window, int mode);
 GLFWbool _glfwCreateCursorNull(_GLFWcursor* cursor, const GLFWimage* image, int xhot, int yhot);
 GLFWbool _glfwCreateStandardCursorNull(_GLFWcursor* cursor, int shape);
+GLFWbool _glfwCreateAnimatedCursorNull(_GLFWcursor* cursor, const GLFWimage* images, const int* delays, int count, int xhot, int yhot);
 void _glfwDestroyCursorNull(_GLFWcursor* cursor);
 void _glfwSetCursorNull(_GLFWwindow* window, _GLFWcursor* cursor);
 void _glfwSetClipboardStringNull(const char* string);
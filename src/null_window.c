@@ -176,6 +176,8 @@ void _glfwDestroyWindowNull(_GLFWwindow* window)
 
     if (window->context.destroy)
         window->context.destroy(window);
+
+    _glfw_free(window->null.pixels);
 }
 
 void _glfwSetWindowTitleNull(_GLFWwindow* window, const char* title)
@@ -339,6 +341,7 @@ void _glfwIconifyWindowNull(_GLFWwindow* window)
     {
         window->null.iconified = GLFW_TRUE;
         _glfwInputWindowIconify(window, GLFW_TRUE);
+        _glfwInputWindowOcclusion(window, _glfwWindowOccludedNull(window));
 
         if (window->monitor)
             releaseMonitor(window);
@@ -351,6 +354,7 @@ void _glfwRestoreWindowNull(_GLFWwindow* window)
     {
         window->null.iconified = GLFW_FALSE;
         _glfwInputWindowIconify(window, GLFW_FALSE);
+        _glfwInputWindowOcclusion(window, _glfwWindowOccludedNull(window));
 
         if (window->monitor)
             acquireMonitor(window);
@@ -384,6 +388,16 @@ GLFWbool _glfwWindowHoveredNull(_GLFWwindow* window)
            _glfw.null.ycursor <= window->null.ypos + window->null.height - 1;
 }
 
+GLFWbool _glfwWindowThrottledNull(_GLFWwindow* window)
+{
+    return _glfwWindowOccludedNull(window);
+}
+
+GLFWbool _glfwWindowOccludedNull(_GLFWwindow* window)
+{
+    return !window->null.visible || window->null.iconified;
+}
+
 GLFWbool _glfwFramebufferTransparentNull(_GLFWwindow* window)
 {
     return window->null.transparent;
@@ -408,6 +422,50 @@ void _glfwSetWindowMousePassthroughNull(_GLFWwindow* window, GLFWbool enabled)
 {
 }
 
+void _glfwSetWindowEventMaskNull(_GLFWwindow* window, int mask)
+{
+}
+
+void _glfwPresentPixelsNull(_GLFWwindow* window,
+                            int width, int height,
+                            const unsigned char* pixels,
+                            int stride,
+                            const int* rects,
+                            int count)
+{
+    const int whole[4] = { 0, 0, width, height };
+
+    if (window->null.pixelsWidth != width || window->null.pixelsHeight != height)
+    {
+        _glfw_free(window->null.pixels);
+        window->null.pixelsWidth = 0;
+        window->null.pixelsHeight = 0;
+
+        window->null.pixels = _glfw_calloc((size_t) width * height, 4);
+        if (!window->null.pixels)
+            return;
+
+        window->null.pixelsWidth = width;
+        window->null.pixelsHeight = height;
+
+        // A new image has no previous content for the damage to apply to
+        rects = whole;
+        count = 1;
+    }
+
+    for (int i = 0;  i < count;  i++)
+    {
+        const int* rect = rects + i * 4;
+
+        for (int y = rect[1];  y < rect[1] + rect[3];  y++)
+        {
+            memcpy(window->null.pixels + ((size_t) y * width + rect[0]) * 4,
+                   pixels + (size_t) y * stride + rect[0] * 4,
+                   (size_t) rect[2] * 4);
+        }
+    }
+}
+
 float _glfwGetWindowOpacityNull(_GLFWwindow* window)
 {
     return window->null.opacity;
@@ -430,6 +488,7 @@ GLFWbool _glfwRawMouseMotionSupportedNull(void)
 void _glfwShowWindowNull(_GLFWwindow* window)
 {
     window->null.visible = GLFW_TRUE;
+    _glfwInputWindowOcclusion(window, _glfwWindowOccludedNull(window));
 }
 
 void _glfwRequestWindowAttentionNull(_GLFWwindow* window)
@@ -445,6 +504,7 @@ void _glfwHideWindowNull(_GLFWwindow* window)
     }
 
     window->null.visible = GLFW_FALSE;
+    _glfwInputWindowOcclusion(window, _glfwWindowOccludedNull(window));
 }
 
 void _glfwFocusWindowNull(_GLFWwindow* window)
@@ -501,6 +561,10 @@ void _glfwPostEmptyEventNull(void)
 {
 }
 
+void _glfwFlushNull(void)
+{
+}
+
 void _glfwGetCursorPosNull(_GLFWwindow* window, double* xpos, double* ypos)
 {
     if (xpos)
@@ -531,6 +595,15 @@ GLFWbool _glfwCreateStandardCursorNull(_GLFWcursor* cursor, int shape)
     return GLFW_TRUE;
 }
 
+GLFWbool _glfwCreateAnimatedCursorNull(_GLFWcursor* cursor,
+                                       const GLFWimage* images,
+                                       const int* delays,
+                                       int count,
+                                       int xhot, int yhot)
+{
+    return GLFW_TRUE;
+}
+
 void _glfwDestroyCursorNull(_GLFWcursor* cursor)
 {
 }
@@ -280,6 +280,7 @@ GLFWbool _glfwCreateContextOSMesa(_GLFWwindow* window,
     window->context.extensionSupported = extensionSupportedOSMesa;
     window->context.getProcAddress = getProcAddressOSMesa;
     window->context.destroy = destroyContextOSMesa;
+    window->context.sharedProcs = GLFW_TRUE;
 
     return GLFW_TRUE;
 }
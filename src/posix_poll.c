@@ -36,12 +36,27 @@
 
 GLFWbool _glfwPollPOSIX(struct pollfd* fds, nfds_t count, double* timeout)
 {
+    const uint64_t frequency = _glfwPlatformGetTimerFrequency();
+    uint64_t deadline = 0;
+
+    if (timeout)
+    {
+        const uint64_t base = _glfwPlatformGetTimerValue();
+
+        // NOTE: The remaining time is derived from a fixed deadline so that
+        //       retries after interruptions do not accumulate rounding errors
+        if (*timeout <= 0.0)
+            deadline = base;
+        else if (*timeout * frequency < (double) (UINT64_MAX - base))
+            deadline = base + (uint64_t) (*timeout * frequency);
+        else
+            deadline = UINT64_MAX;
+    }
+
     for (;;)
     {
         if (timeout)
         {
-            const uint64_t base = _glfwPlatformGetTimerValue();
-
 #if defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__CYGWIN__)
             const time_t seconds = (time_t) *timeout;
             const long nanoseconds = (long) ((*timeout - seconds) * 1e9);
@@ -53,13 +68,17 @@ GLFWbool _glfwPollPOSIX(struct pollfd* fds, nfds_t count, double* timeout)
             const struct timespec ts = { seconds, nanoseconds };
             const int result = pollts(fds, count, &ts, NULL);
 #else
-            const int milliseconds = (int) (*timeout * 1e3);
+            // Round up to avoid waking before the deadline
+            const int milliseconds = (int) (*timeout * 1e3 + 0.999);
             const int result = poll(fds, count, milliseconds);
 #endif
             const int error = errno; // clock_gettime may overwrite our error
 
-            *timeout -= (_glfwPlatformGetTimerValue() - base) /
-                (double) _glfwPlatformGetTimerFrequency();
+            const uint64_t now = _glfwPlatformGetTimerValue();
+            if (now < deadline)
+                *timeout = (deadline - now) / (double) frequency;
+            else
+                *timeout = 0.0;
 
             if (result > 0)
                 return GLFW_TRUE;
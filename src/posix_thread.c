@@ -30,6 +30,7 @@
 #if defined(GLFW_BUILD_POSIX_THREAD)
 
 #include <assert.h>
+#include <sched.h>
 #include <string.h>
 
 
@@ -103,5 +104,47 @@ void _glfwPlatformUnlockMutex(_GLFWmutex* mutex)
     pthread_mutex_unlock(&mutex->posix.handle);
 }
 
+void _glfwPlatformBeginSequenceWrite(volatile unsigned int* sequence)
+{
+    // An odd sequence value marks a write in progress and excludes other writers
+    for (;;)
+    {
+        unsigned int start = __atomic_load_n(sequence, __ATOMIC_RELAXED);
+        if (!(start & 1) &&
+            __atomic_compare_exchange_n(sequence, &start, start + 1, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+
+        sched_yield();
+    }
+
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void _glfwPlatformEndSequenceWrite(volatile unsigned int* sequence)
+{
+    __atomic_store_n(sequence, *sequence + 1, __ATOMIC_RELEASE);
+}
+
+unsigned int _glfwPlatformBeginSequenceRead(const volatile unsigned int* sequence)
+{
+    unsigned int start;
+
+    // Writes only copy a gamepad state, so spin instead of making system calls
+    while ((start = __atomic_load_n(sequence, __ATOMIC_ACQUIRE)) & 1)
+        ;
+
+    return start;
+}
+
+GLFWbool _glfwPlatformEndSequenceRead(const volatile unsigned int* sequence,
+                                      unsigned int start)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(sequence, __ATOMIC_RELAXED) == start;
+}
+
 #endif // GLFW_BUILD_POSIX_THREAD
 
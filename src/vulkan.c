@@ -49,6 +49,19 @@ GLFWbool _glfwInitVulkan(int mode)
     if (_glfw.vk.available)
         return GLFW_TRUE;
 
+    if (_glfw.retained.vk.available && !_glfw.hints.init.vulkanLoader)
+    {
+        // Reuse the loader and instance extensions of an earlier initialization
+        _glfw.vk = _glfw.retained.vk;
+        memset(&_glfw.retained.vk, 0, sizeof(_glfw.retained.vk));
+
+        _glfw.vk.extensions[0] = NULL;
+        _glfw.vk.extensions[1] = NULL;
+        _glfw.platform.getRequiredInstanceExtensions(_glfw.vk.extensions);
+
+        return GLFW_TRUE;
+    }
+
     if (_glfw.hints.init.vulkanLoader)
         _glfw.vk.GetInstanceProcAddr = _glfw.hints.init.vulkanLoader;
     else
@@ -158,7 +171,14 @@ GLFWbool _glfwInitVulkan(int mode)
 void _glfwTerminateVulkan(void)
 {
     if (_glfw.vk.handle)
-        _glfwPlatformFreeModule(_glfw.vk.handle);
+    {
+        if (_glfw.hints.init.retainLibraries && _glfw.vk.available)
+            _glfw.retained.vk = _glfw.vk;
+        else
+            _glfwPlatformFreeModule(_glfw.vk.handle);
+
+        _glfw.vk.handle = NULL;
+    }
 }
 
 const char* _glfwGetVulkanResultString(VkResult result)
@@ -612,6 +612,7 @@ GLFWbool _glfwConnectWin32(int platformID, _GLFWplatform* platform)
         .rawMouseMotionSupported = _glfwRawMouseMotionSupportedWin32,
         .createCursor = _glfwCreateCursorWin32,
         .createStandardCursor = _glfwCreateStandardCursorWin32,
+        .createAnimatedCursor = _glfwCreateAnimatedCursorWin32,
         .destroyCursor = _glfwDestroyCursorWin32,
         .setCursor = _glfwSetCursorWin32,
         .getScancodeName = _glfwGetScancodeNameWin32,
@@ -657,6 +658,8 @@ GLFWbool _glfwConnectWin32(int platformID, _GLFWplatform* platform)
         .windowVisible = _glfwWindowVisibleWin32,
         .windowMaximized = _glfwWindowMaximizedWin32,
         .windowHovered = _glfwWindowHoveredWin32,
+        .windowThrottled = _glfwWindowThrottledWin32,
+        .windowOccluded = _glfwWindowOccludedWin32,
         .framebufferTransparent = _glfwFramebufferTransparentWin32,
         .getWindowOpacity = _glfwGetWindowOpacityWin32,
         .setWindowResizable = _glfwSetWindowResizableWin32,
@@ -664,10 +667,13 @@ GLFWbool _glfwConnectWin32(int platformID, _GLFWplatform* platform)
         .setWindowFloating = _glfwSetWindowFloatingWin32,
         .setWindowOpacity = _glfwSetWindowOpacityWin32,
         .setWindowMousePassthrough = _glfwSetWindowMousePassthroughWin32,
+        .setWindowEventMask = _glfwSetWindowEventMaskWin32,
+        .presentPixels = _glfwPresentPixelsWin32,
         .pollEvents = _glfwPollEventsWin32,
         .waitEvents = _glfwWaitEventsWin32,
         .waitEventsTimeout = _glfwWaitEventsTimeoutWin32,
         .postEmptyEvent = _glfwPostEmptyEventWin32,
+        .flush = _glfwFlushWin32,
         .getEGLPlatform = _glfwGetEGLPlatformWin32,
         .getEGLNativeDisplay = _glfwGetEGLNativeDisplayWin32,
         .getEGLNativeWindow = _glfwGetEGLNativeWindowWin32,
@@ -96,5 +96,45 @@ void _glfwPlatformUnlockMutex(_GLFWmutex* mutex)
     LeaveCriticalSection(&mutex->win32.section);
 }
 
+void _glfwPlatformBeginSequenceWrite(volatile unsigned int* sequence)
+{
+    // An odd sequence value marks a write in progress and excludes other writers
+    for (;;)
+    {
+        const LONG start = *(volatile LONG*) sequence;
+        if (!(start & 1) &&
+            InterlockedCompareExchange((volatile LONG*) sequence,
+                                       start + 1, start) == start)
+        {
+            break;
+        }
+
+        YieldProcessor();
+    }
+}
+
+void _glfwPlatformEndSequenceWrite(volatile unsigned int* sequence)
+{
+    InterlockedIncrement((volatile LONG*) sequence);
+}
+
+unsigned int _glfwPlatformBeginSequenceRead(const volatile unsigned int* sequence)
+{
+    unsigned int start;
+
+    while ((start = *sequence) & 1)
+        YieldProcessor();
+
+    MemoryBarrier();
+    return start;
+}
+
+GLFWbool _glfwPlatformEndSequenceRead(const volatile unsigned int* sequence,
+                                      unsigned int start)
+{
+    MemoryBarrier();
+    return *sequence == start;
+}
+
 #endif // GLFW_BUILD_WIN32_THREAD
 
@@ -832,7 +832,7 @@ static LRESULT CALLBACK windowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
 
             for (i = 0;  i <= GLFW_MOUSE_BUTTON_LAST;  i++)
             {
-                if (window->mouseButtons[i] == GLFW_PRESS)
+                if (_GLFW_BIT_TEST(window->mouseButtonBits, i))
                     break;
             }
 
@@ -843,7 +843,7 @@ static LRESULT CALLBACK windowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
 
             for (i = 0;  i <= GLFW_MOUSE_BUTTON_LAST;  i++)
             {
-                if (window->mouseButtons[i] == GLFW_PRESS)
+                if (_GLFW_BIT_TEST(window->mouseButtonBits, i))
                     break;
             }
 
@@ -1061,9 +1061,17 @@ static LRESULT CALLBACK windowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
 
             window->win32.iconified = iconified;
             window->win32.maximized = maximized;
+            _glfwInputWindowOcclusion(window, _glfwWindowOccludedWin32(window));
             return 0;
         }
 
+        case WM_SHOWWINDOW:
+        {
+            // The window is not yet visible or hidden when this is sent
+            _glfwInputWindowOcclusion(window, !wParam || window->win32.iconified);
+            break;
+        }
+
         case WM_MOVE:
         {
             if (_glfw.win32.capturedCursorWindow == window)
@@ -1497,7 +1505,10 @@ GLFWbool _glfwCreateWindowWin32(_GLFWwindow* window,
                                 const _GLFWctxconfig* ctxconfig,
                                 const _GLFWfbconfig* fbconfig)
 {
-    if (!createNativeWindow(window, wndconfig, fbconfig))
+    _GLFW_TRACE_BEGIN("createNativeWindow");
+    const GLFWbool created = createNativeWindow(window, wndconfig, fbconfig);
+    _GLFW_TRACE_END("createNativeWindow");
+    if (!created)
         return GLFW_FALSE;
 
     if (ctxconfig->client != GLFW_NO_API)
@@ -1973,6 +1984,16 @@ GLFWbool _glfwWindowHoveredWin32(_GLFWwindow* window)
     return cursorInContentArea(window);
 }
 
+GLFWbool _glfwWindowThrottledWin32(_GLFWwindow* window)
+{
+    return _glfwWindowOccludedWin32(window);
+}
+
+GLFWbool _glfwWindowOccludedWin32(_GLFWwindow* window)
+{
+    return !IsWindowVisible(window->win32.handle) || window->win32.iconified;
+}
+
 GLFWbool _glfwFramebufferTransparentWin32(_GLFWwindow* window)
 {
     BOOL composition, opaque;
@@ -2047,6 +2068,21 @@ void _glfwSetWindowMousePassthroughWin32(_GLFWwindow* window, GLFWbool enabled)
         SetLayeredWindowAttributes(window->win32.handle, key, alpha, flags);
 }
 
+void _glfwSetWindowEventMaskWin32(_GLFWwindow* window, int mask)
+{
+}
+
+void _glfwPresentPixelsWin32(_GLFWwindow* window,
+                             int width, int height,
+                             const unsigned char* pixels,
+                             int stride,
+                             const int* rects,
+                             int count)
+{
+    _glfwInputError(GLFW_FEATURE_UNIMPLEMENTED,
+                    "Win32: Presenting pixels not yet implemented");
+}
+
 float _glfwGetWindowOpacityWin32(_GLFWwindow* window)
 {
     BYTE alpha;
@@ -2107,6 +2143,8 @@ void _glfwPollEventsWin32(void)
 
     while (PeekMessageW(&msg, NULL, 0, 0, PM_REMOVE))
     {
+        _glfw.eventCount++;
+
         if (msg.message == WM_QUIT)
         {
             // NOTE: While GLFW does not itself post WM_QUIT, other processes
@@ -2123,7 +2161,10 @@ void _glfwPollEventsWin32(void)
         else
         {
             TranslateMessage(&msg);
+
+            _GLFW_TRACE_BEGIN("DispatchMessage");
             DispatchMessageW(&msg);
+            _GLFW_TRACE_END("DispatchMessage");
         }
     }
 
@@ -2157,7 +2198,7 @@ void _glfwPollEventsWin32(void)
 
                 if ((GetKeyState(vk) & 0x8000))
                     continue;
-                if (window->keys[key] != GLFW_PRESS)
+                if (!_GLFW_BIT_TEST(window->keyBits, key))
                     continue;
 
                 _glfwInputKey(window, key, scancode, GLFW_RELEASE, getKeyMods());
@@ -2191,7 +2232,8 @@ void _glfwWaitEventsWin32(void)
 
 void _glfwWaitEventsTimeoutWin32(double timeout)
 {
-    MsgWaitForMultipleObjects(0, NULL, FALSE, (DWORD) (timeout * 1e3), QS_ALLINPUT);
+    // Round up to avoid waking before the deadline of glfwWaitEventsUntil
+    MsgWaitForMultipleObjects(0, NULL, FALSE, (DWORD) (timeout * 1e3 + 0.999), QS_ALLINPUT);
 
     _glfwPollEventsWin32();
 }
@@ -2201,6 +2243,11 @@ void _glfwPostEmptyEventWin32(void)
     PostMessageW(_glfw.win32.helperWindowHandle, WM_NULL, 0, 0);
 }
 
+void _glfwFlushWin32(void)
+{
+    // Window requests take effect immediately on Win32
+}
+
 void _glfwGetCursorPosWin32(_GLFWwindow* window, double* xpos, double* ypos)
 {
     POINT pos;
@@ -2352,6 +2399,17 @@ GLFWbool _glfwCreateStandardCursorWin32(_GLFWcursor* cursor, int shape)
     return GLFW_TRUE;
 }
 
+GLFWbool _glfwCreateAnimatedCursorWin32(_GLFWcursor* cursor,
+                                        const GLFWimage* images,
+                                        const int* delays,
+                                        int count,
+                                        int xhot, int yhot)
+{
+    _glfwInputError(GLFW_FEATURE_UNIMPLEMENTED,
+                    "Win32: Animated cursors not yet implemented");
+    return GLFW_FALSE;
+}
+
 void _glfwDestroyCursorWin32(_GLFWcursor* cursor)
 {
     if (cursor->win32.handle)
@@ -34,6 +34,36 @@
 #include <float.h>
 
 
+// Waits for and processes events until the specified platform timer deadline
+//
+static void waitEventsUntil(uint64_t deadline)
+{
+    const uint64_t frequency = _glfwPlatformGetTimerFrequency();
+    uint64_t margin = 0;
+
+    if (_glfw.hints.init.waitSpinMargin > 0)
+        margin = _glfw.hints.init.waitSpinMargin * frequency / 1000000;
+
+    // The deadline is a raw timer value, so it has no offset to convert
+    const uint64_t now = _glfwPlatformGetTimerValue();
+    if (now < deadline && deadline - now > margin)
+    {
+        const uint64_t wake = deadline - margin;
+        _glfw.platform.waitEventsTimeout((wake - now) / (double) frequency);
+
+        // Waking before it was time to spin means events were processed
+        if (!margin || _glfwPlatformGetTimerValue() < wake)
+            return;
+    }
+
+    // Process events as they arrive until the first one or the deadline
+    const uint64_t count = _glfw.eventCount;
+
+    do
+        _glfw.platform.pollEvents();
+    while (_glfw.eventCount == count && _glfwPlatformGetTimerValue() < deadline);
+}
+
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -54,7 +84,7 @@ void _glfwInputWindowFocus(_GLFWwindow* window, GLFWbool focused)
 
         for (key = 0;  key <= GLFW_KEY_LAST;  key++)
         {
-            if (window->keys[key] == GLFW_PRESS)
+            if (_GLFW_BIT_TEST(window->keyBits, key))
             {
                 const int scancode = _glfw.platform.getKeyScancode(key);
                 _glfwInputKey(window, key, scancode, GLFW_RELEASE, 0);
@@ -63,7 +93,7 @@ void _glfwInputWindowFocus(_GLFWwindow* window, GLFWbool focused)
 
         for (button = 0;  button <= GLFW_MOUSE_BUTTON_LAST;  button++)
         {
-            if (window->mouseButtons[button] == GLFW_PRESS)
+            if (_GLFW_BIT_TEST(window->mouseButtonBits, button))
                 _glfwInputMouseClick(window, button, GLFW_RELEASE, 0);
         }
     }
@@ -115,6 +145,23 @@ void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized)
         window->callbacks.maximize((GLFWwindow*) window, maximized);
 }
 
+// Notifies shared code that a window may have become occluded or visible
+//
+void _glfwInputWindowOcclusion(_GLFWwindow* window, GLFWbool occluded)
+{
+    assert(window != NULL);
+    assert(occluded == GLFW_TRUE || occluded == GLFW_FALSE);
+
+    // Platforms report every change that may affect occlusion
+    if (window->occluded == occluded)
+        return;
+
+    window->occluded = occluded;
+
+    if (window->callbacks.occlusion)
+        window->callbacks.occlusion((GLFWwindow*) window, occluded);
+}
+
 // Notifies shared code that a window framebuffer has been resized
 // The size is specified in pixels
 //
@@ -214,6 +261,8 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
     if (!_glfwIsValidContextConfig(&ctxconfig))
         return NULL;
 
+    _GLFW_TRACE_BEGIN("glfwCreateWindow");
+
     window = _glfw_calloc(1, sizeof(_GLFWwindow));
     window->next = _glfw.windowListHead;
     _glfw.windowListHead = window;
@@ -232,7 +281,10 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
     window->floating         = wndconfig.floating;
     window->focusOnShow      = wndconfig.focusOnShow;
     window->mousePassthrough = wndconfig.mousePassthrough;
+    window->skipOccludedSwap = wndconfig.skipOccludedSwap;
     window->cursorMode       = GLFW_CURSOR_NORMAL;
+    window->eventMask        = GLFW_EVENT_MASK_ALL;
+    window->activeEventMask  = GLFW_EVENT_MASK_ALL;
 
     window->doublebuffer = fbconfig.doublebuffer;
 
@@ -247,9 +299,11 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
     if (!_glfw.platform.createWindow(window, &wndconfig, &ctxconfig, &fbconfig))
     {
         glfwDestroyWindow((GLFWwindow*) window);
+        _GLFW_TRACE_END("glfwCreateWindow");
         return NULL;
     }
 
+    _GLFW_TRACE_END("glfwCreateWindow");
     return (GLFWwindow*) window;
 }
 
@@ -398,6 +452,9 @@ GLFWAPI void glfwWindowHint(int hint, int value)
         case GLFW_MOUSE_PASSTHROUGH:
             _glfw.hints.window.mousePassthrough = value ? GLFW_TRUE : GLFW_FALSE;
             return;
+        case GLFW_SKIP_OCCLUDED_SWAP:
+            _glfw.hints.window.skipOccludedSwap = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
         case GLFW_CLIENT_API:
             _glfw.hints.context.client = value;
             return;
@@ -483,6 +540,7 @@ GLFWAPI void glfwDestroyWindow(GLFWwindow* handle)
     if (window == _glfwPlatformGetTls(&_glfw.contextSlot))
         glfwMakeContextCurrent(NULL);
 
+    _glfwReleaseProcCache(window);
     _glfw.platform.destroyWindow(window);
 
     // Unlink window from global linked list
@@ -538,6 +596,10 @@ GLFWAPI void glfwSetWindowTitle(GLFWwindow* handle, const char* title)
     _GLFWwindow* window = (_GLFWwindow*) handle;
     assert(window != NULL);
 
+    // Setting the same title again is common when it is updated every frame
+    if (window->title && strcmp(window->title, title) == 0)
+        return;
+
     char* prev = window->title;
     window->title = _glfw_strdup(title);
 
@@ -896,6 +958,12 @@ GLFWAPI int glfwGetWindowAttrib(GLFWwindow* handle, int attrib)
             return _glfw.platform.windowMaximized(window);
         case GLFW_HOVERED:
             return _glfw.platform.windowHovered(window);
+        case GLFW_THROTTLED:
+            return _glfw.platform.windowThrottled(window);
+        case GLFW_OCCLUDED:
+            return _glfw.platform.windowOccluded(window);
+        case GLFW_SKIP_OCCLUDED_SWAP:
+            return window->skipOccludedSwap;
         case GLFW_FOCUS_ON_SHOW:
             return window->focusOnShow;
         case GLFW_MOUSE_PASSTHROUGH:
@@ -981,6 +1049,10 @@ GLFWAPI void glfwSetWindowAttrib(GLFWwindow* handle, int attrib, int value)
             window->mousePassthrough = value;
             _glfw.platform.setWindowMousePassthrough(window, value);
             return;
+
+        case GLFW_SKIP_OCCLUDED_SWAP:
+            window->skipOccludedSwap = value;
+            return;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid window attribute 0x%08X", attrib);
@@ -1056,6 +1128,33 @@ GLFWAPI void* glfwGetWindowUserPointer(GLFWwindow* handle)
     return window->userPointer;
 }
 
+GLFWAPI void glfwSetWindowEventMask(GLFWwindow* handle, int mask)
+{
+    _GLFW_REQUIRE_INIT();
+
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (mask & ~(GLFW_EVENT_MASK_ALL | GLFW_EVENT_MASK_AUTO))
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid window event mask 0x%08X", mask);
+        return;
+    }
+
+    window->eventMask = mask;
+    _glfwUpdateWindowEventMask(window);
+}
+
+GLFWAPI int glfwGetWindowEventMask(GLFWwindow* handle)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    return window->eventMask;
+}
+
 GLFWAPI GLFWwindowposfun glfwSetWindowPosCallback(GLFWwindow* handle,
                                                   GLFWwindowposfun cbfun)
 {
@@ -1101,6 +1200,7 @@ GLFWAPI GLFWwindowrefreshfun glfwSetWindowRefreshCallback(GLFWwindow* handle,
     assert(window != NULL);
 
     _GLFW_SWAP(GLFWwindowrefreshfun, window->callbacks.refresh, cbfun);
+    _glfwUpdateWindowEventMask(window);
     return cbfun;
 }
 
@@ -1140,6 +1240,18 @@ GLFWAPI GLFWwindowmaximizefun glfwSetWindowMaximizeCallback(GLFWwindow* handle,
     return cbfun;
 }
 
+GLFWAPI GLFWwindowocclusionfun glfwSetWindowOcclusionCallback(GLFWwindow* handle,
+                                                              GLFWwindowocclusionfun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_SWAP(GLFWwindowocclusionfun, window->callbacks.occlusion, cbfun);
+    return cbfun;
+}
+
 GLFWAPI GLFWframebuffersizefun glfwSetFramebufferSizeCallback(GLFWwindow* handle,
                                                               GLFWframebuffersizefun cbfun)
 {
@@ -1167,13 +1279,19 @@ GLFWAPI GLFWwindowcontentscalefun glfwSetWindowContentScaleCallback(GLFWwindow*
 GLFWAPI void glfwPollEvents(void)
 {
     _GLFW_REQUIRE_INIT();
+
+    _GLFW_TRACE_BEGIN("glfwPollEvents");
     _glfw.platform.pollEvents();
+    _GLFW_TRACE_END("glfwPollEvents");
 }
 
 GLFWAPI void glfwWaitEvents(void)
 {
     _GLFW_REQUIRE_INIT();
+
+    _GLFW_TRACE_BEGIN("glfwWaitEvents");
     _glfw.platform.waitEvents();
+    _GLFW_TRACE_END("glfwWaitEvents");
 }
 
 GLFWAPI void glfwWaitEventsTimeout(double timeout)
@@ -1189,7 +1307,18 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout)
         return;
     }
 
+    _GLFW_TRACE_BEGIN("glfwWaitEventsTimeout");
     _glfw.platform.waitEventsTimeout(timeout);
+    _GLFW_TRACE_END("glfwWaitEventsTimeout");
+}
+
+GLFWAPI void glfwWaitEventsUntil(uint64_t deadline)
+{
+    _GLFW_REQUIRE_INIT();
+
+    _GLFW_TRACE_BEGIN("glfwWaitEventsUntil");
+    waitEventsUntil(deadline);
+    _GLFW_TRACE_END("glfwWaitEventsUntil");
 }
 
 GLFWAPI void glfwPostEmptyEvent(void)
@@ -1198,3 +1327,9 @@ GLFWAPI void glfwPostEmptyEvent(void)
     _glfw.platform.postEmptyEvent();
 }
 
+GLFWAPI void glfwFlush(void)
+{
+    _GLFW_REQUIRE_INIT();
+    _glfw.platform.flush();
+}
+
@@ -29,12 +29,12 @@
 #if defined(_GLFW_WAYLAND)
 
 #include <errno.h>
-#include <limits.h>
 #include <linux/input.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
+#include <sys/eventfd.h>
 #include <sys/timerfd.h>
 #include <unistd.h>
 #include <time.h>
@@ -113,7 +113,7 @@ static void registryHandleGlobal(void* userData,
     {
         _glfw.wl.compositor =
             wl_registry_bind(registry, name, &wl_compositor_interface,
-                             _glfw_min(3, version));
+                             _glfw_min(4, version));
     }
     else if (strcmp(interface, "wl_subcompositor") == 0)
     {
@@ -395,38 +395,6 @@ static void createKeyTables(void)
     }
 }
 
-static GLFWbool loadCursorTheme(void)
-{
-    int cursorSize = 16;
-
-    const char* sizeString = getenv("XCURSOR_SIZE");
-    if (sizeString)
-    {
-        errno = 0;
-        const long cursorSizeLong = strtol(sizeString, NULL, 10);
-        if (errno == 0 && cursorSizeLong > 0 && cursorSizeLong < INT_MAX)
-            cursorSize = (int) cursorSizeLong;
-    }
-
-    const char* themeName = getenv("XCURSOR_THEME");
-
-    _glfw.wl.cursorTheme = wl_cursor_theme_load(themeName, cursorSize, _glfw.wl.shm);
-    if (!_glfw.wl.cursorTheme)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Failed to load default cursor theme");
-        return GLFW_FALSE;
-    }
-
-    // If this happens to be NULL, we just fallback to the scale=1 version.
-    _glfw.wl.cursorThemeHiDPI =
-        wl_cursor_theme_load(themeName, cursorSize * 2, _glfw.wl.shm);
-
-    _glfw.wl.cursorSurface = wl_compositor_create_surface(_glfw.wl.compositor);
-    _glfw.wl.cursorTimerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
-    return GLFW_TRUE;
-}
-
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -446,6 +414,7 @@ GLFWbool _glfwConnectWayland(int platformID, _GLFWplatform* platform)
         .rawMouseMotionSupported = _glfwRawMouseMotionSupportedWayland,
         .createCursor = _glfwCreateCursorWayland,
         .createStandardCursor = _glfwCreateStandardCursorWayland,
+        .createAnimatedCursor = _glfwCreateAnimatedCursorWayland,
         .destroyCursor = _glfwDestroyCursorWayland,
         .setCursor = _glfwSetCursorWayland,
         .getScancodeName = _glfwGetScancodeNameWayland,
@@ -499,6 +468,8 @@ GLFWbool _glfwConnectWayland(int platformID, _GLFWplatform* platform)
         .windowVisible = _glfwWindowVisibleWayland,
         .windowMaximized = _glfwWindowMaximizedWayland,
         .windowHovered = _glfwWindowHoveredWayland,
+        .windowThrottled = _glfwWindowThrottledWayland,
+        .windowOccluded = _glfwWindowOccludedWayland,
         .framebufferTransparent = _glfwFramebufferTransparentWayland,
         .getWindowOpacity = _glfwGetWindowOpacityWayland,
         .setWindowResizable = _glfwSetWindowResizableWayland,
@@ -506,10 +477,13 @@ GLFWbool _glfwConnectWayland(int platformID, _GLFWplatform* platform)
         .setWindowFloating = _glfwSetWindowFloatingWayland,
         .setWindowOpacity = _glfwSetWindowOpacityWayland,
         .setWindowMousePassthrough = _glfwSetWindowMousePassthroughWayland,
+        .setWindowEventMask = _glfwSetWindowEventMaskWayland,
+        .presentPixels = _glfwPresentPixelsWayland,
         .pollEvents = _glfwPollEventsWayland,
         .waitEvents = _glfwWaitEventsWayland,
         .waitEventsTimeout = _glfwWaitEventsTimeoutWayland,
         .postEmptyEvent = _glfwPostEmptyEventWayland,
+        .flush = _glfwFlushWayland,
         .getEGLPlatform = _glfwGetEGLPlatformWayland,
         .getEGLNativeDisplay = _glfwGetEGLNativeDisplayWayland,
         .getEGLNativeWindow = _glfwGetEGLNativeWindowWayland,
@@ -566,6 +540,7 @@ int _glfwInitWayland(void)
     // These must be set before any failure checks
     _glfw.wl.keyRepeatTimerfd = -1;
     _glfw.wl.cursorTimerfd = -1;
+    _glfw.wl.xkb.worker.done = -1;
 
     _glfw.wl.tag = glfwGetVersionString();
 
@@ -829,6 +804,7 @@ int _glfwInitWayland(void)
     wl_registry_add_listener(_glfw.wl.registry, &registryListener, NULL);
 
     createKeyTables();
+    _glfwInitKeySym2Unicode();
 
     _glfw.wl.xkb.context = xkb_context_new(0);
     if (!_glfw.wl.xkb.context)
@@ -838,6 +814,18 @@ int _glfwInitWayland(void)
         return GLFW_FALSE;
     }
 
+    if (_glfw.hints.init.wl.keymapThread)
+    {
+        _glfw.wl.xkb.worker.done = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (_glfw.wl.xkb.worker.done == -1)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Failed to create keymap thread event: %s",
+                            strerror(errno));
+            return GLFW_FALSE;
+        }
+    }
+
     // Sync so we got all registry objects
     wl_display_roundtrip(_glfw.wl.display);
 
@@ -874,8 +862,10 @@ int _glfwInitWayland(void)
         return GLFW_FALSE;
     }
 
-    if (!loadCursorTheme())
-        return GLFW_FALSE;
+    // The cursor themes are loaded when first needed, as most of a theme is
+    // never used by a given program
+    _glfw.wl.cursorSurface = wl_compositor_create_surface(_glfw.wl.compositor);
+    _glfw.wl.cursorTimerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
 
     if (_glfw.wl.seat && _glfw.wl.dataDeviceManager)
     {
@@ -915,10 +905,36 @@ void _glfwTerminateWayland(void)
         _glfw.wl.egl.handle = NULL;
     }
 
+    if (_glfw.wl.xkb.worker.running)
+    {
+        pthread_join(_glfw.wl.xkb.worker.thread, NULL);
+
+        if (_glfw.wl.xkb.worker.keymap)
+            xkb_keymap_unref(_glfw.wl.xkb.worker.keymap);
+        if (_glfw.wl.xkb.worker.composeTable)
+            xkb_compose_table_unref(_glfw.wl.xkb.worker.composeTable);
+
+        _glfw_free(_glfw.wl.xkb.worker.text);
+        _glfw_free(_glfw.wl.xkb.worker.locale);
+    }
+
+    _glfw_free(_glfw.wl.xkb.worker.pendingText);
+
+    if (_glfw.wl.xkb.worker.done >= 0)
+        close(_glfw.wl.xkb.worker.done);
+
+    for (int i = 0;  i < _GLFW_WL_KEYMAP_CACHE_SIZE;  i++)
+    {
+        if (_glfw.wl.xkb.keymaps[i].keymap)
+            xkb_keymap_unref(_glfw.wl.xkb.keymaps[i].keymap);
+
+        _glfw_free(_glfw.wl.xkb.keymaps[i].text);
+    }
+
+    _glfw_free(_glfw.wl.xkb.composeLocale);
+
     if (_glfw.wl.xkb.composeState)
         xkb_compose_state_unref(_glfw.wl.xkb.composeState);
-    if (_glfw.wl.xkb.keymap)
-        xkb_keymap_unref(_glfw.wl.xkb.keymap);
     if (_glfw.wl.xkb.state)
         xkb_state_unref(_glfw.wl.xkb.state);
     if (_glfw.wl.xkb.context)
@@ -929,10 +945,11 @@ void _glfwTerminateWayland(void)
         _glfw.wl.xkb.handle = NULL;
     }
 
-    if (_glfw.wl.cursorTheme)
-        wl_cursor_theme_destroy(_glfw.wl.cursorTheme);
-    if (_glfw.wl.cursorThemeHiDPI)
-        wl_cursor_theme_destroy(_glfw.wl.cursorThemeHiDPI);
+    for (int i = 0;  i < 2;  i++)
+    {
+        if (_glfw.wl.cursorThemes[i])
+            wl_cursor_theme_destroy(_glfw.wl.cursorThemes[i]);
+    }
     if (_glfw.wl.cursor.handle)
     {
         _glfwPlatformFreeModule(_glfw.wl.cursor.handle);
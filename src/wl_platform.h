@@ -25,6 +25,7 @@
 //========================================================================
 
 #include <wayland-client-core.h>
+#include <pthread.h>
 #include <xkbcommon/xkbcommon.h>
 #include <xkbcommon/xkbcommon-compose.h>
 
@@ -330,6 +331,23 @@ typedef struct _GLFWfallbackEdgeWayland
     struct wp_viewport*         viewport;
 } _GLFWfallbackEdgeWayland;
 
+typedef struct _GLFWpixelbufferWayland
+{
+    struct wl_buffer*           buffer;
+    unsigned char*              data;
+    size_t                      size;
+    int                         width, height;
+    GLFWbool                    busy;
+} _GLFWpixelbufferWayland;
+
+// Buffer used once when the whole pool is held by the compositor
+typedef struct _GLFWoverflowbufferWayland
+{
+    struct wl_buffer*           buffer;
+    _GLFWwindow*                window;
+    struct _GLFWoverflowbufferWayland* next;
+} _GLFWoverflowbufferWayland;
+
 typedef struct _GLFWofferWayland
 {
     struct wl_data_offer*       offer;
@@ -357,6 +375,7 @@ typedef struct _GLFWwindowWayland
     GLFWbool                    transparent;
     GLFWbool                    scaleFramebuffer;
     struct wl_surface*          surface;
+    // The pending frame callback, if any
     struct wl_callback*         callback;
 
     struct {
@@ -411,8 +430,33 @@ typedef struct _GLFWwindowWayland
         _GLFWfallbackEdgeWayland    top, left, right, bottom;
         struct wl_surface*          focus;
     } fallback;
+
+    _GLFWpixelbufferWayland         pixelBuffers[3];
+    // One-based index of the pool buffer holding the last frame, or zero
+    int                             lastPixelBuffer;
+    // Overflow buffers not yet released by the compositor
+    _GLFWoverflowbufferWayland*     overflowBuffers;
 } _GLFWwindowWayland;
 
+// Number of compiled XKB keymaps kept for reuse
+//
+#define _GLFW_WL_KEYMAP_CACHE_SIZE 4
+
+// Number of keyboard layouts with cached key names
+//
+#define _GLFW_WL_KEYNAME_LAYOUTS 4
+
+// Compiled XKB keymap and the keymap text it was compiled from
+//
+typedef struct _GLFWkeymapWayland
+{
+    char*                       text;
+    size_t                      size;
+    uint32_t                    hash;
+    uint64_t                    lastUse;
+    struct xkb_keymap*          keymap;
+} _GLFWkeymapWayland;
+
 // Wayland-specific global data
 //
 typedef struct _GLFWlibraryWayland
@@ -448,8 +492,11 @@ typedef struct _GLFWlibraryWayland
 
     const char*                 tag;
 
-    struct wl_cursor_theme*     cursorTheme;
-    struct wl_cursor_theme*     cursorThemeHiDPI;
+    // Cursor themes for scale 1 and 2, loaded on first use
+    struct wl_cursor_theme*     cursorThemes[2];
+    GLFWbool                    cursorThemesLoaded[2];
+    // Theme cursors for each scale and standard shape, looked up on first use
+    struct wl_cursor*           standardCursors[2][_GLFW_STANDARD_CURSOR_COUNT];
     struct wl_surface*          cursorSurface;
     const char*                 cursorPreviousName;
     int                         cursorTimerfd;
@@ -464,7 +511,9 @@ typedef struct _GLFWlibraryWayland
     char*                       clipboardString;
     short int                   keycodes[256];
     short int                   scancodes[GLFW_KEY_LAST + 1];
-    char                        keynames[GLFW_KEY_LAST + 1][5];
+    // UTF-8 key names by layout and scancode, built on first use
+    char                        keynames[_GLFW_WL_KEYNAME_LAYOUTS][256][5];
+    GLFWbool                    keynamesBuilt[_GLFW_WL_KEYNAME_LAYOUTS];
 
     struct {
         void*                   handle;
@@ -473,6 +522,26 @@ typedef struct _GLFWlibraryWayland
         struct xkb_state*       state;
 
         struct xkb_compose_state* composeState;
+        char*                   composeLocale;
+
+        _GLFWkeymapWayland      keymaps[_GLFW_WL_KEYMAP_CACHE_SIZE];
+        uint64_t                keymapUses;
+
+        // Keymap compilation thread, see GLFW_WAYLAND_KEYMAP_THREAD
+        struct {
+            GLFWbool            running;
+            pthread_t           thread;
+            int                 done;
+            char*               text;
+            size_t              size;
+            uint32_t            hash;
+            char*               locale;
+            struct xkb_keymap*  keymap;
+            struct xkb_compose_table* composeTable;
+            char*               pendingText;
+            size_t              pendingSize;
+            uint32_t            pendingHash;
+        } worker;
 
         xkb_mod_index_t         controlIndex;
         xkb_mod_index_t         altIndex;
@@ -481,6 +550,11 @@ typedef struct _GLFWlibraryWayland
         xkb_mod_index_t         capsLockIndex;
         xkb_mod_index_t         numLockIndex;
         unsigned int            modifiers;
+        uint32_t                group;
+        // Last modifier state sent by the compositor, reapplied to new states
+        uint32_t                modsDepressed;
+        uint32_t                modsLatched;
+        uint32_t                modsLocked;
 
         PFN_xkb_context_new context_new;
         PFN_xkb_context_unref context_unref;
@@ -599,8 +673,13 @@ typedef struct _GLFWmonitorWayland
 typedef struct _GLFWcursorWayland
 {
     struct wl_cursor*           cursor;
-    struct wl_cursor*           cursorHiDPI;
+    // The standard cursor shape, or zero for image cursors
+    int                         shape;
     struct wl_buffer*           buffer;
+    // Pre-built frames and their delays in milliseconds, for animated cursors
+    struct wl_buffer**          frames;
+    int*                        delays;
+    int                         frameCount;
     int                         width, height;
     int                         xhot, yhot;
     int                         currentImage;
@@ -636,6 +715,8 @@ GLFWbool _glfwWindowIconifiedWayland(_GLFWwindow* window);
 GLFWbool _glfwWindowVisibleWayland(_GLFWwindow* window);
 GLFWbool _glfwWindowMaximizedWayland(_GLFWwindow* window);
 GLFWbool _glfwWindowHoveredWayland(_GLFWwindow* window);
+GLFWbool _glfwWindowThrottledWayland(_GLFWwindow* window);
+GLFWbool _glfwWindowOccludedWayland(_GLFWwindow* window);
 GLFWbool _glfwFramebufferTransparentWayland(_GLFWwindow* window);
 void _glfwSetWindowResizableWayland(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowDecoratedWayland(_GLFWwindow* window, GLFWbool enabled);
@@ -643,6 +724,8 @@ void _glfwSetWindowFloatingWayland(_GLFWwindow* window, GLFWbool enabled);
 float _glfwGetWindowOpacityWayland(_GLFWwindow* window);
 void _glfwSetWindowOpacityWayland(_GLFWwindow* window, float opacity);
 void _glfwSetWindowMousePassthroughWayland(_GLFWwindow* window, GLFWbool enabled);
+void _glfwSetWindowEventMaskWayland(_GLFWwindow* window, int mask);
+void _glfwPresentPixelsWayland(_GLFWwindow* window, int width, int height, const unsigned char* pixels, int stride, const int* rects, int count);
 
 void _glfwSetRawMouseMotionWayland(_GLFWwindow* window, GLFWbool enabled);
 GLFWbool _glfwRawMouseMotionSupportedWayland(void);
@@ -651,6 +734,7 @@ void _glfwPollEventsWayland(void);
 void _glfwWaitEventsWayland(void);
 void _glfwWaitEventsTimeoutWayland(double timeout);
 void _glfwPostEmptyEventWayland(void);
+void _glfwFlushWayland(void);
 
 void _glfwGetCursorPosWayland(_GLFWwindow* window, double* xpos, double* ypos);
 void _glfwSetCursorPosWayland(_GLFWwindow* window, double xpos, double ypos);
@@ -659,6 +743,7 @@ const char* _glfwGetScancodeNameWayland(int scancode);
 int _glfwGetKeyScancodeWayland(int key);
 GLFWbool _glfwCreateCursorWayland(_GLFWcursor* cursor, const GLFWimage* image, int xhot, int yhot);
 GLFWbool _glfwCreateStandardCursorWayland(_GLFWcursor* cursor, int shape);
+GLFWbool _glfwCreateAnimatedCursorWayland(_GLFWcursor* cursor, const GLFWimage* images, const int* delays, int count, int xhot, int yhot);
 void _glfwDestroyCursorWayland(_GLFWcursor* cursor);
 void _glfwSetCursorWayland(_GLFWwindow* window, _GLFWcursor* cursor);
 void _glfwSetClipboardStringWayland(const char* string);
@@ -686,4 +771,5 @@ void _glfwUpdateBufferScaleFromOutputsWayland(_GLFWwindow* window);
 
 void _glfwAddSeatListenerWayland(struct wl_seat* seat);
 void _glfwAddDataDeviceListenerWayland(struct wl_data_device* device);
+void _glfwRequestFrameWayland(_GLFWwindow* window);
 
@@ -33,6 +33,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <limits.h>
 #include <assert.h>
 #include <unistd.h>
 #include <string.h>
@@ -193,6 +194,115 @@ static struct wl_buffer* createShmBuffer(const GLFWimage* image)
     return buffer;
 }
 
+static void pixelBufferHandleRelease(void* userData, struct wl_buffer* buffer)
+{
+    _GLFWpixelbufferWayland* pixelBuffer = userData;
+    pixelBuffer->busy = GLFW_FALSE;
+}
+
+static const struct wl_buffer_listener pixelBufferListener =
+{
+    pixelBufferHandleRelease
+};
+
+static void destroyOverflowBuffer(_GLFWoverflowbufferWayland* overflow)
+{
+    _GLFWoverflowbufferWayland** prev = &overflow->window->wl.overflowBuffers;
+
+    while (*prev != overflow)
+        prev = &((*prev)->next);
+
+    *prev = overflow->next;
+
+    wl_buffer_destroy(overflow->buffer);
+    _glfw_free(overflow);
+}
+
+static void overflowBufferHandleRelease(void* userData, struct wl_buffer* buffer)
+{
+    // Buffers outside the window pool are only used once
+    destroyOverflowBuffer(userData);
+}
+
+static const struct wl_buffer_listener overflowBufferListener =
+{
+    overflowBufferHandleRelease
+};
+
+static void destroyPixelBuffer(_GLFWpixelbufferWayland* pixelBuffer)
+{
+    if (!pixelBuffer->buffer)
+        return;
+
+    wl_buffer_destroy(pixelBuffer->buffer);
+    munmap(pixelBuffer->data, pixelBuffer->size);
+    memset(pixelBuffer, 0, sizeof(_GLFWpixelbufferWayland));
+}
+
+// Creates a shared memory buffer of the specified size for presenting software
+// pixels and returns its mapping
+//
+static struct wl_buffer* createPixelBuffer(int width, int height,
+                                           unsigned char** data,
+                                           size_t* size)
+{
+    const int stride = width * 4;
+    const size_t length = (size_t) stride * height;
+
+    const int fd = createAnonymousFile(length);
+    if (fd < 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to create buffer file of size %zu: %s",
+                        length, strerror(errno));
+        return NULL;
+    }
+
+    void* mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to map file: %s", strerror(errno));
+        close(fd);
+        return NULL;
+    }
+
+    struct wl_shm_pool* pool = wl_shm_create_pool(_glfw.wl.shm, fd, length);
+
+    close(fd);
+
+    struct wl_buffer* buffer =
+        wl_shm_pool_create_buffer(pool, 0, width, height,
+                                  stride, WL_SHM_FORMAT_XRGB8888);
+    wl_shm_pool_destroy(pool);
+
+    *data = mapping;
+    *size = length;
+    return buffer;
+}
+
+// Copies the specified rectangles of software pixels into a buffer
+//
+static void copyPixels(unsigned char* target,
+                       int width,
+                       const unsigned char* pixels,
+                       int stride,
+                       const int* rects,
+                       int count)
+{
+    for (int i = 0;  i < count;  i++)
+    {
+        const int* rect = rects + i * 4;
+
+        for (int y = rect[1];  y < rect[1] + rect[3];  y++)
+        {
+            memcpy(target + ((size_t) y * width + rect[0]) * 4,
+                   pixels + (size_t) y * stride + rect[0] * 4,
+                   (size_t) rect[2] * 4);
+        }
+    }
+}
+
 static void createFallbackEdge(_GLFWwindow* window,
                                _GLFWfallbackEdgeWayland* edge,
                                struct wl_surface* parent,
@@ -677,6 +787,7 @@ static void xdgSurfaceHandleConfigure(void* userData,
         if (!window->wl.xdg.decoration || window->wl.xdg.decorationMode)
         {
             window->wl.visible = GLFW_TRUE;
+            _glfwInputWindowOcclusion(window, GLFW_FALSE);
             _glfwInputWindowDamage(window);
         }
     }
@@ -756,6 +867,7 @@ void libdecorFrameHandleConfigure(struct libdecor_frame* frame,
     if (!window->wl.visible)
     {
         window->wl.visible = GLFW_TRUE;
+        _glfwInputWindowOcclusion(window, GLFW_FALSE);
         damaged = GLFW_TRUE;
     }
 
@@ -1075,10 +1187,91 @@ static GLFWbool createNativeSurface(_GLFWwindow* window,
     return GLFW_TRUE;
 }
 
+// Returns the cursor theme for the specified scale, loading it on first use
+//
+static struct wl_cursor_theme* getCursorTheme(int scale)
+{
+    const int index = scale > 1 ? 1 : 0;
+
+    if (!_glfw.wl.cursorThemesLoaded[index])
+    {
+        int cursorSize = 16;
+
+        const char* sizeString = getenv("XCURSOR_SIZE");
+        if (sizeString)
+        {
+            errno = 0;
+            const long cursorSizeLong = strtol(sizeString, NULL, 10);
+            if (errno == 0 && cursorSizeLong > 0 && cursorSizeLong < INT_MAX / 2)
+                cursorSize = (int) cursorSizeLong;
+        }
+
+        const char* themeName = getenv("XCURSOR_THEME");
+
+        // We only support up to scale=2 for now, since libwayland-cursor
+        // requires us to load a different theme for each size
+        _GLFW_TRACE_BEGIN("loadCursorTheme");
+        _glfw.wl.cursorThemes[index] =
+            wl_cursor_theme_load(themeName, cursorSize * (index + 1), _glfw.wl.shm);
+        _GLFW_TRACE_END("loadCursorTheme");
+
+        _glfw.wl.cursorThemesLoaded[index] = GLFW_TRUE;
+    }
+
+    return _glfw.wl.cursorThemes[index];
+}
+
+// Returns the theme cursor for the specified standard shape and scale, looking
+// it up on first use
+//
+static struct wl_cursor* getStandardCursor(int shape, int scale)
+{
+    // The XDG name and core X11 name of each standard cursor shape
+    static const char* names[_GLFW_STANDARD_CURSOR_COUNT][2] =
+    {
+        { "default", "left_ptr" },
+        { "text", "xterm" },
+        { "crosshair", "crosshair" },
+        { "pointer", "hand2" },
+        { "ew-resize", "sb_h_double_arrow" },
+        { "ns-resize", "sb_v_double_arrow" },
+        { "nwse-resize", NULL },
+        { "nesw-resize", NULL },
+        { "all-scroll", "fleur" },
+        { "not-allowed", NULL }
+    };
+
+    const int index = shape - GLFW_ARROW_CURSOR;
+    struct wl_cursor** cursor = &_glfw.wl.standardCursors[scale > 1][index];
+
+    if (!*cursor)
+    {
+        struct wl_cursor_theme* theme = getCursorTheme(scale);
+        if (!theme)
+            return NULL;
+
+        *cursor = wl_cursor_theme_get_cursor(theme, names[index][0]);
+        if (!*cursor && names[index][1])
+            *cursor = wl_cursor_theme_get_cursor(theme, names[index][1]);
+    }
+
+    return *cursor;
+}
+
+// Arms the cursor animation timer for the specified delay in milliseconds
+//
+static void setCursorTimer(int delay)
+{
+    struct itimerspec timer = {0};
+
+    timer.it_value.tv_sec = delay / 1000;
+    timer.it_value.tv_nsec = (delay % 1000) * 1000000;
+    timerfd_settime(_glfw.wl.cursorTimerfd, 0, &timer, NULL);
+}
+
 static void setCursorImage(_GLFWwindow* window,
                            _GLFWcursorWayland* cursorWayland)
 {
-    struct itimerspec timer = {0};
     struct wl_cursor* wlCursor = cursorWayland->cursor;
     struct wl_cursor_image* image;
     struct wl_buffer* buffer;
@@ -1086,23 +1279,36 @@ static void setCursorImage(_GLFWwindow* window,
     int scale = 1;
 
     if (!wlCursor)
-        buffer = cursorWayland->buffer;
+    {
+        if (cursorWayland->frameCount)
+        {
+            buffer = cursorWayland->frames[cursorWayland->currentImage];
+            setCursorTimer(cursorWayland->delays[cursorWayland->currentImage]);
+        }
+        else
+            buffer = cursorWayland->buffer;
+    }
     else
     {
-        if (window->wl.bufferScale > 1 && cursorWayland->cursorHiDPI)
+        if (window->wl.bufferScale > 1 && cursorWayland->shape)
         {
-            wlCursor = cursorWayland->cursorHiDPI;
-            scale = 2;
+            // If the shape is missing at scale=2, we just fallback to the
+            // scale=1 version
+            struct wl_cursor* cursorHiDPI =
+                getStandardCursor(cursorWayland->shape, 2);
+            if (cursorHiDPI)
+            {
+                wlCursor = cursorHiDPI;
+                scale = 2;
+            }
         }
 
-        image = wlCursor->images[cursorWayland->currentImage];
+        image = wlCursor->images[cursorWayland->currentImage % wlCursor->image_count];
         buffer = wl_cursor_image_get_buffer(image);
         if (!buffer)
             return;
 
-        timer.it_value.tv_sec = image->delay / 1000;
-        timer.it_value.tv_nsec = (image->delay % 1000) * 1000000;
-        timerfd_settime(_glfw.wl.cursorTimerfd, 0, &timer, NULL);
+        setCursorTimer(image->delay);
 
         cursorWayland->width = image->width;
         cursorWayland->height = image->height;
@@ -1128,6 +1334,12 @@ static void incrementCursorImage(_GLFWwindow* window)
     if (!window || !window->wl.hovered)
         return;
 
+    if (window->cursorMode != GLFW_CURSOR_NORMAL &&
+        window->cursorMode != GLFW_CURSOR_CAPTURED)
+    {
+        return;
+    }
+
     cursor = window->wl.currentCursor;
     if (cursor && cursor->wl.cursor)
     {
@@ -1135,6 +1347,20 @@ static void incrementCursorImage(_GLFWwindow* window)
         cursor->wl.currentImage %= cursor->wl.cursor->image_count;
         setCursorImage(window, &cursor->wl);
     }
+    else if (cursor && cursor->wl.frameCount)
+    {
+        struct wl_surface* surface = _glfw.wl.cursorSurface;
+
+        cursor->wl.currentImage += 1;
+        cursor->wl.currentImage %= cursor->wl.frameCount;
+        setCursorTimer(cursor->wl.delays[cursor->wl.currentImage]);
+
+        // The cursor surface already has its role and hotspot, so only the
+        // pre-built buffer of the next frame needs to be attached
+        wl_surface_attach(surface, cursor->wl.frames[cursor->wl.currentImage], 0, 0);
+        wl_surface_damage(surface, 0, 0, cursor->wl.width, cursor->wl.height);
+        wl_surface_commit(surface);
+    }
 }
 
 static GLFWbool flushDisplay(void)
@@ -1202,6 +1428,384 @@ static void inputText(_GLFWwindow* window, uint32_t scancode)
     }
 }
 
+// Returns the preferred locale for compose sequences, falling back to "C"
+//
+static const char* getComposeLocale(void)
+{
+    const char* locale = getenv("LC_ALL");
+    if (!locale)
+        locale = getenv("LC_CTYPE");
+    if (!locale)
+        locale = getenv("LANG");
+    if (!locale)
+        locale = "C";
+
+    return locale;
+}
+
+// Returns whether the compose table for the specified locale needs compiling
+//
+static GLFWbool needsComposeTable(const char* locale)
+{
+    return !_glfw.wl.xkb.composeLocale ||
+           strcmp(_glfw.wl.xkb.composeLocale, locale) != 0;
+}
+
+// Replaces the compose state with one for the specified compose table
+// This takes ownership of the compose table reference
+//
+static void setComposeTable(const char* locale, struct xkb_compose_table* table)
+{
+    struct xkb_compose_state* state = NULL;
+
+    if (table)
+    {
+        state = xkb_compose_state_new(table, XKB_COMPOSE_STATE_NO_FLAGS);
+        xkb_compose_table_unref(table);
+        if (!state)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Failed to create XKB compose state");
+        }
+    }
+    else
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to create XKB compose table");
+    }
+
+    if (_glfw.wl.xkb.composeState)
+        xkb_compose_state_unref(_glfw.wl.xkb.composeState);
+
+    _glfw.wl.xkb.composeState = state;
+
+    // Remember the locale even on failure so the table is not recompiled for
+    // every keymap the compositor sends
+    _glfw_free(_glfw.wl.xkb.composeLocale);
+    _glfw.wl.xkb.composeLocale = _glfw_strdup(locale);
+}
+
+// Applies the last modifier state sent by the compositor to the keyboard state
+// and updates the GLFW modifier bits from it
+//
+static void updateModifiers(void)
+{
+    xkb_state_update_mask(_glfw.wl.xkb.state,
+                          _glfw.wl.xkb.modsDepressed,
+                          _glfw.wl.xkb.modsLatched,
+                          _glfw.wl.xkb.modsLocked,
+                          0,
+                          0,
+                          _glfw.wl.xkb.group);
+
+    _glfw.wl.xkb.modifiers = 0;
+
+    struct
+    {
+        xkb_mod_index_t index;
+        unsigned int bit;
+    } modifiers[] =
+    {
+        { _glfw.wl.xkb.controlIndex,  GLFW_MOD_CONTROL },
+        { _glfw.wl.xkb.altIndex,      GLFW_MOD_ALT },
+        { _glfw.wl.xkb.shiftIndex,    GLFW_MOD_SHIFT },
+        { _glfw.wl.xkb.superIndex,    GLFW_MOD_SUPER },
+        { _glfw.wl.xkb.capsLockIndex, GLFW_MOD_CAPS_LOCK },
+        { _glfw.wl.xkb.numLockIndex,  GLFW_MOD_NUM_LOCK }
+    };
+
+    for (size_t i = 0; i < sizeof(modifiers) / sizeof(modifiers[0]); i++)
+    {
+        if (xkb_state_mod_index_is_active(_glfw.wl.xkb.state,
+                                          modifiers[i].index,
+                                          XKB_STATE_MODS_EFFECTIVE) == 1)
+        {
+            _glfw.wl.xkb.modifiers |= modifiers[i].bit;
+        }
+    }
+}
+
+// Makes the specified keymap current with a new keyboard state
+//
+static void setKeymap(struct xkb_keymap* keymap)
+{
+    struct xkb_state* state = xkb_state_new(keymap);
+    if (!state)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to create XKB state");
+        return;
+    }
+
+    xkb_state_unref(_glfw.wl.xkb.state);
+    _glfw.wl.xkb.keymap = keymap;
+    _glfw.wl.xkb.state = state;
+
+    // The key names are rebuilt on demand for the new keymap
+    memset(_glfw.wl.keynamesBuilt, 0, sizeof(_glfw.wl.keynamesBuilt));
+
+    _glfw.wl.xkb.controlIndex  = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Control");
+    _glfw.wl.xkb.altIndex      = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Mod1");
+    _glfw.wl.xkb.shiftIndex    = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Shift");
+    _glfw.wl.xkb.superIndex    = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Mod4");
+    _glfw.wl.xkb.capsLockIndex = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Lock");
+    _glfw.wl.xkb.numLockIndex  = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Mod2");
+
+    // Keep locked modifiers and the active layout across the keymap change,
+    // including any modifier events that arrived while it was being compiled
+    updateModifiers();
+}
+
+// Returns the FNV-1a hash of the specified keymap text
+//
+static uint32_t hashKeymapText(const char* text, size_t size)
+{
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0;  i < size;  i++)
+    {
+        hash ^= (unsigned char) text[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+// Returns the cached keymap compiled from the specified text, if any
+//
+static struct xkb_keymap* findCachedKeymap(const char* text, size_t size, uint32_t hash)
+{
+    for (int i = 0;  i < _GLFW_WL_KEYMAP_CACHE_SIZE;  i++)
+    {
+        _GLFWkeymapWayland* entry = _glfw.wl.xkb.keymaps + i;
+
+        if (entry->keymap &&
+            entry->hash == hash &&
+            entry->size == size &&
+            memcmp(entry->text, text, size) == 0)
+        {
+            entry->lastUse = ++_glfw.wl.xkb.keymapUses;
+            return entry->keymap;
+        }
+    }
+
+    return NULL;
+}
+
+// Adds a compiled keymap to the cache, evicting the least recently used keymap
+// other than the current one
+// This takes ownership of the text and the keymap reference
+//
+static void cacheKeymap(char* text, size_t size, uint32_t hash,
+                        struct xkb_keymap* keymap)
+{
+    _GLFWkeymapWayland* entry = NULL;
+
+    for (int i = 0;  i < _GLFW_WL_KEYMAP_CACHE_SIZE;  i++)
+    {
+        _GLFWkeymapWayland* candidate = _glfw.wl.xkb.keymaps + i;
+
+        if (candidate->keymap && candidate->keymap == _glfw.wl.xkb.keymap)
+            continue;
+
+        if (!entry || candidate->lastUse < entry->lastUse)
+            entry = candidate;
+    }
+
+    if (entry->keymap)
+        xkb_keymap_unref(entry->keymap);
+
+    _glfw_free(entry->text);
+
+    entry->text = text;
+    entry->size = size;
+    entry->hash = hash;
+    entry->keymap = keymap;
+    entry->lastUse = ++_glfw.wl.xkb.keymapUses;
+}
+
+// Entry point of the keymap compilation thread
+//
+// The thread compiles with its own XKB context, as contexts may not be used
+// from several threads at once
+//
+static void* keymapThreadMain(void* arg)
+{
+    struct xkb_context* context = xkb_context_new(0);
+    if (context)
+    {
+        _glfw.wl.xkb.worker.keymap =
+            xkb_keymap_new_from_string(context,
+                                       _glfw.wl.xkb.worker.text,
+                                       XKB_KEYMAP_FORMAT_TEXT_V1,
+                                       0);
+
+        if (_glfw.wl.xkb.worker.locale)
+        {
+            _glfw.wl.xkb.worker.composeTable =
+                xkb_compose_table_new_from_locale(context,
+                                                  _glfw.wl.xkb.worker.locale,
+                                                  XKB_COMPOSE_COMPILE_NO_FLAGS);
+        }
+
+        xkb_context_unref(context);
+    }
+
+    const uint64_t value = 1;
+    while (write(_glfw.wl.xkb.worker.done, &value, sizeof(value)) < 0 && errno == EINTR)
+        ;
+
+    return NULL;
+}
+
+// Starts compiling the specified keymap text on the keymap compilation thread
+// This takes ownership of the text if successful
+//
+static GLFWbool startKeymapThread(char* text, size_t size, uint32_t hash)
+{
+    const char* locale = getComposeLocale();
+
+    _glfw.wl.xkb.worker.text = text;
+    _glfw.wl.xkb.worker.size = size;
+    _glfw.wl.xkb.worker.hash = hash;
+    _glfw.wl.xkb.worker.keymap = NULL;
+    _glfw.wl.xkb.worker.composeTable = NULL;
+    _glfw.wl.xkb.worker.locale = NULL;
+
+    if (needsComposeTable(locale))
+        _glfw.wl.xkb.worker.locale = _glfw_strdup(locale);
+
+    if (pthread_create(&_glfw.wl.xkb.worker.thread, NULL, keymapThreadMain, NULL) != 0)
+    {
+        _glfw_free(_glfw.wl.xkb.worker.locale);
+        _glfw.wl.xkb.worker.locale = NULL;
+        _glfw.wl.xkb.worker.text = NULL;
+        return GLFW_FALSE;
+    }
+
+    _glfw.wl.xkb.worker.running = GLFW_TRUE;
+    return GLFW_TRUE;
+}
+
+// Makes the keymap with the specified text current, compiling it if it is not
+// already cached
+// This takes ownership of the text
+//
+static void updateKeymap(char* text, size_t size, uint32_t hash)
+{
+    if (_glfw.wl.xkb.worker.running)
+    {
+        // Only the latest keymap matters once the current compilation is done
+        _glfw_free(_glfw.wl.xkb.worker.pendingText);
+        _glfw.wl.xkb.worker.pendingText = text;
+        _glfw.wl.xkb.worker.pendingSize = size;
+        _glfw.wl.xkb.worker.pendingHash = hash;
+        return;
+    }
+
+    struct xkb_keymap* keymap = findCachedKeymap(text, size, hash);
+    if (keymap)
+    {
+        _glfw_free(text);
+        setKeymap(keymap);
+        return;
+    }
+
+    if (_glfw.wl.xkb.worker.done >= 0)
+    {
+        if (startKeymapThread(text, size, hash))
+            return;
+    }
+
+    const char* locale = getComposeLocale();
+    if (needsComposeTable(locale))
+    {
+        setComposeTable(locale,
+                        xkb_compose_table_new_from_locale(_glfw.wl.xkb.context,
+                                                          locale,
+                                                          XKB_COMPOSE_COMPILE_NO_FLAGS));
+    }
+
+    keymap = xkb_keymap_new_from_string(_glfw.wl.xkb.context,
+                                        text,
+                                        XKB_KEYMAP_FORMAT_TEXT_V1,
+                                        0);
+    if (!keymap)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to compile keymap");
+        _glfw_free(text);
+        return;
+    }
+
+    cacheKeymap(text, size, hash, keymap);
+    setKeymap(keymap);
+}
+
+// Makes the keymap compiled by the keymap compilation thread current
+//
+static void finishKeymapThread(void)
+{
+    uint64_t value;
+    while (read(_glfw.wl.xkb.worker.done, &value, sizeof(value)) == sizeof(value))
+        ;
+
+    if (!_glfw.wl.xkb.worker.running)
+        return;
+
+    pthread_join(_glfw.wl.xkb.worker.thread, NULL);
+    _glfw.wl.xkb.worker.running = GLFW_FALSE;
+
+    if (_glfw.wl.xkb.worker.locale)
+    {
+        setComposeTable(_glfw.wl.xkb.worker.locale, _glfw.wl.xkb.worker.composeTable);
+        _glfw_free(_glfw.wl.xkb.worker.locale);
+        _glfw.wl.xkb.worker.locale = NULL;
+    }
+
+    if (_glfw.wl.xkb.worker.keymap)
+    {
+        cacheKeymap(_glfw.wl.xkb.worker.text,
+                    _glfw.wl.xkb.worker.size,
+                    _glfw.wl.xkb.worker.hash,
+                    _glfw.wl.xkb.worker.keymap);
+        setKeymap(_glfw.wl.xkb.worker.keymap);
+    }
+    else
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to compile keymap");
+        _glfw_free(_glfw.wl.xkb.worker.text);
+    }
+
+    _glfw.wl.xkb.worker.text = NULL;
+    _glfw.wl.xkb.worker.keymap = NULL;
+    _glfw.wl.xkb.worker.composeTable = NULL;
+
+    if (_glfw.wl.xkb.worker.pendingText)
+    {
+        char* text = _glfw.wl.xkb.worker.pendingText;
+        _glfw.wl.xkb.worker.pendingText = NULL;
+        updateKeymap(text,
+                     _glfw.wl.xkb.worker.pendingSize,
+                     _glfw.wl.xkb.worker.pendingHash);
+    }
+}
+
+// Dispatches the Wayland events already read from the display
+//
+static int dispatchPendingEvents(void)
+{
+    _GLFW_TRACE_BEGIN("dispatchEvents");
+    const int count = wl_display_dispatch_pending(_glfw.wl.display);
+    _GLFW_TRACE_END("dispatchEvents");
+
+    if (count > 0)
+        _glfw.eventCount += count;
+
+    return count;
+}
+
 static void handleEvents(double* timeout)
 {
 #if defined(GLFW_BUILD_LINUX_JOYSTICK)
@@ -1210,13 +1814,14 @@ static void handleEvents(double* timeout)
 #endif
 
     GLFWbool event = GLFW_FALSE;
-    enum { DISPLAY_FD, KEYREPEAT_FD, CURSOR_FD, LIBDECOR_FD };
+    enum { DISPLAY_FD, KEYREPEAT_FD, CURSOR_FD, LIBDECOR_FD, KEYMAP_FD };
     struct pollfd fds[] =
     {
         [DISPLAY_FD] = { wl_display_get_fd(_glfw.wl.display), POLLIN },
         [KEYREPEAT_FD] = { _glfw.wl.keyRepeatTimerfd, POLLIN },
         [CURSOR_FD] = { _glfw.wl.cursorTimerfd, POLLIN },
-        [LIBDECOR_FD] = { -1, POLLIN }
+        [LIBDECOR_FD] = { -1, POLLIN },
+        [KEYMAP_FD] = { _glfw.wl.xkb.worker.done, POLLIN }
     };
 
     if (_glfw.wl.libdecor.context)
@@ -1226,7 +1831,7 @@ static void handleEvents(double* timeout)
     {
         while (wl_display_prepare_read(_glfw.wl.display) != 0)
         {
-            if (wl_display_dispatch_pending(_glfw.wl.display) > 0)
+            if (dispatchPendingEvents() > 0)
                 return;
         }
 
@@ -1255,7 +1860,7 @@ static void handleEvents(double* timeout)
         if (fds[DISPLAY_FD].revents & POLLIN)
         {
             wl_display_read_events(_glfw.wl.display);
-            if (wl_display_dispatch_pending(_glfw.wl.display) > 0)
+            if (dispatchPendingEvents() > 0)
                 event = GLFW_TRUE;
         }
         else
@@ -1277,6 +1882,7 @@ static void handleEvents(double* timeout)
                     inputText(_glfw.wl.keyboardFocus, _glfw.wl.keyRepeatScancode);
                 }
 
+                _glfw.eventCount++;
                 event = GLFW_TRUE;
             }
         }
@@ -1292,8 +1898,14 @@ static void handleEvents(double* timeout)
         if (fds[LIBDECOR_FD].revents & POLLIN)
         {
             if (libdecor_dispatch(_glfw.wl.libdecor.context, 0) > 0)
+            {
+                _glfw.eventCount++;
                 event = GLFW_TRUE;
+            }
         }
+
+        if (fds[KEYMAP_FD].revents & POLLIN)
+            finishKeymapThread();
     }
 }
 
@@ -1385,7 +1997,9 @@ static void pointerHandleEnter(void* userData,
     {
         window->wl.hovered = GLFW_TRUE;
         _glfwSetCursorWayland(window, window->wl.currentCursor);
-        _glfwInputCursorEnter(window, GLFW_TRUE);
+
+        if (window->activeEventMask & GLFW_EVENT_MASK_CURSOR_ENTER)
+            _glfwInputCursorEnter(window, GLFW_TRUE);
     }
     else
     {
@@ -1416,7 +2030,9 @@ static void pointerHandleLeave(void* userData,
     if (window->wl.hovered)
     {
         window->wl.hovered = GLFW_FALSE;
-        _glfwInputCursorEnter(window, GLFW_FALSE);
+
+        if (window->activeEventMask & GLFW_EVENT_MASK_CURSOR_ENTER)
+            _glfwInputCursorEnter(window, GLFW_FALSE);
     }
     else
     {
@@ -1446,7 +2062,10 @@ static void pointerHandleMotion(void* userData,
     if (window->wl.hovered)
     {
         _glfw.wl.cursorPreviousName = NULL;
-        _glfwInputCursorPos(window, xpos, ypos);
+
+        if (window->activeEventMask & GLFW_EVENT_MASK_CURSOR_POS)
+            _glfwInputCursorPos(window, xpos, ypos);
+
         return;
     }
 
@@ -1489,17 +2108,21 @@ static void pointerHandleMotion(void* userData,
         if (_glfw.wl.cursorPreviousName != cursorName)
         {
             struct wl_surface* surface = _glfw.wl.cursorSurface;
-            struct wl_cursor_theme* theme = _glfw.wl.cursorTheme;
+            struct wl_cursor_theme* theme = NULL;
             int scale = 1;
 
-            if (window->wl.bufferScale > 1 && _glfw.wl.cursorThemeHiDPI)
+            if (window->wl.bufferScale > 1)
             {
-                // We only support up to scale=2 for now, since libwayland-cursor
-                // requires us to load a different theme for each size.
-                scale = 2;
-                theme = _glfw.wl.cursorThemeHiDPI;
+                theme = getCursorTheme(2);
+                if (theme)
+                    scale = 2;
             }
 
+            if (!theme)
+                theme = getCursorTheme(1);
+            if (!theme)
+                return;
+
             struct wl_cursor* cursor = wl_cursor_theme_get_cursor(theme, cursorName);
             if (!cursor)
                 return;
@@ -1542,6 +2165,9 @@ static void pointerHandleButton(void* userData,
     {
         _glfw.wl.serial = serial;
 
+        if (!(window->activeEventMask & GLFW_EVENT_MASK_MOUSE_BUTTON))
+            return;
+
         _glfwInputMouseClick(window,
                              button - BTN_LEFT,
                              state == WL_POINTER_BUTTON_STATE_PRESSED,
@@ -1615,6 +2241,9 @@ static void pointerHandleAxis(void* userData,
     if (!window)
         return;
 
+    if (!(window->activeEventMask & GLFW_EVENT_MASK_MOUSE_BUTTON))
+        return;
+
     // NOTE: 10 units of motion per mouse wheel step seems to be a common ratio
     if (axis == WL_POINTER_AXIS_HORIZONTAL_SCROLL)
         _glfwInputScroll(window, -wl_fixed_to_double(value) / 10.0, 0.0);
@@ -1637,13 +2266,7 @@ static void keyboardHandleKeymap(void* userData,
                                  int fd,
                                  uint32_t size)
 {
-    struct xkb_keymap* keymap;
-    struct xkb_state* state;
-    struct xkb_compose_table* composeTable;
-    struct xkb_compose_state* composeState;
-
     char* mapStr;
-    const char* locale;
 
     if (format != WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1)
     {
@@ -1657,69 +2280,19 @@ static void keyboardHandleKeymap(void* userData,
         return;
     }
 
-    keymap = xkb_keymap_new_from_string(_glfw.wl.xkb.context,
-                                        mapStr,
-                                        XKB_KEYMAP_FORMAT_TEXT_V1,
-                                        0);
+    // Keep a terminated copy of the keymap text to recognize it when it is
+    // sent again
+    char* text = _glfw_calloc(size + 1, 1);
+    if (text)
+        memcpy(text, mapStr, size);
+
     munmap(mapStr, size);
     close(fd);
 
-    if (!keymap)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Failed to compile keymap");
-        return;
-    }
-
-    state = xkb_state_new(keymap);
-    if (!state)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Failed to create XKB state");
-        xkb_keymap_unref(keymap);
+    if (!text)
         return;
-    }
-
-    // Look up the preferred locale, falling back to "C" as default.
-    locale = getenv("LC_ALL");
-    if (!locale)
-        locale = getenv("LC_CTYPE");
-    if (!locale)
-        locale = getenv("LANG");
-    if (!locale)
-        locale = "C";
-
-    composeTable =
-        xkb_compose_table_new_from_locale(_glfw.wl.xkb.context, locale,
-                                          XKB_COMPOSE_COMPILE_NO_FLAGS);
-    if (composeTable)
-    {
-        composeState =
-            xkb_compose_state_new(composeTable, XKB_COMPOSE_STATE_NO_FLAGS);
-        xkb_compose_table_unref(composeTable);
-        if (composeState)
-            _glfw.wl.xkb.composeState = composeState;
-        else
-            _glfwInputError(GLFW_PLATFORM_ERROR,
-                            "Wayland: Failed to create XKB compose state");
-    }
-    else
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Failed to create XKB compose table");
-    }
-
-    xkb_keymap_unref(_glfw.wl.xkb.keymap);
-    xkb_state_unref(_glfw.wl.xkb.state);
-    _glfw.wl.xkb.keymap = keymap;
-    _glfw.wl.xkb.state = state;
 
-    _glfw.wl.xkb.controlIndex  = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Control");
-    _glfw.wl.xkb.altIndex      = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Mod1");
-    _glfw.wl.xkb.shiftIndex    = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Shift");
-    _glfw.wl.xkb.superIndex    = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Mod4");
-    _glfw.wl.xkb.capsLockIndex = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Lock");
-    _glfw.wl.xkb.numLockIndex  = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Mod2");
+    updateKeymap(text, size, hashKeymapText(text, size));
 }
 
 static void keyboardHandleEnter(void* userData,
@@ -1781,6 +2354,13 @@ static void keyboardHandleKey(void* userData,
 
     struct itimerspec timer = {0};
 
+    if (!(window->activeEventMask & GLFW_EVENT_MASK_KEY))
+    {
+        // Make sure no key is left repeating if the mask changed mid-press
+        timerfd_settime(_glfw.wl.keyRepeatTimerfd, 0, &timer, NULL);
+        return;
+    }
+
     if (action == GLFW_PRESS)
     {
         const xkb_keycode_t keycode = scancode + 8;
@@ -1817,42 +2397,16 @@ static void keyboardHandleModifiers(void* userData,
 {
     _glfw.wl.serial = serial;
 
+    // Store the state even without a keymap, as one may still be compiling
+    _glfw.wl.xkb.modsDepressed = modsDepressed;
+    _glfw.wl.xkb.modsLatched = modsLatched;
+    _glfw.wl.xkb.modsLocked = modsLocked;
+    _glfw.wl.xkb.group = group;
+
     if (!_glfw.wl.xkb.keymap)
         return;
 
-    xkb_state_update_mask(_glfw.wl.xkb.state,
-                          modsDepressed,
-                          modsLatched,
-                          modsLocked,
-                          0,
-                          0,
-                          group);
-
-    _glfw.wl.xkb.modifiers = 0;
-
-    struct
-    {
-        xkb_mod_index_t index;
-        unsigned int bit;
-    } modifiers[] =
-    {
-        { _glfw.wl.xkb.controlIndex,  GLFW_MOD_CONTROL },
-        { _glfw.wl.xkb.altIndex,      GLFW_MOD_ALT },
-        { _glfw.wl.xkb.shiftIndex,    GLFW_MOD_SHIFT },
-        { _glfw.wl.xkb.superIndex,    GLFW_MOD_SUPER },
-        { _glfw.wl.xkb.capsLockIndex, GLFW_MOD_CAPS_LOCK },
-        { _glfw.wl.xkb.numLockIndex,  GLFW_MOD_NUM_LOCK }
-    };
-
-    for (size_t i = 0; i < sizeof(modifiers) / sizeof(modifiers[0]); i++)
-    {
-        if (xkb_state_mod_index_is_active(_glfw.wl.xkb.state,
-                                          modifiers[i].index,
-                                          XKB_STATE_MODS_EFFECTIVE) == 1)
-        {
-            _glfw.wl.xkb.modifiers |= modifiers[i].bit;
-        }
-    }
+    updateModifiers();
 }
 
 static void keyboardHandleRepeatInfo(void* userData,
@@ -2120,6 +2674,72 @@ void _glfwAddDataDeviceListenerWayland(struct wl_data_device* device)
     wl_data_device_add_listener(device, &dataDeviceListener, NULL);
 }
 
+static void frameHandleDone(void* userData,
+                            struct wl_callback* callback,
+                            uint32_t time)
+{
+    _GLFWwindow* window = userData;
+
+    wl_callback_destroy(callback);
+    window->wl.callback = NULL;
+}
+
+static const struct wl_callback_listener frameListener =
+{
+    frameHandleDone
+};
+
+// Asks the compositor to tell us when it is a good time to draw the frame after
+// the one about to be committed
+//
+void _glfwRequestFrameWayland(_GLFWwindow* window)
+{
+    // The pending callback also covers any frames drawn before it is done
+    if (window->wl.callback)
+        return;
+
+    window->wl.callback = wl_surface_frame(window->wl.surface);
+    wl_callback_add_listener(window->wl.callback, &frameListener, window);
+}
+
+
+// Encodes the names of all keys in the current layout group
+//
+static void buildKeyNames(uint32_t group)
+{
+    memset(_glfw.wl.keynames[group], 0, sizeof(_glfw.wl.keynames[group]));
+
+    for (int scancode = 0;  scancode < 256;  scancode++)
+    {
+        if (_glfw.wl.keycodes[scancode] == GLFW_KEY_UNKNOWN)
+            continue;
+
+        // Keys with fewer layouts than the keymap wrap the group differently
+        const xkb_keycode_t keycode = scancode + 8;
+        const xkb_layout_index_t layout =
+            xkb_state_key_get_layout(_glfw.wl.xkb.state, keycode);
+        if (layout == XKB_LAYOUT_INVALID)
+            continue;
+
+        const xkb_keysym_t* keysyms = NULL;
+        xkb_keymap_key_get_syms_by_level(_glfw.wl.xkb.keymap,
+                                         keycode,
+                                         layout,
+                                         0,
+                                         &keysyms);
+        if (keysyms == NULL)
+            continue;
+
+        const uint32_t codepoint = _glfwKeySym2Unicode(keysyms[0]);
+        if (codepoint == GLFW_INVALID_CODEPOINT)
+            continue;
+
+        char* name = _glfw.wl.keynames[group][scancode];
+        name[_glfwEncodeUTF8(name, codepoint)] = '\0';
+    }
+
+    _glfw.wl.keynamesBuilt[group] = GLFW_TRUE;
+}
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -2130,7 +2750,10 @@ GLFWbool _glfwCreateWindowWayland(_GLFWwindow* window,
                                   const _GLFWctxconfig* ctxconfig,
                                   const _GLFWfbconfig* fbconfig)
 {
-    if (!createNativeSurface(window, wndconfig, fbconfig))
+    _GLFW_TRACE_BEGIN("createNativeWindow");
+    const GLFWbool created = createNativeSurface(window, wndconfig, fbconfig);
+    _GLFW_TRACE_END("createNativeWindow");
+    if (!created)
         return GLFW_FALSE;
 
     if (ctxconfig->client != GLFW_NO_API)
@@ -2206,6 +2829,9 @@ void _glfwDestroyWindowWayland(_GLFWwindow* window)
     if (window->wl.confinedPointer)
         zwp_confined_pointer_v1_destroy(window->wl.confinedPointer);
 
+    if (window->wl.callback)
+        wl_callback_destroy(window->wl.callback);
+
     if (window->context.destroy)
         window->context.destroy(window);
 
@@ -2214,6 +2840,12 @@ void _glfwDestroyWindowWayland(_GLFWwindow* window)
     if (window->wl.fallback.buffer)
         wl_buffer_destroy(window->wl.fallback.buffer);
 
+    for (int i = 0;  i < 3;  i++)
+        destroyPixelBuffer(window->wl.pixelBuffers + i);
+
+    while (window->wl.overflowBuffers)
+        destroyOverflowBuffer(window->wl.overflowBuffers);
+
     if (window->wl.egl.window)
         wl_egl_window_destroy(window->wl.egl.window);
 
@@ -2444,6 +3076,14 @@ void _glfwHideWindowWayland(_GLFWwindow* window)
     {
         window->wl.visible = GLFW_FALSE;
         destroyShellObjects(window);
+        _glfwInputWindowOcclusion(window, GLFW_TRUE);
+
+        // The compositor will not call back for a surface that is not shown
+        if (window->wl.callback)
+        {
+            wl_callback_destroy(window->wl.callback);
+            window->wl.callback = NULL;
+        }
 
         wl_surface_attach(window->wl.surface, NULL, 0, 0);
         wl_surface_commit(window->wl.surface);
@@ -2554,6 +3194,17 @@ GLFWbool _glfwWindowHoveredWayland(_GLFWwindow* window)
     return window->wl.hovered;
 }
 
+GLFWbool _glfwWindowThrottledWayland(_GLFWwindow* window)
+{
+    return !window->wl.visible || window->wl.callback;
+}
+
+GLFWbool _glfwWindowOccludedWayland(_GLFWwindow* window)
+{
+    // The core protocols do not tell clients whether their surfaces are seen
+    return !window->wl.visible;
+}
+
 GLFWbool _glfwFramebufferTransparentWayland(_GLFWwindow* window)
 {
     return window->wl.transparent;
@@ -2622,6 +3273,122 @@ void _glfwSetWindowMousePassthroughWayland(_GLFWwindow* window, GLFWbool enabled
         wl_surface_set_input_region(window->wl.surface, NULL);
 }
 
+void _glfwSetWindowEventMaskWayland(_GLFWwindow* window, int mask)
+{
+    // The seat listeners check the active event mask of the focused window
+}
+
+void _glfwPresentPixelsWayland(_GLFWwindow* window,
+                               int width, int height,
+                               const unsigned char* pixels,
+                               int stride,
+                               const int* rects,
+                               int count)
+{
+    const int whole[4] = { 0, 0, width, height };
+    const int last = window->wl.lastPixelBuffer - 1;
+    _GLFWpixelbufferWayland* pixelBuffer = NULL;
+    struct wl_buffer* buffer;
+
+    // Prefer the buffer holding the last frame if the compositor is done with
+    // it, otherwise any free buffer in the pool
+    if (last >= 0 && !window->wl.pixelBuffers[last].busy)
+        pixelBuffer = window->wl.pixelBuffers + last;
+    else
+    {
+        for (int i = 0;  i < 3;  i++)
+        {
+            if (!window->wl.pixelBuffers[i].busy)
+            {
+                pixelBuffer = window->wl.pixelBuffers + i;
+                break;
+            }
+        }
+    }
+
+    if (pixelBuffer)
+    {
+        if (pixelBuffer->buffer &&
+            (pixelBuffer->width != width || pixelBuffer->height != height))
+        {
+            destroyPixelBuffer(pixelBuffer);
+        }
+
+        if (!pixelBuffer->buffer)
+        {
+            pixelBuffer->buffer = createPixelBuffer(width, height,
+                                                    &pixelBuffer->data,
+                                                    &pixelBuffer->size);
+            if (!pixelBuffer->buffer)
+                return;
+
+            pixelBuffer->width = width;
+            pixelBuffer->height = height;
+            wl_buffer_add_listener(pixelBuffer->buffer,
+                                   &pixelBufferListener,
+                                   pixelBuffer);
+        }
+
+        if (pixelBuffer == window->wl.pixelBuffers + last)
+            copyPixels(pixelBuffer->data, width, pixels, stride, rects, count);
+        else
+            copyPixels(pixelBuffer->data, width, pixels, stride, whole, 1);
+
+        pixelBuffer->busy = GLFW_TRUE;
+        buffer = pixelBuffer->buffer;
+        window->wl.lastPixelBuffer = (int) (pixelBuffer - window->wl.pixelBuffers) + 1;
+    }
+    else
+    {
+        // The compositor is holding on to every buffer in the pool, so use one
+        // that is destroyed as soon as it is released
+        unsigned char* data;
+        size_t size;
+
+        _GLFWoverflowbufferWayland* overflow =
+            _glfw_calloc(1, sizeof(_GLFWoverflowbufferWayland));
+        if (!overflow)
+            return;
+
+        buffer = createPixelBuffer(width, height, &data, &size);
+        if (!buffer)
+        {
+            _glfw_free(overflow);
+            return;
+        }
+
+        copyPixels(data, width, pixels, stride, whole, 1);
+        munmap(data, size);
+
+        overflow->buffer = buffer;
+        overflow->window = window;
+        overflow->next = window->wl.overflowBuffers;
+        window->wl.overflowBuffers = overflow;
+
+        wl_buffer_add_listener(buffer, &overflowBufferListener, overflow);
+        window->wl.lastPixelBuffer = 0;
+    }
+
+    _glfwRequestFrameWayland(window);
+    wl_surface_attach(window->wl.surface, buffer, 0, 0);
+
+    if (wl_surface_get_version(window->wl.surface) >=
+        WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION)
+    {
+        for (int i = 0;  i < count;  i++)
+        {
+            const int* rect = rects + i * 4;
+            wl_surface_damage_buffer(window->wl.surface,
+                                     rect[0], rect[1], rect[2], rect[3]);
+        }
+    }
+    else
+        wl_surface_damage(window->wl.surface, 0, 0, INT32_MAX, INT32_MAX);
+
+    wl_surface_commit(window->wl.surface);
+    wl_display_flush(_glfw.wl.display);
+}
+
 float _glfwGetWindowOpacityWayland(_GLFWwindow* window)
 {
     return 1.f;
@@ -2665,6 +3432,11 @@ void _glfwPostEmptyEventWayland(void)
     flushDisplay();
 }
 
+void _glfwFlushWayland(void)
+{
+    flushDisplay();
+}
+
 void _glfwGetCursorPosWayland(_GLFWwindow* window, double* xpos, double* ypos)
 {
     if (xpos)
@@ -2694,51 +3466,21 @@ const char* _glfwGetScancodeNameWayland(int scancode)
         return NULL;
     }
 
-    const int key = _glfw.wl.keycodes[scancode];
-    if (key == GLFW_KEY_UNKNOWN)
-        return NULL;
-
-    const xkb_keycode_t keycode = scancode + 8;
-    const xkb_layout_index_t layout =
-        xkb_state_key_get_layout(_glfw.wl.xkb.state, keycode);
-    if (layout == XKB_LAYOUT_INVALID)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Failed to retrieve layout for key name");
+    if (!_glfw.wl.xkb.keymap)
         return NULL;
-    }
 
-    const xkb_keysym_t* keysyms = NULL;
-    xkb_keymap_key_get_syms_by_level(_glfw.wl.xkb.keymap,
-                                     keycode,
-                                     layout,
-                                     0,
-                                     &keysyms);
-    if (keysyms == NULL)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Failed to retrieve keysym for key name");
+    const uint32_t group = _glfw.wl.xkb.group;
+    if (group >= _GLFW_WL_KEYNAME_LAYOUTS)
         return NULL;
-    }
 
-    const uint32_t codepoint = _glfwKeySym2Unicode(keysyms[0]);
-    if (codepoint == GLFW_INVALID_CODEPOINT)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Failed to retrieve codepoint for key name");
-        return NULL;
-    }
+    if (!_glfw.wl.keynamesBuilt[group])
+        buildKeyNames(group);
 
-    const size_t count = _glfwEncodeUTF8(_glfw.wl.keynames[key],  codepoint);
-    if (count == 0)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Failed to encode codepoint for key name");
+    const char* name = _glfw.wl.keynames[group][scancode];
+    if (name[0] == '\0')
         return NULL;
-    }
 
-    _glfw.wl.keynames[key][count] = '\0';
-    return _glfw.wl.keynames[key];
+    return name;
 }
 
 int _glfwGetKeyScancodeWayland(int key)
@@ -2761,104 +3503,54 @@ GLFWbool _glfwCreateCursorWayland(_GLFWcursor* cursor,
     return GLFW_TRUE;
 }
 
-GLFWbool _glfwCreateStandardCursorWayland(_GLFWcursor* cursor, int shape)
+GLFWbool _glfwCreateAnimatedCursorWayland(_GLFWcursor* cursor,
+                                          const GLFWimage* images,
+                                          const int* delays,
+                                          int count,
+                                          int xhot, int yhot)
 {
-    const char* name = NULL;
+    cursor->wl.frames = _glfw_calloc(count, sizeof(struct wl_buffer*));
+    cursor->wl.delays = _glfw_calloc(count, sizeof(int));
 
-    // Try the XDG names first
-    switch (shape)
+    // Every frame is uploaded once, so stepping the animation only needs an
+    // attach and commit of an existing buffer
+    for (int i = 0;  i < count;  i++)
     {
-        case GLFW_ARROW_CURSOR:
-            name = "default";
-            break;
-        case GLFW_IBEAM_CURSOR:
-            name = "text";
-            break;
-        case GLFW_CROSSHAIR_CURSOR:
-            name = "crosshair";
-            break;
-        case GLFW_POINTING_HAND_CURSOR:
-            name = "pointer";
-            break;
-        case GLFW_RESIZE_EW_CURSOR:
-            name = "ew-resize";
-            break;
-        case GLFW_RESIZE_NS_CURSOR:
-            name = "ns-resize";
-            break;
-        case GLFW_RESIZE_NWSE_CURSOR:
-            name = "nwse-resize";
-            break;
-        case GLFW_RESIZE_NESW_CURSOR:
-            name = "nesw-resize";
-            break;
-        case GLFW_RESIZE_ALL_CURSOR:
-            name = "all-scroll";
-            break;
-        case GLFW_NOT_ALLOWED_CURSOR:
-            name = "not-allowed";
-            break;
+        cursor->wl.frames[i] = createShmBuffer(images + i);
+        if (!cursor->wl.frames[i])
+            return GLFW_FALSE;
+
+        cursor->wl.delays[i] = delays[i];
+        cursor->wl.frameCount++;
     }
 
-    cursor->wl.cursor = wl_cursor_theme_get_cursor(_glfw.wl.cursorTheme, name);
+    cursor->wl.width = images[0].width;
+    cursor->wl.height = images[0].height;
+    cursor->wl.xhot = xhot;
+    cursor->wl.yhot = yhot;
+    return GLFW_TRUE;
+}
 
-    if (_glfw.wl.cursorThemeHiDPI)
+GLFWbool _glfwCreateStandardCursorWayland(_GLFWcursor* cursor, int shape)
+{
+    if (!getCursorTheme(1))
     {
-        cursor->wl.cursorHiDPI =
-            wl_cursor_theme_get_cursor(_glfw.wl.cursorThemeHiDPI, name);
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to load default cursor theme");
+        return GLFW_FALSE;
     }
 
+    // Theme cursors are owned by their theme and shared by all cursor objects
+    // of the same shape
+    cursor->wl.cursor = getStandardCursor(shape, 1);
     if (!cursor->wl.cursor)
     {
-        // Fall back to the core X11 names
-        switch (shape)
-        {
-            case GLFW_ARROW_CURSOR:
-                name = "left_ptr";
-                break;
-            case GLFW_IBEAM_CURSOR:
-                name = "xterm";
-                break;
-            case GLFW_CROSSHAIR_CURSOR:
-                name = "crosshair";
-                break;
-            case GLFW_POINTING_HAND_CURSOR:
-                name = "hand2";
-                break;
-            case GLFW_RESIZE_EW_CURSOR:
-                name = "sb_h_double_arrow";
-                break;
-            case GLFW_RESIZE_NS_CURSOR:
-                name = "sb_v_double_arrow";
-                break;
-            case GLFW_RESIZE_ALL_CURSOR:
-                name = "fleur";
-                break;
-            default:
-                _glfwInputError(GLFW_CURSOR_UNAVAILABLE,
-                                "Wayland: Standard cursor shape unavailable");
-                return GLFW_FALSE;
-        }
-
-        cursor->wl.cursor = wl_cursor_theme_get_cursor(_glfw.wl.cursorTheme, name);
-        if (!cursor->wl.cursor)
-        {
-            _glfwInputError(GLFW_CURSOR_UNAVAILABLE,
-                            "Wayland: Failed to create standard cursor \"%s\"",
-                            name);
-            return GLFW_FALSE;
-        }
-
-        if (_glfw.wl.cursorThemeHiDPI)
-        {
-            if (!cursor->wl.cursorHiDPI)
-            {
-                cursor->wl.cursorHiDPI =
-                    wl_cursor_theme_get_cursor(_glfw.wl.cursorThemeHiDPI, name);
-            }
-        }
+        _glfwInputError(GLFW_CURSOR_UNAVAILABLE,
+                        "Wayland: Standard cursor shape unavailable");
+        return GLFW_FALSE;
     }
 
+    cursor->wl.shape = shape;
     return GLFW_TRUE;
 }
 
@@ -2870,6 +3562,12 @@ void _glfwDestroyCursorWayland(_GLFWcursor* cursor)
 
     if (cursor->wl.buffer)
         wl_buffer_destroy(cursor->wl.buffer);
+
+    for (int i = 0;  i < cursor->wl.frameCount;  i++)
+        wl_buffer_destroy(cursor->wl.frames[i]);
+
+    _glfw_free(cursor->wl.frames);
+    _glfw_free(cursor->wl.delays);
 }
 
 static void relativePointerHandleRelativeMotion(void* userData,
@@ -3041,8 +3739,12 @@ void _glfwSetCursorWayland(_GLFWwindow* window, _GLFWcursor* cursor)
             setCursorImage(window, &cursor->wl);
         else
         {
-            struct wl_cursor* defaultCursor =
-                wl_cursor_theme_get_cursor(_glfw.wl.cursorTheme, "left_ptr");
+            struct wl_cursor* defaultCursor = NULL;
+
+            if (window->wl.bufferScale > 1)
+                defaultCursor = getStandardCursor(GLFW_ARROW_CURSOR, 2);
+            if (!defaultCursor)
+                defaultCursor = getStandardCursor(GLFW_ARROW_CURSOR, 1);
             if (!defaultCursor)
             {
                 _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -3050,21 +3752,10 @@ void _glfwSetCursorWayland(_GLFWwindow* window, _GLFWcursor* cursor)
                 return;
             }
 
-            struct wl_cursor* defaultCursorHiDPI = NULL;
-            if (_glfw.wl.cursorThemeHiDPI)
-            {
-                defaultCursorHiDPI =
-                    wl_cursor_theme_get_cursor(_glfw.wl.cursorThemeHiDPI, "left_ptr");
-            }
-
             _GLFWcursorWayland cursorWayland =
             {
-                defaultCursor,
-                defaultCursorHiDPI,
-                NULL,
-                0, 0,
-                0, 0,
-                0
+                .cursor = defaultCursor,
+                .shape = GLFW_ARROW_CURSOR
             };
 
             setCursorImage(window, &cursorWayland);
@@ -208,231 +208,285 @@ static int translateKeySyms(const KeySym* keysyms, int width)
     return GLFW_KEY_UNKNOWN;
 }
 
-// Create key code translation tables
+// An XKB key name packed into an integer and the matching GLFW key
 //
-static void createKeyTables(void)
+typedef struct _GLFWkeynameX11
 {
-    int scancodeMin, scancodeMax;
+    uint32_t    name;
+    int         key;
+    int         order;
+} _GLFWkeynameX11;
+
+// XKB key names of the US keyboard layout
+// Function keys are mapped here because they are not mapped correctly when
+// using traditional KeySym translations
+//
+static const struct
+{
+    int key;
+    char* name;
+} keyNames[] =
+{
+        { GLFW_KEY_GRAVE_ACCENT, "TLDE" },
+        { GLFW_KEY_1, "AE01" },
+        { GLFW_KEY_2, "AE02" },
+        { GLFW_KEY_3, "AE03" },
+        { GLFW_KEY_4, "AE04" },
+        { GLFW_KEY_5, "AE05" },
+        { GLFW_KEY_6, "AE06" },
+        { GLFW_KEY_7, "AE07" },
+        { GLFW_KEY_8, "AE08" },
+        { GLFW_KEY_9, "AE09" },
+        { GLFW_KEY_0, "AE10" },
+        { GLFW_KEY_MINUS, "AE11" },
+        { GLFW_KEY_EQUAL, "AE12" },
+        { GLFW_KEY_Q, "AD01" },
+        { GLFW_KEY_W, "AD02" },
+        { GLFW_KEY_E, "AD03" },
+        { GLFW_KEY_R, "AD04" },
+        { GLFW_KEY_T, "AD05" },
+        { GLFW_KEY_Y, "AD06" },
+        { GLFW_KEY_U, "AD07" },
+        { GLFW_KEY_I, "AD08" },
+        { GLFW_KEY_O, "AD09" },
+        { GLFW_KEY_P, "AD10" },
+        { GLFW_KEY_LEFT_BRACKET, "AD11" },
+        { GLFW_KEY_RIGHT_BRACKET, "AD12" },
+        { GLFW_KEY_A, "AC01" },
+        { GLFW_KEY_S, "AC02" },
+        { GLFW_KEY_D, "AC03" },
+        { GLFW_KEY_F, "AC04" },
+        { GLFW_KEY_G, "AC05" },
+        { GLFW_KEY_H, "AC06" },
+        { GLFW_KEY_J, "AC07" },
+        { GLFW_KEY_K, "AC08" },
+        { GLFW_KEY_L, "AC09" },
+        { GLFW_KEY_SEMICOLON, "AC10" },
+        { GLFW_KEY_APOSTROPHE, "AC11" },
+        { GLFW_KEY_Z, "AB01" },
+        { GLFW_KEY_X, "AB02" },
+        { GLFW_KEY_C, "AB03" },
+        { GLFW_KEY_V, "AB04" },
+        { GLFW_KEY_B, "AB05" },
+        { GLFW_KEY_N, "AB06" },
+        { GLFW_KEY_M, "AB07" },
+        { GLFW_KEY_COMMA, "AB08" },
+        { GLFW_KEY_PERIOD, "AB09" },
+        { GLFW_KEY_SLASH, "AB10" },
+        { GLFW_KEY_BACKSLASH, "BKSL" },
+        { GLFW_KEY_WORLD_1, "LSGT" },
+        { GLFW_KEY_SPACE, "SPCE" },
+        { GLFW_KEY_ESCAPE, "ESC" },
+        { GLFW_KEY_ENTER, "RTRN" },
+        { GLFW_KEY_TAB, "TAB" },
+        { GLFW_KEY_BACKSPACE, "BKSP" },
+        { GLFW_KEY_INSERT, "INS" },
+        { GLFW_KEY_DELETE, "DELE" },
+        { GLFW_KEY_RIGHT, "RGHT" },
+        { GLFW_KEY_LEFT, "LEFT" },
+        { GLFW_KEY_DOWN, "DOWN" },
+        { GLFW_KEY_UP, "UP" },
+        { GLFW_KEY_PAGE_UP, "PGUP" },
+        { GLFW_KEY_PAGE_DOWN, "PGDN" },
+        { GLFW_KEY_HOME, "HOME" },
+        { GLFW_KEY_END, "END" },
+        { GLFW_KEY_CAPS_LOCK, "CAPS" },
+        { GLFW_KEY_SCROLL_LOCK, "SCLK" },
+        { GLFW_KEY_NUM_LOCK, "NMLK" },
+        { GLFW_KEY_PRINT_SCREEN, "PRSC" },
+        { GLFW_KEY_PAUSE, "PAUS" },
+        { GLFW_KEY_F1, "FK01" },
+        { GLFW_KEY_F2, "FK02" },
+        { GLFW_KEY_F3, "FK03" },
+        { GLFW_KEY_F4, "FK04" },
+        { GLFW_KEY_F5, "FK05" },
+        { GLFW_KEY_F6, "FK06" },
+        { GLFW_KEY_F7, "FK07" },
+        { GLFW_KEY_F8, "FK08" },
+        { GLFW_KEY_F9, "FK09" },
+        { GLFW_KEY_F10, "FK10" },
+        { GLFW_KEY_F11, "FK11" },
+        { GLFW_KEY_F12, "FK12" },
+        { GLFW_KEY_F13, "FK13" },
+        { GLFW_KEY_F14, "FK14" },
+        { GLFW_KEY_F15, "FK15" },
+        { GLFW_KEY_F16, "FK16" },
+        { GLFW_KEY_F17, "FK17" },
+        { GLFW_KEY_F18, "FK18" },
+        { GLFW_KEY_F19, "FK19" },
+        { GLFW_KEY_F20, "FK20" },
+        { GLFW_KEY_F21, "FK21" },
+        { GLFW_KEY_F22, "FK22" },
+        { GLFW_KEY_F23, "FK23" },
+        { GLFW_KEY_F24, "FK24" },
+        { GLFW_KEY_F25, "FK25" },
+        { GLFW_KEY_KP_0, "KP0" },
+        { GLFW_KEY_KP_1, "KP1" },
+        { GLFW_KEY_KP_2, "KP2" },
+        { GLFW_KEY_KP_3, "KP3" },
+        { GLFW_KEY_KP_4, "KP4" },
+        { GLFW_KEY_KP_5, "KP5" },
+        { GLFW_KEY_KP_6, "KP6" },
+        { GLFW_KEY_KP_7, "KP7" },
+        { GLFW_KEY_KP_8, "KP8" },
+        { GLFW_KEY_KP_9, "KP9" },
+        { GLFW_KEY_KP_DECIMAL, "KPDL" },
+        { GLFW_KEY_KP_DIVIDE, "KPDV" },
+        { GLFW_KEY_KP_MULTIPLY, "KPMU" },
+        { GLFW_KEY_KP_SUBTRACT, "KPSU" },
+        { GLFW_KEY_KP_ADD, "KPAD" },
+        { GLFW_KEY_KP_ENTER, "KPEN" },
+        { GLFW_KEY_KP_EQUAL, "KPEQ" },
+        { GLFW_KEY_LEFT_SHIFT, "LFSH" },
+        { GLFW_KEY_LEFT_CONTROL, "LCTL" },
+        { GLFW_KEY_LEFT_ALT, "LALT" },
+        { GLFW_KEY_LEFT_SUPER, "LWIN" },
+        { GLFW_KEY_RIGHT_SHIFT, "RTSH" },
+        { GLFW_KEY_RIGHT_CONTROL, "RCTL" },
+        { GLFW_KEY_RIGHT_ALT, "RALT" },
+        { GLFW_KEY_RIGHT_ALT, "LVL3" },
+        { GLFW_KEY_RIGHT_ALT, "MDSW" },
+        { GLFW_KEY_RIGHT_SUPER, "RWIN" },
+        { GLFW_KEY_MENU, "MENU" }
+};
+
+#define KEY_NAME_COUNT (sizeof(keyNames) / sizeof(keyNames[0]))
+
+// The key names above sorted by their packed names
+//
+static _GLFWkeynameX11 sortedKeyNames[KEY_NAME_COUNT];
+static GLFWbool keyNamesSorted;
 
-    memset(_glfw.x11.keycodes, -1, sizeof(_glfw.x11.keycodes));
-    memset(_glfw.x11.scancodes, -1, sizeof(_glfw.x11.scancodes));
+// Packs an XKB key name into an integer
+//
+static uint32_t packKeyName(const char* name)
+{
+    uint32_t packed = 0;
 
-    if (_glfw.x11.xkb.available)
+    for (int i = 0;  i < XkbKeyNameLength && name[i];  i++)
+        packed |= (uint32_t) (unsigned char) name[i] << (i * 8);
+
+    return packed;
+}
+
+// Lexically compare packed key names by name and then order; used by qsort
+//
+static int compareKeyNames(const void* fp, const void* sp)
+{
+    const _GLFWkeynameX11* fk = fp;
+    const _GLFWkeynameX11* sk = sp;
+
+    if (fk->name != sk->name)
+        return fk->name < sk->name ? -1 : 1;
+
+    return fk->order - sk->order;
+}
+
+// Returns the first entry with the specified packed key name, if any
+//
+static const _GLFWkeynameX11* findKeyName(const _GLFWkeynameX11* entries,
+                                          int count,
+                                          uint32_t name)
+{
+    int lower = 0, upper = count;
+
+    while (lower < upper)
     {
-        // Use XKB to determine physical key locations independently of the
-        // current keyboard layout
+        const int middle = lower + (upper - lower) / 2;
+        if (entries[middle].name < name)
+            lower = middle + 1;
+        else
+            upper = middle;
+    }
 
-        XkbDescPtr desc = XkbGetMap(_glfw.x11.display, 0, XkbUseCoreKbd);
-        XkbGetNames(_glfw.x11.display, XkbKeyNamesMask | XkbKeyAliasesMask, desc);
+    if (lower < count && entries[lower].name == name)
+        return entries + lower;
 
-        scancodeMin = desc->min_key_code;
-        scancodeMax = desc->max_key_code;
+    return NULL;
+}
 
-        const struct
-        {
-            int key;
-            char* name;
-        } keymap[] =
-        {
-            { GLFW_KEY_GRAVE_ACCENT, "TLDE" },
-            { GLFW_KEY_1, "AE01" },
-            { GLFW_KEY_2, "AE02" },
-            { GLFW_KEY_3, "AE03" },
-            { GLFW_KEY_4, "AE04" },
-            { GLFW_KEY_5, "AE05" },
-            { GLFW_KEY_6, "AE06" },
-            { GLFW_KEY_7, "AE07" },
-            { GLFW_KEY_8, "AE08" },
-            { GLFW_KEY_9, "AE09" },
-            { GLFW_KEY_0, "AE10" },
-            { GLFW_KEY_MINUS, "AE11" },
-            { GLFW_KEY_EQUAL, "AE12" },
-            { GLFW_KEY_Q, "AD01" },
-            { GLFW_KEY_W, "AD02" },
-            { GLFW_KEY_E, "AD03" },
-            { GLFW_KEY_R, "AD04" },
-            { GLFW_KEY_T, "AD05" },
-            { GLFW_KEY_Y, "AD06" },
-            { GLFW_KEY_U, "AD07" },
-            { GLFW_KEY_I, "AD08" },
-            { GLFW_KEY_O, "AD09" },
-            { GLFW_KEY_P, "AD10" },
-            { GLFW_KEY_LEFT_BRACKET, "AD11" },
-            { GLFW_KEY_RIGHT_BRACKET, "AD12" },
-            { GLFW_KEY_A, "AC01" },
-            { GLFW_KEY_S, "AC02" },
-            { GLFW_KEY_D, "AC03" },
-            { GLFW_KEY_F, "AC04" },
-            { GLFW_KEY_G, "AC05" },
-            { GLFW_KEY_H, "AC06" },
-            { GLFW_KEY_J, "AC07" },
-            { GLFW_KEY_K, "AC08" },
-            { GLFW_KEY_L, "AC09" },
-            { GLFW_KEY_SEMICOLON, "AC10" },
-            { GLFW_KEY_APOSTROPHE, "AC11" },
-            { GLFW_KEY_Z, "AB01" },
-            { GLFW_KEY_X, "AB02" },
-            { GLFW_KEY_C, "AB03" },
-            { GLFW_KEY_V, "AB04" },
-            { GLFW_KEY_B, "AB05" },
-            { GLFW_KEY_N, "AB06" },
-            { GLFW_KEY_M, "AB07" },
-            { GLFW_KEY_COMMA, "AB08" },
-            { GLFW_KEY_PERIOD, "AB09" },
-            { GLFW_KEY_SLASH, "AB10" },
-            { GLFW_KEY_BACKSLASH, "BKSL" },
-            { GLFW_KEY_WORLD_1, "LSGT" },
-            { GLFW_KEY_SPACE, "SPCE" },
-            { GLFW_KEY_ESCAPE, "ESC" },
-            { GLFW_KEY_ENTER, "RTRN" },
-            { GLFW_KEY_TAB, "TAB" },
-            { GLFW_KEY_BACKSPACE, "BKSP" },
-            { GLFW_KEY_INSERT, "INS" },
-            { GLFW_KEY_DELETE, "DELE" },
-            { GLFW_KEY_RIGHT, "RGHT" },
-            { GLFW_KEY_LEFT, "LEFT" },
-            { GLFW_KEY_DOWN, "DOWN" },
-            { GLFW_KEY_UP, "UP" },
-            { GLFW_KEY_PAGE_UP, "PGUP" },
-            { GLFW_KEY_PAGE_DOWN, "PGDN" },
-            { GLFW_KEY_HOME, "HOME" },
-            { GLFW_KEY_END, "END" },
-            { GLFW_KEY_CAPS_LOCK, "CAPS" },
-            { GLFW_KEY_SCROLL_LOCK, "SCLK" },
-            { GLFW_KEY_NUM_LOCK, "NMLK" },
-            { GLFW_KEY_PRINT_SCREEN, "PRSC" },
-            { GLFW_KEY_PAUSE, "PAUS" },
-            { GLFW_KEY_F1, "FK01" },
-            { GLFW_KEY_F2, "FK02" },
-            { GLFW_KEY_F3, "FK03" },
-            { GLFW_KEY_F4, "FK04" },
-            { GLFW_KEY_F5, "FK05" },
-            { GLFW_KEY_F6, "FK06" },
-            { GLFW_KEY_F7, "FK07" },
-            { GLFW_KEY_F8, "FK08" },
-            { GLFW_KEY_F9, "FK09" },
-            { GLFW_KEY_F10, "FK10" },
-            { GLFW_KEY_F11, "FK11" },
-            { GLFW_KEY_F12, "FK12" },
-            { GLFW_KEY_F13, "FK13" },
-            { GLFW_KEY_F14, "FK14" },
-            { GLFW_KEY_F15, "FK15" },
-            { GLFW_KEY_F16, "FK16" },
-            { GLFW_KEY_F17, "FK17" },
-            { GLFW_KEY_F18, "FK18" },
-            { GLFW_KEY_F19, "FK19" },
-            { GLFW_KEY_F20, "FK20" },
-            { GLFW_KEY_F21, "FK21" },
-            { GLFW_KEY_F22, "FK22" },
-            { GLFW_KEY_F23, "FK23" },
-            { GLFW_KEY_F24, "FK24" },
-            { GLFW_KEY_F25, "FK25" },
-            { GLFW_KEY_KP_0, "KP0" },
-            { GLFW_KEY_KP_1, "KP1" },
-            { GLFW_KEY_KP_2, "KP2" },
-            { GLFW_KEY_KP_3, "KP3" },
-            { GLFW_KEY_KP_4, "KP4" },
-            { GLFW_KEY_KP_5, "KP5" },
-            { GLFW_KEY_KP_6, "KP6" },
-            { GLFW_KEY_KP_7, "KP7" },
-            { GLFW_KEY_KP_8, "KP8" },
-            { GLFW_KEY_KP_9, "KP9" },
-            { GLFW_KEY_KP_DECIMAL, "KPDL" },
-            { GLFW_KEY_KP_DIVIDE, "KPDV" },
-            { GLFW_KEY_KP_MULTIPLY, "KPMU" },
-            { GLFW_KEY_KP_SUBTRACT, "KPSU" },
-            { GLFW_KEY_KP_ADD, "KPAD" },
-            { GLFW_KEY_KP_ENTER, "KPEN" },
-            { GLFW_KEY_KP_EQUAL, "KPEQ" },
-            { GLFW_KEY_LEFT_SHIFT, "LFSH" },
-            { GLFW_KEY_LEFT_CONTROL, "LCTL" },
-            { GLFW_KEY_LEFT_ALT, "LALT" },
-            { GLFW_KEY_LEFT_SUPER, "LWIN" },
-            { GLFW_KEY_RIGHT_SHIFT, "RTSH" },
-            { GLFW_KEY_RIGHT_CONTROL, "RCTL" },
-            { GLFW_KEY_RIGHT_ALT, "RALT" },
-            { GLFW_KEY_RIGHT_ALT, "LVL3" },
-            { GLFW_KEY_RIGHT_ALT, "MDSW" },
-            { GLFW_KEY_RIGHT_SUPER, "RWIN" },
-            { GLFW_KEY_MENU, "MENU" }
-        };
-
-        // Find the X11 key code -> GLFW key code mapping
-        for (int scancode = scancodeMin;  scancode <= scancodeMax;  scancode++)
+// Returns the GLFW key with the specified packed XKB key name
+//
+static int translateKeyName(uint32_t name)
+{
+    if (!keyNamesSorted)
+    {
+        for (int i = 0;  i < (int) KEY_NAME_COUNT;  i++)
         {
-            int key = GLFW_KEY_UNKNOWN;
+            sortedKeyNames[i].name = packKeyName(keyNames[i].name);
+            sortedKeyNames[i].key = keyNames[i].key;
+            sortedKeyNames[i].order = i;
+        }
 
-            // Map the key name to a GLFW key code. Note: We use the US
-            // keyboard layout. Because function keys aren't mapped correctly
-            // when using traditional KeySym translations, they are mapped
-            // here instead.
-            for (int i = 0;  i < sizeof(keymap) / sizeof(keymap[0]);  i++)
-            {
-                if (strncmp(desc->names->keys[scancode].name,
-                            keymap[i].name,
-                            XkbKeyNameLength) == 0)
-                {
-                    key = keymap[i].key;
-                    break;
-                }
-            }
+        qsort(sortedKeyNames, KEY_NAME_COUNT, sizeof(_GLFWkeynameX11), compareKeyNames);
+        keyNamesSorted = GLFW_TRUE;
+    }
 
-            // Fall back to key aliases in case the key name did not match
-            for (int i = 0;  i < desc->names->num_key_aliases;  i++)
-            {
-                if (key != GLFW_KEY_UNKNOWN)
-                    break;
-
-                if (strncmp(desc->names->key_aliases[i].real,
-                            desc->names->keys[scancode].name,
-                            XkbKeyNameLength) != 0)
-                {
-                    continue;
-                }
-
-                for (int j = 0;  j < sizeof(keymap) / sizeof(keymap[0]);  j++)
-                {
-                    if (strncmp(desc->names->key_aliases[i].alias,
-                                keymap[j].name,
-                                XkbKeyNameLength) == 0)
-                    {
-                        key = keymap[j].key;
-                        break;
-                    }
-                }
-            }
+    const _GLFWkeynameX11* entry = findKeyName(sortedKeyNames, KEY_NAME_COUNT, name);
+    if (entry)
+        return entry->key;
 
-            _glfw.x11.keycodes[scancode] = key;
-        }
+    return GLFW_KEY_UNKNOWN;
+}
 
-        XkbFreeNames(desc, XkbKeyNamesMask, True);
-        XkbFreeKeyboard(desc, 0, True);
+// Maps the specified range of X11 key codes to GLFW keys using their XKB names
+//
+static void translateXkbKeyNames(XkbDescPtr desc, int first, int last)
+{
+    // Map the key names to GLFW keys using the US keyboard layout
+    for (int scancode = first;  scancode <= last;  scancode++)
+    {
+        const uint32_t name = packKeyName(desc->names->keys[scancode].name);
+        _glfw.x11.keycodes[scancode] = translateKeyName(name);
     }
-    else
-        XDisplayKeycodes(_glfw.x11.display, &scancodeMin, &scancodeMax);
 
-    int width;
-    KeySym* keysyms = XGetKeyboardMapping(_glfw.x11.display,
-                                          scancodeMin,
-                                          scancodeMax - scancodeMin + 1,
-                                          &width);
+    if (!desc->names->key_aliases || !desc->names->num_key_aliases)
+        return;
+
+    // Fall back to key aliases in case the key name did not match
+    // The aliases are sorted by real name so that each unmatched key code only
+    // needs a single search, with the first matching alias taking precedence
+    _GLFWkeynameX11* aliases =
+        _glfw_calloc(desc->names->num_key_aliases, sizeof(_GLFWkeynameX11));
+    if (!aliases)
+        return;
+
+    int aliasCount = 0;
 
-    for (int scancode = scancodeMin;  scancode <= scancodeMax;  scancode++)
+    for (int i = 0;  i < desc->names->num_key_aliases;  i++)
     {
-        // Translate the un-translated key codes using traditional X11 KeySym
-        // lookups
-        if (_glfw.x11.keycodes[scancode] < 0)
-        {
-            const size_t base = (scancode - scancodeMin) * width;
-            _glfw.x11.keycodes[scancode] = translateKeySyms(&keysyms[base], width);
-        }
+        const int key = translateKeyName(packKeyName(desc->names->key_aliases[i].alias));
+        if (key == GLFW_KEY_UNKNOWN)
+            continue;
+
+        aliases[aliasCount].name = packKeyName(desc->names->key_aliases[i].real);
+        aliases[aliasCount].key = key;
+        aliases[aliasCount].order = i;
+        aliasCount++;
+    }
 
-        // Store the reverse translation for faster key name lookup
-        if (_glfw.x11.keycodes[scancode] > 0)
-            _glfw.x11.scancodes[_glfw.x11.keycodes[scancode]] = scancode;
+    qsort(aliases, aliasCount, sizeof(_GLFWkeynameX11), compareKeyNames);
+
+    for (int scancode = first;  scancode <= last;  scancode++)
+    {
+        if (_glfw.x11.keycodes[scancode] != GLFW_KEY_UNKNOWN)
+            continue;
+
+        const uint32_t name = packKeyName(desc->names->keys[scancode].name);
+        const _GLFWkeynameX11* alias = findKeyName(aliases, aliasCount, name);
+        if (alias)
+            _glfw.x11.keycodes[scancode] = alias->key;
     }
 
-    XFree(keysyms);
+    _glfw_free(aliases);
+}
+
+// Create key code translation tables
+//
+static void createKeyTables(void)
+{
+    memset(_glfw.x11.keycodes, -1, sizeof(_glfw.x11.keycodes));
+    _glfwUpdateKeyTablesX11(0, 255);
 }
 
 // Check whether the IM has a usable style
@@ -577,6 +631,8 @@ static void detectEWMH(void)
         getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_STATE_MAXIMIZED_VERT");
     _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ =
         getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_STATE_MAXIMIZED_HORZ");
+    _glfw.x11.NET_WM_STATE_HIDDEN =
+        getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_STATE_HIDDEN");
     _glfw.x11.NET_WM_STATE_DEMANDS_ATTENTION =
         getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_STATE_DEMANDS_ATTENTION");
     _glfw.x11.NET_WM_FULLSCREEN_MONITORS =
@@ -600,9 +656,9 @@ static void detectEWMH(void)
         XFree(supportedAtoms);
 }
 
-// Look for and initialize supported X11 extensions
+// Loads the XF86VidMode extension library, used as a fallback for gamma
 //
-static GLFWbool initExtensions(void)
+static GLFWbool loadVidMode(void)
 {
 #if defined(__OpenBSD__) || defined(__NetBSD__)
     _glfw.x11.vidmode.handle = _glfwPlatformLoadModule("libXxf86vm.so");
@@ -626,6 +682,13 @@ static GLFWbool initExtensions(void)
                                       &_glfw.x11.vidmode.errorBase);
     }
 
+    return _glfw.x11.vidmode.available;
+}
+
+// Loads the XInput2 extension library, used for raw mouse motion
+//
+static GLFWbool loadXInput(void)
+{
 #if defined(__CYGWIN__)
     _glfw.x11.xi.handle = _glfwPlatformLoadModule("libXi-6.so");
 #elif defined(__OpenBSD__) || defined(__NetBSD__)
@@ -658,100 +721,13 @@ static GLFWbool initExtensions(void)
         }
     }
 
-#if defined(__CYGWIN__)
-    _glfw.x11.randr.handle = _glfwPlatformLoadModule("libXrandr-2.so");
-#elif defined(__OpenBSD__) || defined(__NetBSD__)
-    _glfw.x11.randr.handle = _glfwPlatformLoadModule("libXrandr.so");
-#else
-    _glfw.x11.randr.handle = _glfwPlatformLoadModule("libXrandr.so.2");
-#endif
-    if (_glfw.x11.randr.handle)
-    {
-        _glfw.x11.randr.AllocGamma = (PFN_XRRAllocGamma)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRAllocGamma");
-        _glfw.x11.randr.FreeGamma = (PFN_XRRFreeGamma)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRFreeGamma");
-        _glfw.x11.randr.FreeCrtcInfo = (PFN_XRRFreeCrtcInfo)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRFreeCrtcInfo");
-        _glfw.x11.randr.FreeGamma = (PFN_XRRFreeGamma)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRFreeGamma");
-        _glfw.x11.randr.FreeOutputInfo = (PFN_XRRFreeOutputInfo)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRFreeOutputInfo");
-        _glfw.x11.randr.FreeScreenResources = (PFN_XRRFreeScreenResources)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRFreeScreenResources");
-        _glfw.x11.randr.GetCrtcGamma = (PFN_XRRGetCrtcGamma)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRGetCrtcGamma");
-        _glfw.x11.randr.GetCrtcGammaSize = (PFN_XRRGetCrtcGammaSize)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRGetCrtcGammaSize");
-        _glfw.x11.randr.GetCrtcInfo = (PFN_XRRGetCrtcInfo)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRGetCrtcInfo");
-        _glfw.x11.randr.GetOutputInfo = (PFN_XRRGetOutputInfo)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRGetOutputInfo");
-        _glfw.x11.randr.GetOutputPrimary = (PFN_XRRGetOutputPrimary)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRGetOutputPrimary");
-        _glfw.x11.randr.GetScreenResourcesCurrent = (PFN_XRRGetScreenResourcesCurrent)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRGetScreenResourcesCurrent");
-        _glfw.x11.randr.QueryExtension = (PFN_XRRQueryExtension)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRQueryExtension");
-        _glfw.x11.randr.QueryVersion = (PFN_XRRQueryVersion)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRQueryVersion");
-        _glfw.x11.randr.SelectInput = (PFN_XRRSelectInput)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRSelectInput");
-        _glfw.x11.randr.SetCrtcConfig = (PFN_XRRSetCrtcConfig)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRSetCrtcConfig");
-        _glfw.x11.randr.SetCrtcGamma = (PFN_XRRSetCrtcGamma)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRSetCrtcGamma");
-        _glfw.x11.randr.UpdateConfiguration = (PFN_XRRUpdateConfiguration)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRUpdateConfiguration");
-
-        if (XRRQueryExtension(_glfw.x11.display,
-                              &_glfw.x11.randr.eventBase,
-                              &_glfw.x11.randr.errorBase))
-        {
-            if (XRRQueryVersion(_glfw.x11.display,
-                                &_glfw.x11.randr.major,
-                                &_glfw.x11.randr.minor))
-            {
-                // The GLFW RandR path requires at least version 1.3
-                if (_glfw.x11.randr.major > 1 || _glfw.x11.randr.minor >= 3)
-                    _glfw.x11.randr.available = GLFW_TRUE;
-            }
-            else
-            {
-                _glfwInputError(GLFW_PLATFORM_ERROR,
-                                "X11: Failed to query RandR version");
-            }
-        }
-    }
-
-    if (_glfw.x11.randr.available)
-    {
-        XRRScreenResources* sr = XRRGetScreenResourcesCurrent(_glfw.x11.display,
-                                                              _glfw.x11.root);
-
-        if (!sr->ncrtc || !XRRGetCrtcGammaSize(_glfw.x11.display, sr->crtcs[0]))
-        {
-            // This is likely an older Nvidia driver with broken gamma support
-            // Flag it as useless and fall back to xf86vm gamma, if available
-            _glfw.x11.randr.gammaBroken = GLFW_TRUE;
-        }
-
-        if (!sr->ncrtc)
-        {
-            // A system without CRTCs is likely a system with broken RandR
-            // Disable the RandR monitor path and fall back to core functions
-            _glfw.x11.randr.monitorBroken = GLFW_TRUE;
-        }
-
-        XRRFreeScreenResources(sr);
-    }
-
-    if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
-    {
-        XRRSelectInput(_glfw.x11.display, _glfw.x11.root,
-                       RROutputChangeNotifyMask);
-    }
+    return _glfw.x11.xi.available;
+}
 
+// Loads the Xcursor library, used for image and theme cursors
+//
+static GLFWbool loadXcursor(void)
+{
 #if defined(__CYGWIN__)
     _glfw.x11.xcursor.handle = _glfwPlatformLoadModule("libXcursor-1.so");
 #elif defined(__OpenBSD__) || defined(__NetBSD__)
@@ -773,8 +749,21 @@ static GLFWbool initExtensions(void)
             _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorGetDefaultSize");
         _glfw.x11.xcursor.LibraryLoadImage = (PFN_XcursorLibraryLoadImage)
             _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorLibraryLoadImage");
+        _glfw.x11.xcursor.ImagesCreate = (PFN_XcursorImagesCreate)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorImagesCreate");
+        _glfw.x11.xcursor.ImagesDestroy = (PFN_XcursorImagesDestroy)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorImagesDestroy");
+        _glfw.x11.xcursor.ImagesLoadCursor = (PFN_XcursorImagesLoadCursor)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorImagesLoadCursor");
     }
 
+    return _glfw.x11.xcursor.handle != NULL;
+}
+
+// Loads the Xinerama extension library, used for full screen placement
+//
+static GLFWbool loadXinerama(void)
+{
 #if defined(__CYGWIN__)
     _glfw.x11.xinerama.handle = _glfwPlatformLoadModule("libXinerama-1.so");
 #elif defined(__OpenBSD__) || defined(__NetBSD__)
@@ -800,6 +789,13 @@ static GLFWbool initExtensions(void)
         }
     }
 
+    return _glfw.x11.xinerama.available;
+}
+
+// Initializes the XKB extension and builds the key code tables
+//
+static GLFWbool loadXkb(void)
+{
     _glfw.x11.xkb.major = 1;
     _glfw.x11.xkb.minor = 0;
     _glfw.x11.xkb.available =
@@ -826,18 +822,38 @@ static GLFWbool initExtensions(void)
 
         XkbSelectEventDetails(_glfw.x11.display, XkbUseCoreKbd, XkbStateNotify,
                               XkbGroupStateMask, XkbGroupStateMask);
+
+        // Track changes to the keyboard mapping to keep the key tables current
+        XkbSelectEventDetails(_glfw.x11.display, XkbUseCoreKbd, XkbNewKeyboardNotify,
+                              XkbNKN_KeycodesMask, XkbNKN_KeycodesMask);
+        XkbSelectEventDetails(_glfw.x11.display, XkbUseCoreKbd, XkbMapNotify,
+                              XkbKeySymsMask, XkbKeySymsMask);
+        XkbSelectEventDetails(_glfw.x11.display, XkbUseCoreKbd, XkbNamesNotify,
+                              XkbKeyNamesMask | XkbKeyAliasesMask,
+                              XkbKeyNamesMask | XkbKeyAliasesMask);
     }
 
-    if (_glfw.hints.init.x11.xcbVulkanSurface)
-    {
+    // Update the key code LUT
+    createKeyTables();
+    _glfwInitKeySym2Unicode();
+
+    return _glfw.x11.xkb.available;
+}
+
+// Loads the X11-xcb library, used for VK_KHR_xcb_surface
+//
+static GLFWbool loadX11XCB(void)
+{
+    if (!_glfw.hints.init.x11.xcbVulkanSurface)
+        return GLFW_FALSE;
+
 #if defined(__CYGWIN__)
-        _glfw.x11.x11xcb.handle = _glfwPlatformLoadModule("libX11-xcb-1.so");
+    _glfw.x11.x11xcb.handle = _glfwPlatformLoadModule("libX11-xcb-1.so");
 #elif defined(__OpenBSD__) || defined(__NetBSD__)
-        _glfw.x11.x11xcb.handle = _glfwPlatformLoadModule("libX11-xcb.so");
+    _glfw.x11.x11xcb.handle = _glfwPlatformLoadModule("libX11-xcb.so");
 #else
-        _glfw.x11.x11xcb.handle = _glfwPlatformLoadModule("libX11-xcb.so.1");
+    _glfw.x11.x11xcb.handle = _glfwPlatformLoadModule("libX11-xcb.so.1");
 #endif
-    }
 
     if (_glfw.x11.x11xcb.handle)
     {
@@ -845,6 +861,13 @@ static GLFWbool initExtensions(void)
             _glfwPlatformGetModuleSymbol(_glfw.x11.x11xcb.handle, "XGetXCBConnection");
     }
 
+    return _glfw.x11.x11xcb.GetXCBConnection != NULL;
+}
+
+// Loads the Xrender extension library, used for transparent framebuffers
+//
+static GLFWbool loadXrender(void)
+{
 #if defined(__CYGWIN__)
     _glfw.x11.xrender.handle = _glfwPlatformLoadModule("libXrender-1.so");
 #elif defined(__OpenBSD__) || defined(__NetBSD__)
@@ -874,6 +897,13 @@ static GLFWbool initExtensions(void)
         }
     }
 
+    return _glfw.x11.xrender.available;
+}
+
+// Loads the X Shape extension library, used for mouse passthrough
+//
+static GLFWbool loadXshape(void)
+{
 #if defined(__CYGWIN__)
     _glfw.x11.xshape.handle = _glfwPlatformLoadModule("libXext-6.so");
 #elif defined(__OpenBSD__) || defined(__NetBSD__)
@@ -905,10 +935,143 @@ static GLFWbool initExtensions(void)
         }
     }
 
-    // Update the key code LUT
-    // FIXME: We should listen to XkbMapNotify events to track changes to
-    // the keyboard mapping.
-    createKeyTables();
+    return _glfw.x11.xshape.available;
+}
+
+// Loads the MIT-SHM extension library, used for presenting software pixels
+//
+static GLFWbool loadXshm(void)
+{
+#if defined(__CYGWIN__)
+    _glfw.x11.xshm.handle = _glfwPlatformLoadModule("libXext-6.so");
+#elif defined(__OpenBSD__) || defined(__NetBSD__)
+    _glfw.x11.xshm.handle = _glfwPlatformLoadModule("libXext.so");
+#else
+    _glfw.x11.xshm.handle = _glfwPlatformLoadModule("libXext.so.6");
+#endif
+    if (_glfw.x11.xshm.handle)
+    {
+        _glfw.x11.xshm.QueryExtension = (PFN_XShmQueryExtension)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshm.handle, "XShmQueryExtension");
+        _glfw.x11.xshm.GetEventBase = (PFN_XShmGetEventBase)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshm.handle, "XShmGetEventBase");
+        _glfw.x11.xshm.Attach = (PFN_XShmAttach)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshm.handle, "XShmAttach");
+        _glfw.x11.xshm.Detach = (PFN_XShmDetach)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshm.handle, "XShmDetach");
+        _glfw.x11.xshm.CreateImage = (PFN_XShmCreateImage)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshm.handle, "XShmCreateImage");
+        _glfw.x11.xshm.PutImage = (PFN_XShmPutImage)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshm.handle, "XShmPutImage");
+
+        if (XShmQueryExtension(_glfw.x11.display))
+        {
+            _glfw.x11.xshm.eventBase = XShmGetEventBase(_glfw.x11.display);
+            _glfw.x11.xshm.available = GLFW_TRUE;
+        }
+    }
+
+    return _glfw.x11.xshm.available;
+}
+
+// Loads the extensions needed by every program and interns the atoms
+// All other extensions are loaded on first use by _glfwLoadExtensionX11
+//
+static GLFWbool initExtensions(void)
+{
+#if defined(__CYGWIN__)
+    _glfw.x11.randr.handle = _glfwPlatformLoadModule("libXrandr-2.so");
+#elif defined(__OpenBSD__) || defined(__NetBSD__)
+    _glfw.x11.randr.handle = _glfwPlatformLoadModule("libXrandr.so");
+#else
+    _glfw.x11.randr.handle = _glfwPlatformLoadModule("libXrandr.so.2");
+#endif
+    if (_glfw.x11.randr.handle)
+    {
+        _glfw.x11.randr.AllocGamma = (PFN_XRRAllocGamma)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRAllocGamma");
+        _glfw.x11.randr.FreeGamma = (PFN_XRRFreeGamma)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRFreeGamma");
+        _glfw.x11.randr.FreeCrtcInfo = (PFN_XRRFreeCrtcInfo)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRFreeCrtcInfo");
+        _glfw.x11.randr.FreeGamma = (PFN_XRRFreeGamma)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRFreeGamma");
+        _glfw.x11.randr.FreeOutputInfo = (PFN_XRRFreeOutputInfo)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRFreeOutputInfo");
+        _glfw.x11.randr.FreeScreenResources = (PFN_XRRFreeScreenResources)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRFreeScreenResources");
+        _glfw.x11.randr.GetCrtcGamma = (PFN_XRRGetCrtcGamma)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRGetCrtcGamma");
+        _glfw.x11.randr.GetCrtcGammaSize = (PFN_XRRGetCrtcGammaSize)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRGetCrtcGammaSize");
+        _glfw.x11.randr.GetCrtcInfo = (PFN_XRRGetCrtcInfo)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRGetCrtcInfo");
+        _glfw.x11.randr.GetOutputInfo = (PFN_XRRGetOutputInfo)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRGetOutputInfo");
+        _glfw.x11.randr.GetOutputPrimary = (PFN_XRRGetOutputPrimary)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRGetOutputPrimary");
+        _glfw.x11.randr.GetScreenResourcesCurrent = (PFN_XRRGetScreenResourcesCurrent)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRGetScreenResourcesCurrent");
+        _glfw.x11.randr.QueryExtension = (PFN_XRRQueryExtension)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRQueryExtension");
+        _glfw.x11.randr.QueryVersion = (PFN_XRRQueryVersion)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRQueryVersion");
+        _glfw.x11.randr.SelectInput = (PFN_XRRSelectInput)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRSelectInput");
+        _glfw.x11.randr.SetCrtcConfig = (PFN_XRRSetCrtcConfig)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRSetCrtcConfig");
+        _glfw.x11.randr.SetCrtcGamma = (PFN_XRRSetCrtcGamma)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRSetCrtcGamma");
+        _glfw.x11.randr.UpdateConfiguration = (PFN_XRRUpdateConfiguration)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.randr.handle, "XRRUpdateConfiguration");
+
+        if (XRRQueryExtension(_glfw.x11.display,
+                              &_glfw.x11.randr.eventBase,
+                              &_glfw.x11.randr.errorBase))
+        {
+            if (XRRQueryVersion(_glfw.x11.display,
+                                &_glfw.x11.randr.major,
+                                &_glfw.x11.randr.minor))
+            {
+                // The GLFW RandR path requires at least version 1.3
+                if (_glfw.x11.randr.major > 1 || _glfw.x11.randr.minor >= 3)
+                    _glfw.x11.randr.available = GLFW_TRUE;
+            }
+            else
+            {
+                _glfwInputError(GLFW_PLATFORM_ERROR,
+                                "X11: Failed to query RandR version");
+            }
+        }
+    }
+
+    if (_glfw.x11.randr.available)
+    {
+        XRRScreenResources* sr = XRRGetScreenResourcesCurrent(_glfw.x11.display,
+                                                              _glfw.x11.root);
+
+        if (!sr->ncrtc || !XRRGetCrtcGammaSize(_glfw.x11.display, sr->crtcs[0]))
+        {
+            // This is likely an older Nvidia driver with broken gamma support
+            // Flag it as useless and fall back to xf86vm gamma, if available
+            _glfw.x11.randr.gammaBroken = GLFW_TRUE;
+        }
+
+        if (!sr->ncrtc)
+        {
+            // A system without CRTCs is likely a system with broken RandR
+            // Disable the RandR monitor path and fall back to core functions
+            _glfw.x11.randr.monitorBroken = GLFW_TRUE;
+        }
+
+        XRRFreeScreenResources(sr);
+    }
+
+    if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
+    {
+        XRRSelectInput(_glfw.x11.display, _glfw.x11.root,
+                       RROutputChangeNotifyMask);
+    }
 
     // String format atoms
     _glfw.x11.NULL_ = XInternAtom(_glfw.x11.display, "NULL", False);
@@ -1022,15 +1185,6 @@ static void getSystemContentScale(float* xscale, float* yscale)
     *yscale = ydpi / 96.f;
 }
 
-// Create a blank cursor for hidden and disabled cursor modes
-//
-static Cursor createHiddenCursor(void)
-{
-    unsigned char pixels[16 * 16 * 4] = { 0 };
-    GLFWimage image = { 16, 16, pixels };
-    return _glfwCreateNativeCursorX11(&image, 0, 0);
-}
-
 // Create a helper window for IPC
 //
 static Window createHelperWindow(void)
@@ -1087,6 +1241,33 @@ static int errorHandler(Display *display, XErrorEvent* event)
     return 0;
 }
 
+// Converts a GLFW image to a premultiplied Xcursor image
+//
+static XcursorImage* createXcursorImage(const GLFWimage* image, int xhot, int yhot)
+{
+    XcursorImage* native = XcursorImageCreate(image->width, image->height);
+    if (native == NULL)
+        return NULL;
+
+    native->xhot = xhot;
+    native->yhot = yhot;
+
+    unsigned char* source = (unsigned char*) image->pixels;
+    XcursorPixel* target = native->pixels;
+
+    for (int i = 0;  i < image->width * image->height;  i++, target++, source += 4)
+    {
+        unsigned int alpha = source[3];
+
+        *target = (alpha << 24) |
+                  ((unsigned char) ((source[0] * alpha) / 255) << 16) |
+                  ((unsigned char) ((source[1] * alpha) / 255) <<  8) |
+                  ((unsigned char) ((source[2] * alpha) / 255) <<  0);
+    }
+
+    return native;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -1122,37 +1303,184 @@ void _glfwInputErrorX11(int error, const char* message)
     _glfwInputError(error, "%s: %s", message, buffer);
 }
 
+// Loads the specified extension if this has not already been attempted and
+// returns whether it is available
+//
+GLFWbool _glfwLoadExtensionX11(int extension)
+{
+    pthread_mutex_lock(&_glfw.x11.extensionLock);
+
+    if (!(_glfw.x11.loadedExtensions & extension))
+    {
+        GLFWbool available = GLFW_FALSE;
+
+        switch (extension)
+        {
+            case _GLFW_X11_VIDMODE:
+                available = loadVidMode();
+                break;
+            case _GLFW_X11_XI:
+                available = loadXInput();
+                break;
+            case _GLFW_X11_XCURSOR:
+                available = loadXcursor();
+                break;
+            case _GLFW_X11_XINERAMA:
+                available = loadXinerama();
+                break;
+            case _GLFW_X11_XKB:
+                available = loadXkb();
+                break;
+            case _GLFW_X11_X11XCB:
+                available = loadX11XCB();
+                break;
+            case _GLFW_X11_XRENDER:
+                available = loadXrender();
+                break;
+            case _GLFW_X11_XSHAPE:
+                available = loadXshape();
+                break;
+            case _GLFW_X11_XSHM:
+                available = loadXshm();
+                break;
+        }
+
+        _glfw.x11.loadedExtensions |= extension;
+        if (available)
+            _glfw.x11.availableExtensions |= extension;
+    }
+
+    const GLFWbool available = (_glfw.x11.availableExtensions & extension) != 0;
+
+    pthread_mutex_unlock(&_glfw.x11.extensionLock);
+    return available;
+}
+
+// Updates the key code translation tables for the specified range of X11 key
+// codes, for example after the keyboard mapping has changed
+//
+void _glfwUpdateKeyTablesX11(int first, int last)
+{
+    int scancodeMin, scancodeMax;
+    XkbDescPtr desc = NULL;
+
+    first = _glfw_max(first, 0);
+    last = _glfw_min(last, 255);
+
+    for (int scancode = first;  scancode <= last;  scancode++)
+        _glfw.x11.keycodes[scancode] = -1;
+
+    if (_glfw.x11.xkb.available)
+    {
+        // Use XKB to determine physical key locations independently of the
+        // current keyboard layout
+        desc = XkbGetMap(_glfw.x11.display, 0, XkbUseCoreKbd);
+        XkbGetNames(_glfw.x11.display, XkbKeyNamesMask | XkbKeyAliasesMask, desc);
+
+        scancodeMin = desc->min_key_code;
+        scancodeMax = desc->max_key_code;
+    }
+    else
+        XDisplayKeycodes(_glfw.x11.display, &scancodeMin, &scancodeMax);
+
+    first = _glfw_max(first, scancodeMin);
+    last = _glfw_min(last, scancodeMax);
+
+    if (first <= last)
+    {
+        if (desc && desc->names)
+            translateXkbKeyNames(desc, first, last);
+
+        int width;
+        KeySym* keysyms = XGetKeyboardMapping(_glfw.x11.display,
+                                              first,
+                                              last - first + 1,
+                                              &width);
+
+        // Translate the un-translated key codes using traditional X11 KeySym
+        // lookups
+        for (int scancode = first;  scancode <= last;  scancode++)
+        {
+            if (_glfw.x11.keycodes[scancode] < 0)
+            {
+                const size_t base = (scancode - first) * width;
+                _glfw.x11.keycodes[scancode] = translateKeySyms(&keysyms[base], width);
+            }
+        }
+
+        XFree(keysyms);
+    }
+
+    if (desc)
+    {
+        XkbFreeNames(desc, XkbKeyNamesMask | XkbKeyAliasesMask, True);
+        XkbFreeKeyboard(desc, 0, True);
+    }
+
+    // The key names are rebuilt on demand for the new mapping
+    memset(_glfw.x11.keynamesBuilt, 0, sizeof(_glfw.x11.keynamesBuilt));
+
+    // Store the reverse translation for faster key name lookup
+    memset(_glfw.x11.scancodes, -1, sizeof(_glfw.x11.scancodes));
+
+    for (int scancode = 0;  scancode < 256;  scancode++)
+    {
+        if (_glfw.x11.keycodes[scancode] > 0)
+            _glfw.x11.scancodes[_glfw.x11.keycodes[scancode]] = scancode;
+    }
+}
+
 // Creates a native cursor object from the specified image and hotspot
 //
 Cursor _glfwCreateNativeCursorX11(const GLFWimage* image, int xhot, int yhot)
 {
     Cursor cursor;
 
-    if (!_glfw.x11.xcursor.handle)
+    if (!_glfwLoadExtensionX11(_GLFW_X11_XCURSOR))
         return None;
 
-    XcursorImage* native = XcursorImageCreate(image->width, image->height);
+    XcursorImage* native = createXcursorImage(image, xhot, yhot);
     if (native == NULL)
         return None;
 
-    native->xhot = xhot;
-    native->yhot = yhot;
+    cursor = XcursorImageLoadCursor(_glfw.x11.display, native);
+    XcursorImageDestroy(native);
 
-    unsigned char* source = (unsigned char*) image->pixels;
-    XcursorPixel* target = native->pixels;
+    return cursor;
+}
 
-    for (int i = 0;  i < image->width * image->height;  i++, target++, source += 4)
+Cursor _glfwCreateNativeAnimatedCursorX11(const GLFWimage* images,
+                                          const int* delays,
+                                          int count,
+                                          int xhot, int yhot)
+{
+    Cursor cursor;
+
+    if (!_glfwLoadExtensionX11(_GLFW_X11_XCURSOR))
+        return None;
+
+    XcursorImages* native = XcursorImagesCreate(count);
+    if (native == NULL)
+        return None;
+
+    // XcursorImagesDestroy also destroys every image added so far
+    for (native->nimage = 0;  native->nimage < count;  native->nimage++)
     {
-        unsigned int alpha = source[3];
+        XcursorImage* frame =
+            createXcursorImage(images + native->nimage, xhot, yhot);
+        if (frame == NULL)
+        {
+            XcursorImagesDestroy(native);
+            return None;
+        }
 
-        *target = (alpha << 24) |
-                  ((unsigned char) ((source[0] * alpha) / 255) << 16) |
-                  ((unsigned char) ((source[1] * alpha) / 255) <<  8) |
-                  ((unsigned char) ((source[2] * alpha) / 255) <<  0);
+        frame->delay = delays[native->nimage];
+        native->images[native->nimage] = frame;
     }
 
-    cursor = XcursorImageLoadCursor(_glfw.x11.display, native);
-    XcursorImageDestroy(native);
+    // The server steps the frames itself if it supports animated cursors
+    cursor = XcursorImagesLoadCursor(_glfw.x11.display, native);
+    XcursorImagesDestroy(native);
 
     return cursor;
 }
@@ -1176,6 +1504,7 @@ GLFWbool _glfwConnectX11(int platformID, _GLFWplatform* platform)
         .rawMouseMotionSupported = _glfwRawMouseMotionSupportedX11,
         .createCursor = _glfwCreateCursorX11,
         .createStandardCursor = _glfwCreateStandardCursorX11,
+        .createAnimatedCursor = _glfwCreateAnimatedCursorX11,
         .destroyCursor = _glfwDestroyCursorX11,
         .setCursor = _glfwSetCursorX11,
         .getScancodeName = _glfwGetScancodeNameX11,
@@ -1229,6 +1558,8 @@ GLFWbool _glfwConnectX11(int platformID, _GLFWplatform* platform)
         .windowVisible = _glfwWindowVisibleX11,
         .windowMaximized = _glfwWindowMaximizedX11,
         .windowHovered = _glfwWindowHoveredX11,
+        .windowThrottled = _glfwWindowThrottledX11,
+        .windowOccluded = _glfwWindowOccludedX11,
         .framebufferTransparent = _glfwFramebufferTransparentX11,
         .getWindowOpacity = _glfwGetWindowOpacityX11,
         .setWindowResizable = _glfwSetWindowResizableX11,
@@ -1236,10 +1567,13 @@ GLFWbool _glfwConnectX11(int platformID, _GLFWplatform* platform)
         .setWindowFloating = _glfwSetWindowFloatingX11,
         .setWindowOpacity = _glfwSetWindowOpacityX11,
         .setWindowMousePassthrough = _glfwSetWindowMousePassthroughX11,
+        .setWindowEventMask = _glfwSetWindowEventMaskX11,
+        .presentPixels = _glfwPresentPixelsX11,
         .pollEvents = _glfwPollEventsX11,
         .waitEvents = _glfwWaitEventsX11,
         .waitEventsTimeout = _glfwWaitEventsTimeoutX11,
         .postEmptyEvent = _glfwPostEmptyEventX11,
+        .flush = _glfwFlushX11,
         .getEGLPlatform = _glfwGetEGLPlatformX11,
         .getEGLNativeDisplay = _glfwGetEGLNativeDisplayX11,
         .getEGLNativeWindow = _glfwGetEGLNativeWindowX11,
@@ -1343,8 +1677,12 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateColormap");
     _glfw.x11.xlib.CreateFontCursor = (PFN_XCreateFontCursor)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateFontCursor");
+    _glfw.x11.xlib.CreateGC = (PFN_XCreateGC)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateGC");
     _glfw.x11.xlib.CreateIC = (PFN_XCreateIC)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateIC");
+    _glfw.x11.xlib.CreateImage = (PFN_XCreateImage)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateImage");
     _glfw.x11.xlib.CreateRegion = (PFN_XCreateRegion)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateRegion");
     _glfw.x11.xlib.CreateWindow = (PFN_XCreateWindow)
@@ -1375,6 +1713,8 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XFree");
     _glfw.x11.xlib.FreeColormap = (PFN_XFreeColormap)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XFreeColormap");
+    _glfw.x11.xlib.FreeGC = (PFN_XFreeGC)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XFreeGC");
     _glfw.x11.xlib.FreeCursor = (PFN_XFreeCursor)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XFreeCursor");
     _glfw.x11.xlib.FreeEventData = (PFN_XFreeEventData)
@@ -1427,12 +1767,16 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XPeekEvent");
     _glfw.x11.xlib.Pending = (PFN_XPending)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XPending");
+    _glfw.x11.xlib.PutImage = (PFN_XPutImage)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XPutImage");
     _glfw.x11.xlib.QueryExtension = (PFN_XQueryExtension)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XQueryExtension");
     _glfw.x11.xlib.QueryPointer = (PFN_XQueryPointer)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XQueryPointer");
     _glfw.x11.xlib.RaiseWindow = (PFN_XRaiseWindow)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XRaiseWindow");
+    _glfw.x11.xlib.RefreshKeyboardMapping = (PFN_XRefreshKeyboardMapping)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XRefreshKeyboardMapping");
     _glfw.x11.xlib.RegisterIMInstantiateCallback = (PFN_XRegisterIMInstantiateCallback)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XRegisterIMInstantiateCallback");
     _glfw.x11.xlib.ResizeWindow = (PFN_XResizeWindow)
@@ -1521,6 +1865,8 @@ int _glfwInitX11(void)
     if (_glfw.x11.xlib.utf8LookupString && _glfw.x11.xlib.utf8SetWMProperties)
         _glfw.x11.xlib.utf8 = GLFW_TRUE;
 
+    pthread_mutex_init(&_glfw.x11.extensionLock, NULL);
+
     _glfw.x11.screen = DefaultScreen(_glfw.x11.display);
     _glfw.x11.root = RootWindow(_glfw.x11.display, _glfw.x11.screen);
     _glfw.x11.context = XUniqueContext();
@@ -1534,7 +1880,6 @@ int _glfwInitX11(void)
         return GLFW_FALSE;
 
     _glfw.x11.helperWindowHandle = createHelperWindow();
-    _glfw.x11.hiddenCursorHandle = createHiddenCursor();
 
     if (XSupportsLocale() && _glfw.x11.xlib.utf8)
     {
@@ -1621,6 +1966,12 @@ void _glfwTerminateX11(void)
         _glfw.x11.xrender.handle = NULL;
     }
 
+    if (_glfw.x11.xshm.handle)
+    {
+        _glfwPlatformFreeModule(_glfw.x11.xshm.handle);
+        _glfw.x11.xshm.handle = NULL;
+    }
+
     if (_glfw.x11.vidmode.handle)
     {
         _glfwPlatformFreeModule(_glfw.x11.vidmode.handle);
@@ -1650,6 +2001,8 @@ void _glfwTerminateX11(void)
         close(_glfw.x11.emptyEventPipe[0]);
         close(_glfw.x11.emptyEventPipe[1]);
     }
+
+    pthread_mutex_destroy(&_glfw.x11.extensionLock);
 }
 
 #endif // _GLFW_X11
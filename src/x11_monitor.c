@@ -103,17 +103,13 @@ void _glfwPollMonitorsX11(void)
 {
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
-        int disconnectedCount, screenCount = 0;
+        int disconnectedCount;
         _GLFWmonitor** disconnected = NULL;
-        XineramaScreenInfo* screens = NULL;
         XRRScreenResources* sr = XRRGetScreenResourcesCurrent(_glfw.x11.display,
                                                               _glfw.x11.root);
         RROutput primary = XRRGetOutputPrimary(_glfw.x11.display,
                                                _glfw.x11.root);
 
-        if (_glfw.x11.xinerama.available)
-            screens = XineramaQueryScreens(_glfw.x11.display, &screenCount);
-
         disconnectedCount = _glfw.monitorCount;
         if (disconnectedCount)
         {
@@ -176,18 +172,6 @@ void _glfwPollMonitorsX11(void)
             monitor->x11.output = sr->outputs[i];
             monitor->x11.crtc   = oi->crtc;
 
-            for (j = 0;  j < screenCount;  j++)
-            {
-                if (screens[j].x_org == ci->x &&
-                    screens[j].y_org == ci->y &&
-                    screens[j].width == ci->width &&
-                    screens[j].height == ci->height)
-                {
-                    monitor->x11.index = j;
-                    break;
-                }
-            }
-
             if (monitor->x11.output == primary)
                 type = _GLFW_INSERT_FIRST;
             else
@@ -201,9 +185,6 @@ void _glfwPollMonitorsX11(void)
 
         XRRFreeScreenResources(sr);
 
-        if (screens)
-            XFree(screens);
-
         for (int i = 0;  i < disconnectedCount;  i++)
         {
             if (disconnected[i])
@@ -223,6 +204,47 @@ void _glfwPollMonitorsX11(void)
     }
 }
 
+// Retrieves the index of the Xinerama screen corresponding to the specified
+// monitor, for EWMH full screen window placement
+//
+GLFWbool _glfwGetMonitorXineramaIndexX11(_GLFWmonitor* monitor, int* index)
+{
+    if (!_glfwLoadExtensionX11(_GLFW_X11_XINERAMA))
+        return GLFW_FALSE;
+
+    *index = 0;
+
+    if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
+    {
+        int i, screenCount = 0;
+        XineramaScreenInfo* screens =
+            XineramaQueryScreens(_glfw.x11.display, &screenCount);
+        XRRScreenResources* sr =
+            XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
+        XRRCrtcInfo* ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+
+        for (i = 0;  i < screenCount;  i++)
+        {
+            if (screens[i].x_org == ci->x &&
+                screens[i].y_org == ci->y &&
+                screens[i].width == ci->width &&
+                screens[i].height == ci->height)
+            {
+                *index = i;
+                break;
+            }
+        }
+
+        XRRFreeCrtcInfo(ci);
+        XRRFreeScreenResources(sr);
+
+        if (screens)
+            XFree(screens);
+    }
+
+    return GLFW_TRUE;
+}
+
 // Set the current video mode for the specified monitor
 //
 void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired)
@@ -549,7 +571,7 @@ GLFWbool _glfwGetGammaRampX11(_GLFWmonitor* monitor, GLFWgammaramp* ramp)
         XRRFreeGamma(gamma);
         return GLFW_TRUE;
     }
-    else if (_glfw.x11.vidmode.available)
+    else if (_glfwLoadExtensionX11(_GLFW_X11_VIDMODE))
     {
         int size;
         XF86VidModeGetGammaRampSize(_glfw.x11.display, _glfw.x11.screen, &size);
@@ -589,7 +611,7 @@ void _glfwSetGammaRampX11(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
         XRRSetCrtcGamma(_glfw.x11.display, monitor->x11.crtc, gamma);
         XRRFreeGamma(gamma);
     }
-    else if (_glfw.x11.vidmode.available)
+    else if (_glfwLoadExtensionX11(_GLFW_X11_VIDMODE))
     {
         XF86VidModeSetGammaRamp(_glfw.x11.display,
                                 _glfw.x11.screen,
@@ -28,6 +28,7 @@
 #include <unistd.h>
 #include <signal.h>
 #include <stdint.h>
+#include <pthread.h>
 
 #include <X11/Xlib.h>
 #include <X11/keysym.h>
@@ -50,6 +51,9 @@
 // The Shape extension provides custom window shapes
 #include <X11/extensions/shape.h>
 
+// The MIT-SHM extension provides shared memory presentation of software pixels
+#include <X11/extensions/XShm.h>
+
 #define GLX_VENDOR 1
 #define GLX_RGBA_BIT 0x00000001
 #define GLX_WINDOW_BIT 0x00000001
@@ -109,7 +113,9 @@ typedef Status (* PFN_XCloseIM)(XIM);
 typedef int (* PFN_XConvertSelection)(Display*,Atom,Atom,Atom,Window,Time);
 typedef Colormap (* PFN_XCreateColormap)(Display*,Window,Visual*,int);
 typedef Cursor (* PFN_XCreateFontCursor)(Display*,unsigned int);
+typedef GC (* PFN_XCreateGC)(Display*,Drawable,unsigned long,XGCValues*);
 typedef XIC (* PFN_XCreateIC)(XIM,...);
+typedef XImage* (* PFN_XCreateImage)(Display*,Visual*,unsigned int,int,int,char*,unsigned int,unsigned int,int,int);
 typedef Region (* PFN_XCreateRegion)(void);
 typedef Window (* PFN_XCreateWindow)(Display*,Window,int,int,unsigned int,unsigned int,unsigned int,int,unsigned int,Visual*,unsigned long,XSetWindowAttributes*);
 typedef int (* PFN_XDefineCursor)(Display*,Window,Cursor);
@@ -125,6 +131,7 @@ typedef int (* PFN_XFindContext)(Display*,XID,XContext,XPointer*);
 typedef int (* PFN_XFlush)(Display*);
 typedef int (* PFN_XFree)(void*);
 typedef int (* PFN_XFreeColormap)(Display*,Colormap);
+typedef int (* PFN_XFreeGC)(Display*,GC);
 typedef int (* PFN_XFreeCursor)(Display*,Cursor);
 typedef void (* PFN_XFreeEventData)(Display*,XGenericEventCookie*);
 typedef int (* PFN_XGetErrorText)(Display*,int,char*,int);
@@ -153,9 +160,11 @@ typedef Display* (* PFN_XOpenDisplay)(const char*);
 typedef XIM (* PFN_XOpenIM)(Display*,XrmDatabase*,char*,char*);
 typedef int (* PFN_XPeekEvent)(Display*,XEvent*);
 typedef int (* PFN_XPending)(Display*);
+typedef int (* PFN_XPutImage)(Display*,Drawable,GC,XImage*,int,int,int,int,unsigned int,unsigned int);
 typedef Bool (* PFN_XQueryExtension)(Display*,const char*,int*,int*,int*);
 typedef Bool (* PFN_XQueryPointer)(Display*,Window,Window*,Window*,int*,int*,int*,int*,unsigned int*);
 typedef int (* PFN_XRaiseWindow)(Display*,Window);
+typedef int (* PFN_XRefreshKeyboardMapping)(XMappingEvent*);
 typedef Bool (* PFN_XRegisterIMInstantiateCallback)(Display*,void*,char*,char*,XIDProc,XPointer);
 typedef int (* PFN_XResizeWindow)(Display*,Window,unsigned int,unsigned int);
 typedef char* (* PFN_XResourceManagerString)(Display*);
@@ -211,7 +220,9 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XConvertSelection _glfw.x11.xlib.ConvertSelection
 #define XCreateColormap _glfw.x11.xlib.CreateColormap
 #define XCreateFontCursor _glfw.x11.xlib.CreateFontCursor
+#define XCreateGC _glfw.x11.xlib.CreateGC
 #define XCreateIC _glfw.x11.xlib.CreateIC
+#define XCreateImage _glfw.x11.xlib.CreateImage
 #define XCreateRegion _glfw.x11.xlib.CreateRegion
 #define XCreateWindow _glfw.x11.xlib.CreateWindow
 #define XDefineCursor _glfw.x11.xlib.DefineCursor
@@ -227,6 +238,7 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XFlush _glfw.x11.xlib.Flush
 #define XFree _glfw.x11.xlib.Free
 #define XFreeColormap _glfw.x11.xlib.FreeColormap
+#define XFreeGC _glfw.x11.xlib.FreeGC
 #define XFreeCursor _glfw.x11.xlib.FreeCursor
 #define XFreeEventData _glfw.x11.xlib.FreeEventData
 #define XGetErrorText _glfw.x11.xlib.GetErrorText
@@ -253,9 +265,11 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XOpenIM _glfw.x11.xlib.OpenIM
 #define XPeekEvent _glfw.x11.xlib.PeekEvent
 #define XPending _glfw.x11.xlib.Pending
+#define XPutImage _glfw.x11.xlib.PutImage
 #define XQueryExtension _glfw.x11.xlib.QueryExtension
 #define XQueryPointer _glfw.x11.xlib.QueryPointer
 #define XRaiseWindow _glfw.x11.xlib.RaiseWindow
+#define XRefreshKeyboardMapping _glfw.x11.xlib.RefreshKeyboardMapping
 #define XRegisterIMInstantiateCallback _glfw.x11.xlib.RegisterIMInstantiateCallback
 #define XResizeWindow _glfw.x11.xlib.ResizeWindow
 #define XResourceManagerString _glfw.x11.xlib.ResourceManagerString
@@ -340,12 +354,18 @@ typedef Cursor (* PFN_XcursorImageLoadCursor)(Display*,const XcursorImage*);
 typedef char* (* PFN_XcursorGetTheme)(Display*);
 typedef int (* PFN_XcursorGetDefaultSize)(Display*);
 typedef XcursorImage* (* PFN_XcursorLibraryLoadImage)(const char*,const char*,int);
+typedef XcursorImages* (* PFN_XcursorImagesCreate)(int);
+typedef void (* PFN_XcursorImagesDestroy)(XcursorImages*);
+typedef Cursor (* PFN_XcursorImagesLoadCursor)(Display*,const XcursorImages*);
 #define XcursorImageCreate _glfw.x11.xcursor.ImageCreate
 #define XcursorImageDestroy _glfw.x11.xcursor.ImageDestroy
 #define XcursorImageLoadCursor _glfw.x11.xcursor.ImageLoadCursor
 #define XcursorGetTheme _glfw.x11.xcursor.GetTheme
 #define XcursorGetDefaultSize _glfw.x11.xcursor.GetDefaultSize
 #define XcursorLibraryLoadImage _glfw.x11.xcursor.LibraryLoadImage
+#define XcursorImagesCreate _glfw.x11.xcursor.ImagesCreate
+#define XcursorImagesDestroy _glfw.x11.xcursor.ImagesDestroy
+#define XcursorImagesLoadCursor _glfw.x11.xcursor.ImagesLoadCursor
 
 typedef Bool (* PFN_XineramaIsActive)(Display*);
 typedef Bool (* PFN_XineramaQueryExtension)(Display*,int*,int*);
@@ -391,6 +411,20 @@ typedef void (* PFN_XShapeCombineMask)(Display*,Window,int,int,int,Pixmap,int);
 #define XShapeCombineRegion _glfw.x11.xshape.ShapeCombineRegion
 #define XShapeCombineMask _glfw.x11.xshape.ShapeCombineMask
 
+typedef Bool (* PFN_XShmQueryExtension)(Display*);
+typedef int (* PFN_XShmGetEventBase)(Display*);
+typedef Bool (* PFN_XShmAttach)(Display*,XShmSegmentInfo*);
+typedef Bool (* PFN_XShmDetach)(Display*,XShmSegmentInfo*);
+typedef XImage* (* PFN_XShmCreateImage)(Display*,Visual*,unsigned int,int,char*,XShmSegmentInfo*,unsigned int,unsigned int);
+typedef Bool (* PFN_XShmPutImage)(Display*,Drawable,GC,XImage*,int,int,int,int,unsigned int,unsigned int,Bool);
+
+#define XShmQueryExtension _glfw.x11.xshm.QueryExtension
+#define XShmGetEventBase _glfw.x11.xshm.GetEventBase
+#define XShmAttach _glfw.x11.xshm.Attach
+#define XShmDetach _glfw.x11.xshm.Detach
+#define XShmCreateImage _glfw.x11.xshm.CreateImage
+#define XShmPutImage _glfw.x11.xshm.PutImage
+
 typedef int (*PFNGLXGETFBCONFIGATTRIBPROC)(Display*,GLXFBConfig,int,int*);
 typedef const char* (*PFNGLXGETCLIENTSTRINGPROC)(Display*,int);
 typedef Bool (*PFNGLXQUERYEXTENSIONPROC)(Display*,int*,int*);
@@ -408,6 +442,7 @@ typedef GLXWindow (*PFNGLXCREATEWINDOWPROC)(Display*,GLXFBConfig,Window,const in
 typedef void (*PFNGLXDESTROYWINDOWPROC)(Display*,GLXWindow);
 
 typedef int (*PFNGLXSWAPINTERVALMESAPROC)(int);
+typedef Bool (*PFNGLXGETSYNCVALUESOMLPROC)(Display*,GLXDrawable,int64_t*,int64_t*,int64_t*);
 typedef int (*PFNGLXSWAPINTERVALSGIPROC)(int);
 typedef GLXContext (*PFNGLXCREATECONTEXTATTRIBSARBPROC)(Display*,GLXFBConfig,GLXContext,Bool,const int*);
 
@@ -455,6 +490,17 @@ typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR)(Vk
 #include "xkb_unicode.h"
 #include "posix_poll.h"
 
+// Extensions loaded on first use by _glfwLoadExtensionX11
+#define _GLFW_X11_VIDMODE   0x01
+#define _GLFW_X11_XI        0x02
+#define _GLFW_X11_XCURSOR   0x04
+#define _GLFW_X11_XINERAMA  0x08
+#define _GLFW_X11_XKB       0x10
+#define _GLFW_X11_X11XCB    0x20
+#define _GLFW_X11_XRENDER   0x40
+#define _GLFW_X11_XSHAPE    0x80
+#define _GLFW_X11_XSHM      0x100
+
 #define GLFW_X11_WINDOW_STATE           _GLFWwindowX11 x11;
 #define GLFW_X11_LIBRARY_WINDOW_STATE   _GLFWlibraryX11 x11;
 #define GLFW_X11_MONITOR_STATE          _GLFWmonitorX11 x11;
@@ -503,10 +549,12 @@ typedef struct _GLFWlibraryGLX
     PFNGLXSWAPINTERVALSGIPROC           SwapIntervalSGI;
     PFNGLXSWAPINTERVALEXTPROC           SwapIntervalEXT;
     PFNGLXSWAPINTERVALMESAPROC          SwapIntervalMESA;
+    PFNGLXGETSYNCVALUESOMLPROC          GetSyncValuesOML;
     PFNGLXCREATECONTEXTATTRIBSARBPROC   CreateContextAttribsARB;
     GLFWbool        SGI_swap_control;
     GLFWbool        EXT_swap_control;
     GLFWbool        MESA_swap_control;
+    GLFWbool        OML_sync_control;
     GLFWbool        ARB_multisample;
     GLFWbool        ARB_framebuffer_sRGB;
     GLFWbool        EXT_framebuffer_sRGB;
@@ -518,6 +566,16 @@ typedef struct _GLFWlibraryGLX
     GLFWbool        ARB_context_flush_control;
 } _GLFWlibraryGLX;
 
+// X11-specific shared memory image for presenting software pixels
+//
+typedef struct _GLFWpixelbufferX11
+{
+    XImage*         image;
+    XShmSegmentInfo shminfo;
+    // Serial of the last request reading from the image
+    unsigned long   serial;
+} _GLFWpixelbufferX11;
+
 // X11-specific per-window data
 //
 typedef struct _GLFWwindowX11
@@ -526,17 +584,41 @@ typedef struct _GLFWwindowX11
     Window          handle;
     Window          parent;
     XIC             ic;
+    // Events the input method filters, selected regardless of the event mask
+    long            imEventMask;
 
     GLFWbool        overrideRedirect;
     GLFWbool        iconified;
     GLFWbool        maximized;
+    // Whether the window is mapped, tracked from map and unmap events
+    GLFWbool        mapped;
+    // Whether the window is fully obscured, tracked from visibility events
+    GLFWbool        obscured;
+    // Whether the window manager has hidden the window, tracked from its state
+    GLFWbool        hidden;
 
     // Whether the visual supports framebuffer transparency
     GLFWbool        transparent;
 
-    // Cached position and size used to filter out duplicate events
+    // The visual and depth the window was created with
+    Visual*         visual;
+    int             depth;
+
+    // Position and size tracked from ConfigureNotify, also used to filter out
+    // duplicate events
     int             width, height;
     int             xpos, ypos;
+    // Whether the getters may return the tracked position and size
+    GLFWbool        geometryCached;
+    // Serial of the last move or resize request, or zero once it is reflected
+    // in the tracked position and size
+    unsigned long   configureSerial;
+    // Hash of the images last written to _NET_WM_ICON, or zero if none
+    uint64_t        iconHash;
+    // Whether the cursor is over the window, tracked from crossing events
+    GLFWbool        hovered;
+    // Whether the last cursor position is current, tracked from motion events
+    GLFWbool        cursorCached;
 
     // The last received cursor position, regardless of source
     int             lastCursorPosX, lastCursorPosY;
@@ -546,6 +628,12 @@ typedef struct _GLFWwindowX11
     // The time of the last KeyPress event per keycode, for discarding
     // duplicate key events generated for some keys by ibus
     Time            keyPressTimes[256];
+
+    // Shared memory images for presenting software pixels, used in turn
+    _GLFWpixelbufferX11 pixelBuffers[2];
+    // Index of the image holding the last presented pixels, or -1 if none
+    int             lastPixelBuffer;
+    GC              pixelGC;
 } _GLFWwindowX11;
 
 // X11-specific global data
@@ -560,8 +648,13 @@ typedef struct _GLFWlibraryX11
     float           contentScaleX, contentScaleY;
     // Helper window for IPC
     Window          helperWindowHandle;
-    // Invisible cursor for hidden cursor mode
+    // Invisible cursor for hidden cursor mode, created on first use
     Cursor          hiddenCursorHandle;
+    // Standard cursors shared by all cursor objects of the same shape
+    struct {
+        Cursor      handle;
+        int         count;
+    } standardCursors[_GLFW_STANDARD_CURSOR_COUNT];
     // Context for mapping window XIDs to _GLFWwindow pointers
     XContext        context;
     // XIM input method
@@ -574,8 +667,9 @@ typedef struct _GLFWlibraryX11
     char*           primarySelectionString;
     // Clipboard string (while the selection is owned)
     char*           clipboardString;
-    // Key name string
-    char            keynames[GLFW_KEY_LAST + 1][5];
+    // UTF-8 key names by layout group and X11 keycode, built on first use
+    char            keynames[XkbNumKbdGroups][256][5];
+    GLFWbool        keynamesBuilt[XkbNumKbdGroups];
     // X11 keycode to GLFW key LUT
     short int       keycodes[256];
     // GLFW key to X11 keycode LUT
@@ -585,6 +679,10 @@ typedef struct _GLFWlibraryX11
     // The window whose disabled cursor mode is active
     _GLFWwindow*    disabledCursorWindow;
     int             emptyEventPipe[2];
+    // Extensions whose loading has been attempted and those that succeeded
+    int             loadedExtensions;
+    int             availableExtensions;
+    pthread_mutex_t extensionLock;
 
     // Window manager atoms
     Atom            NET_SUPPORTED;
@@ -604,6 +702,7 @@ typedef struct _GLFWlibraryX11
     Atom            NET_WM_STATE_FULLSCREEN;
     Atom            NET_WM_STATE_MAXIMIZED_VERT;
     Atom            NET_WM_STATE_MAXIMIZED_HORZ;
+    Atom            NET_WM_STATE_HIDDEN;
     Atom            NET_WM_STATE_DEMANDS_ATTENTION;
     Atom            NET_WM_BYPASS_COMPOSITOR;
     Atom            NET_WM_FULLSCREEN_MONITORS;
@@ -657,7 +756,9 @@ typedef struct _GLFWlibraryX11
         PFN_XConvertSelection ConvertSelection;
         PFN_XCreateColormap CreateColormap;
         PFN_XCreateFontCursor CreateFontCursor;
+        PFN_XCreateGC CreateGC;
         PFN_XCreateIC CreateIC;
+        PFN_XCreateImage CreateImage;
         PFN_XCreateRegion CreateRegion;
         PFN_XCreateWindow CreateWindow;
         PFN_XDefineCursor DefineCursor;
@@ -673,6 +774,7 @@ typedef struct _GLFWlibraryX11
         PFN_XFlush Flush;
         PFN_XFree Free;
         PFN_XFreeColormap FreeColormap;
+        PFN_XFreeGC FreeGC;
         PFN_XFreeCursor FreeCursor;
         PFN_XFreeEventData FreeEventData;
         PFN_XGetErrorText GetErrorText;
@@ -699,9 +801,11 @@ typedef struct _GLFWlibraryX11
         PFN_XOpenIM OpenIM;
         PFN_XPeekEvent PeekEvent;
         PFN_XPending Pending;
+        PFN_XPutImage PutImage;
         PFN_XQueryExtension QueryExtension;
         PFN_XQueryPointer QueryPointer;
         PFN_XRaiseWindow RaiseWindow;
+        PFN_XRefreshKeyboardMapping RefreshKeyboardMapping;
         PFN_XRegisterIMInstantiateCallback RegisterIMInstantiateCallback;
         PFN_XResizeWindow ResizeWindow;
         PFN_XResourceManagerString ResourceManagerString;
@@ -810,6 +914,9 @@ typedef struct _GLFWlibraryX11
         PFN_XcursorGetTheme GetTheme;
         PFN_XcursorGetDefaultSize GetDefaultSize;
         PFN_XcursorLibraryLoadImage LibraryLoadImage;
+        PFN_XcursorImagesCreate ImagesCreate;
+        PFN_XcursorImagesDestroy ImagesDestroy;
+        PFN_XcursorImagesLoadCursor ImagesLoadCursor;
     } xcursor;
 
     struct {
@@ -874,6 +981,19 @@ typedef struct _GLFWlibraryX11
         PFN_XShapeQueryVersion QueryVersion;
         PFN_XShapeCombineMask ShapeCombineMask;
     } xshape;
+
+    struct {
+        // Cleared if the server cannot attach our segments, e.g. when remote
+        GLFWbool    available;
+        void*       handle;
+        int         eventBase;
+        PFN_XShmQueryExtension QueryExtension;
+        PFN_XShmGetEventBase GetEventBase;
+        PFN_XShmAttach Attach;
+        PFN_XShmDetach Detach;
+        PFN_XShmCreateImage CreateImage;
+        PFN_XShmPutImage PutImage;
+    } xshm;
 } _GLFWlibraryX11;
 
 // X11-specific per-monitor data
@@ -883,10 +1003,6 @@ typedef struct _GLFWmonitorX11
     RROutput        output;
     RRCrtc          crtc;
     RRMode          oldMode;
-
-    // Index of corresponding Xinerama screen,
-    // for EWMH full screen window placement
-    int             index;
 } _GLFWmonitorX11;
 
 // X11-specific per-cursor data
@@ -894,6 +1010,8 @@ typedef struct _GLFWmonitorX11
 typedef struct _GLFWcursorX11
 {
     Cursor handle;
+    // The standard cursor shape, or zero for image cursors
+    int    shape;
 } _GLFWcursorX11;
 
 
@@ -927,6 +1045,8 @@ GLFWbool _glfwWindowIconifiedX11(_GLFWwindow* window);
 GLFWbool _glfwWindowVisibleX11(_GLFWwindow* window);
 GLFWbool _glfwWindowMaximizedX11(_GLFWwindow* window);
 GLFWbool _glfwWindowHoveredX11(_GLFWwindow* window);
+GLFWbool _glfwWindowThrottledX11(_GLFWwindow* window);
+GLFWbool _glfwWindowOccludedX11(_GLFWwindow* window);
 GLFWbool _glfwFramebufferTransparentX11(_GLFWwindow* window);
 void _glfwSetWindowResizableX11(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowDecoratedX11(_GLFWwindow* window, GLFWbool enabled);
@@ -934,6 +1054,8 @@ void _glfwSetWindowFloatingX11(_GLFWwindow* window, GLFWbool enabled);
 float _glfwGetWindowOpacityX11(_GLFWwindow* window);
 void _glfwSetWindowOpacityX11(_GLFWwindow* window, float opacity);
 void _glfwSetWindowMousePassthroughX11(_GLFWwindow* window, GLFWbool enabled);
+void _glfwSetWindowEventMaskX11(_GLFWwindow* window, int mask);
+void _glfwPresentPixelsX11(_GLFWwindow* window, int width, int height, const unsigned char* pixels, int stride, const int* rects, int count);
 
 void _glfwSetRawMouseMotionX11(_GLFWwindow *window, GLFWbool enabled);
 GLFWbool _glfwRawMouseMotionSupportedX11(void);
@@ -942,6 +1064,7 @@ void _glfwPollEventsX11(void);
 void _glfwWaitEventsX11(void);
 void _glfwWaitEventsTimeoutX11(double timeout);
 void _glfwPostEmptyEventX11(void);
+void _glfwFlushX11(void);
 
 void _glfwGetCursorPosX11(_GLFWwindow* window, double* xpos, double* ypos);
 void _glfwSetCursorPosX11(_GLFWwindow* window, double xpos, double ypos);
@@ -950,6 +1073,7 @@ const char* _glfwGetScancodeNameX11(int scancode);
 int _glfwGetKeyScancodeX11(int key);
 GLFWbool _glfwCreateCursorX11(_GLFWcursor* cursor, const GLFWimage* image, int xhot, int yhot);
 GLFWbool _glfwCreateStandardCursorX11(_GLFWcursor* cursor, int shape);
+GLFWbool _glfwCreateAnimatedCursorX11(_GLFWcursor* cursor, const GLFWimage* images, const int* delays, int count, int xhot, int yhot);
 void _glfwDestroyCursorX11(_GLFWcursor* cursor);
 void _glfwSetCursorX11(_GLFWwindow* window, _GLFWcursor* cursor);
 void _glfwSetClipboardStringX11(const char* string);
@@ -973,10 +1097,15 @@ GLFWbool _glfwGetGammaRampX11(_GLFWmonitor* monitor, GLFWgammaramp* ramp);
 void _glfwSetGammaRampX11(_GLFWmonitor* monitor, const GLFWgammaramp* ramp);
 
 void _glfwPollMonitorsX11(void);
+GLFWbool _glfwGetMonitorXineramaIndexX11(_GLFWmonitor* monitor, int* index);
 void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired);
 void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor);
 
+GLFWbool _glfwLoadExtensionX11(int extension);
+void _glfwUpdateKeyTablesX11(int first, int last);
+
 Cursor _glfwCreateNativeCursorX11(const GLFWimage* image, int xhot, int yhot);
+Cursor _glfwCreateNativeAnimatedCursorX11(const GLFWimage* images, const int* delays, int count, int xhot, int yhot);
 
 unsigned long _glfwGetWindowPropertyX11(Window window,
                                         Atom property,
@@ -32,6 +32,9 @@
 #include <X11/cursorfont.h>
 #include <X11/Xmd.h>
 
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
 #include <poll.h>
 
 #include <string.h>
@@ -130,6 +133,8 @@ static void drainEmptyEvents(void)
         const ssize_t result = read(_glfw.x11.emptyEventPipe[0], dummy, sizeof(dummy));
         if (result == -1 && errno != EINTR)
             break;
+        if (result > 0)
+            _glfw.eventCount++;
     }
 }
 
@@ -138,18 +143,20 @@ static void drainEmptyEvents(void)
 //
 static GLFWbool waitForVisibilityNotify(_GLFWwindow* window)
 {
-    XEvent dummy;
+    XEvent event;
     double timeout = 0.1;
 
     while (!XCheckTypedWindowEvent(_glfw.x11.display,
                                    window->x11.handle,
                                    VisibilityNotify,
-                                   &dummy))
+                                   &event))
     {
         if (!waitForX11Event(&timeout))
             return GLFW_FALSE;
     }
 
+    // The event is consumed here, so record its state for occlusion tracking
+    window->x11.obscured = (event.xvisibility.state == VisibilityFullyObscured);
     return GLFW_TRUE;
 }
 
@@ -177,6 +184,48 @@ static int getWindowState(_GLFWwindow* window)
     return result;
 }
 
+// Retrieves whether the window manager has maximized or hidden the window
+//
+static void getNetWMState(_GLFWwindow* window,
+                          GLFWbool* maximized,
+                          GLFWbool* hidden)
+{
+    Atom* states;
+
+    *maximized = GLFW_FALSE;
+    *hidden = GLFW_FALSE;
+
+    if (!_glfw.x11.NET_WM_STATE)
+        return;
+
+    const GLFWbool canMaximize = _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT &&
+                                 _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ;
+
+    const unsigned long count =
+        _glfwGetWindowPropertyX11(window->x11.handle,
+                                  _glfw.x11.NET_WM_STATE,
+                                  XA_ATOM,
+                                  (unsigned char**) &states);
+
+    for (unsigned long i = 0;  i < count;  i++)
+    {
+        if (canMaximize &&
+            (states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
+             states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ))
+        {
+            *maximized = GLFW_TRUE;
+        }
+        else if (_glfw.x11.NET_WM_STATE_HIDDEN &&
+                 states[i] == _glfw.x11.NET_WM_STATE_HIDDEN)
+        {
+            *hidden = GLFW_TRUE;
+        }
+    }
+
+    if (states)
+        XFree(states);
+}
+
 // Returns whether the event is a selection event
 //
 static Bool isSelectionEvent(Display* display, XEvent* event, XPointer pointer)
@@ -322,15 +371,14 @@ static void updateWindowMode(_GLFWwindow* window)
 {
     if (window->monitor)
     {
-        if (_glfw.x11.xinerama.available &&
-            _glfw.x11.NET_WM_FULLSCREEN_MONITORS)
+        int index;
+
+        if (_glfw.x11.NET_WM_FULLSCREEN_MONITORS &&
+            _glfwGetMonitorXineramaIndexX11(window->monitor, &index))
         {
             sendEventToWM(window,
                           _glfw.x11.NET_WM_FULLSCREEN_MONITORS,
-                          window->monitor->x11.index,
-                          window->monitor->x11.index,
-                          window->monitor->x11.index,
-                          window->monitor->x11.index,
+                          index, index, index, index,
                           0);
         }
 
@@ -452,6 +500,20 @@ static char* convertLatin1toUTF8(const char* source)
     return target;
 }
 
+// Returns the invisible cursor, creating it on first use as that loads Xcursor
+//
+static Cursor getHiddenCursor(void)
+{
+    if (!_glfw.x11.hiddenCursorHandle)
+    {
+        unsigned char pixels[16 * 16 * 4] = { 0 };
+        GLFWimage image = { 16, 16, pixels };
+        _glfw.x11.hiddenCursorHandle = _glfwCreateNativeCursorX11(&image, 0, 0);
+    }
+
+    return _glfw.x11.hiddenCursorHandle;
+}
+
 // Updates the cursor image according to its cursor mode
 //
 static void updateCursorImage(_GLFWwindow* window)
@@ -469,8 +531,7 @@ static void updateCursorImage(_GLFWwindow* window)
     }
     else
     {
-        XDefineCursor(_glfw.x11.display, window->x11.handle,
-                      _glfw.x11.hiddenCursorHandle);
+        XDefineCursor(_glfw.x11.display, window->x11.handle, getHiddenCursor());
     }
 }
 
@@ -561,6 +622,250 @@ static void inputContextDestroyCallback(XIC ic, XPointer clientData, XPointer ca
     window->x11.ic = NULL;
 }
 
+// Returns the X11 event mask to select for the specified window
+//
+static long getEventMask(_GLFWwindow* window)
+{
+    const int mask = window->activeEventMask;
+    long events = StructureNotifyMask | FocusChangeMask |
+                  VisibilityChangeMask | PropertyChangeMask;
+
+    if (mask & GLFW_EVENT_MASK_KEY)
+        events |= KeyPressMask | KeyReleaseMask;
+    if (mask & GLFW_EVENT_MASK_MOUSE_BUTTON)
+        events |= ButtonPressMask | ButtonReleaseMask;
+    if (mask & GLFW_EVENT_MASK_CURSOR_POS)
+        events |= PointerMotionMask;
+    if (mask & GLFW_EVENT_MASK_REFRESH)
+        events |= ExposureMask;
+
+    // The hidden cursor mode workaround needs enter events
+    if ((mask & GLFW_EVENT_MASK_CURSOR_ENTER) ||
+        window->cursorMode == GLFW_CURSOR_HIDDEN)
+    {
+        events |= EnterWindowMask | LeaveWindowMask;
+    }
+
+    // Keep any events the input method needs to see
+    return events | window->x11.imEventMask;
+}
+
+// Returns the event mask that selects the specified core event type, or zero if
+// the event type cannot be selected
+//
+static long getEventTypeMask(int type)
+{
+    switch (type)
+    {
+        case KeyPress:
+            return KeyPressMask;
+        case KeyRelease:
+            return KeyReleaseMask;
+        case ButtonPress:
+            return ButtonPressMask;
+        case ButtonRelease:
+            return ButtonReleaseMask;
+        case MotionNotify:
+            return PointerMotionMask | PointerMotionHintMask | ButtonMotionMask |
+                   Button1MotionMask | Button2MotionMask | Button3MotionMask |
+                   Button4MotionMask | Button5MotionMask;
+        case EnterNotify:
+            return EnterWindowMask;
+        case LeaveNotify:
+            return LeaveWindowMask;
+        case FocusIn:
+        case FocusOut:
+            return FocusChangeMask;
+        case KeymapNotify:
+            return KeymapStateMask;
+        case Expose:
+            return ExposureMask;
+        case VisibilityNotify:
+            return VisibilityChangeMask;
+        case CreateNotify:
+            return SubstructureNotifyMask;
+        case DestroyNotify:
+        case UnmapNotify:
+        case MapNotify:
+        case ReparentNotify:
+        case ConfigureNotify:
+        case GravityNotify:
+        case CirculateNotify:
+            return StructureNotifyMask | SubstructureNotifyMask;
+        case MapRequest:
+        case ConfigureRequest:
+        case CirculateRequest:
+            return SubstructureRedirectMask;
+        case ResizeRequest:
+            return ResizeRedirectMask;
+        case PropertyNotify:
+            return PropertyChangeMask;
+        case ColormapNotify:
+            return ColormapChangeMask;
+    }
+
+    return 0;
+}
+
+// Returns whether the specified core event may be consumed by an input method
+// filter, to avoid walking the Xlib filter list for every event
+//
+static GLFWbool isEventFilterable(const XEvent* event, _GLFWwindow* window)
+{
+    if (event->type == KeyPress || event->type == KeyRelease)
+        return GLFW_TRUE;
+
+    // The input method may register filters on its own windows and for events
+    // that cannot be selected, like the client messages of its transport
+    const long mask = getEventTypeMask(event->type);
+    if (!window || !mask)
+        return GLFW_TRUE;
+
+    // Filters on our windows only ever use events from their input context
+    return (mask & window->x11.imEventMask) != 0;
+}
+
+// Returns whether the hover state tracked from crossing events is current
+//
+static GLFWbool isHoverCached(_GLFWwindow* window)
+{
+    if (_glfw.hints.init.x11.strictQueries)
+        return GLFW_FALSE;
+
+    return (getEventMask(window) & EnterWindowMask) != 0;
+}
+
+// Returns a 64-bit FNV-1a hash of the specified icon images, or zero if there
+// are none
+//
+static uint64_t hashIconImages(int count, const GLFWimage* images)
+{
+    uint64_t hash = 14695981039346656037u;
+
+    if (!count)
+        return 0;
+
+    for (int i = 0;  i < count;  i++)
+    {
+        const int values[2] = { images[i].width, images[i].height };
+        const unsigned char* bytes = (const unsigned char*) values;
+
+        for (size_t j = 0;  j < sizeof(values);  j++)
+            hash = (hash ^ bytes[j]) * 1099511628211u;
+
+        for (int j = 0;  j < images[i].width * images[i].height * 4;  j++)
+            hash = (hash ^ images[i].pixels[j]) * 1099511628211u;
+    }
+
+    return hash;
+}
+
+// Queries the server for whether the cursor is over the window
+//
+static GLFWbool queryWindowHovered(_GLFWwindow* window)
+{
+    Window w = _glfw.x11.root;
+    while (w)
+    {
+        Window root;
+        int rootX, rootY, childX, childY;
+        unsigned int mask;
+
+        _glfwGrabErrorHandlerX11();
+
+        const Bool result = XQueryPointer(_glfw.x11.display, w,
+                                          &root, &w, &rootX, &rootY,
+                                          &childX, &childY, &mask);
+
+        _glfwReleaseErrorHandlerX11();
+
+        if (_glfw.x11.errorCode == BadWindow)
+            w = _glfw.x11.root;
+        else if (!result)
+            return GLFW_FALSE;
+        else if (w == window->x11.handle)
+            return GLFW_TRUE;
+    }
+
+    return GLFW_FALSE;
+}
+
+// Selects the events for the window and resynchronizes the state tracked
+// from them, as any events missed while deselected made it stale
+//
+static void selectWindowInput(_GLFWwindow* window)
+{
+    XSelectInput(_glfw.x11.display, window->x11.handle, getEventMask(window));
+
+    window->x11.cursorCached = GLFW_FALSE;
+    if (isHoverCached(window))
+        window->x11.hovered = queryWindowHovered(window);
+}
+
+// Initializes the context creation API and chooses the visual for the window
+//
+static GLFWbool chooseVisual(const _GLFWwndconfig* wndconfig,
+                             const _GLFWctxconfig* ctxconfig,
+                             const _GLFWfbconfig* fbconfig,
+                             Visual** visual, int* depth)
+{
+    if (ctxconfig->client != GLFW_NO_API)
+    {
+        if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API)
+        {
+            if (!_glfwInitGLX())
+                return GLFW_FALSE;
+            if (!_glfwChooseVisualGLX(wndconfig, ctxconfig, fbconfig, visual, depth))
+                return GLFW_FALSE;
+        }
+        else if (ctxconfig->source == GLFW_EGL_CONTEXT_API)
+        {
+            if (!_glfwInitEGL())
+                return GLFW_FALSE;
+            if (!_glfwChooseVisualEGL(wndconfig, ctxconfig, fbconfig, visual, depth))
+                return GLFW_FALSE;
+        }
+        else if (ctxconfig->source == GLFW_OSMESA_CONTEXT_API)
+        {
+            if (!_glfwInitOSMesa())
+                return GLFW_FALSE;
+        }
+    }
+
+    if (!*visual)
+    {
+        *visual = DefaultVisual(_glfw.x11.display, _glfw.x11.screen);
+        *depth = DefaultDepth(_glfw.x11.display, _glfw.x11.screen);
+    }
+
+    return GLFW_TRUE;
+}
+
+// Creates the context of the window and reads back its attributes
+//
+static GLFWbool createContext(_GLFWwindow* window,
+                              const _GLFWctxconfig* ctxconfig,
+                              const _GLFWfbconfig* fbconfig)
+{
+    if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API)
+    {
+        if (!_glfwCreateContextGLX(window, ctxconfig, fbconfig))
+            return GLFW_FALSE;
+    }
+    else if (ctxconfig->source == GLFW_EGL_CONTEXT_API)
+    {
+        if (!_glfwCreateContextEGL(window, ctxconfig, fbconfig))
+            return GLFW_FALSE;
+    }
+    else if (ctxconfig->source == GLFW_OSMESA_CONTEXT_API)
+    {
+        if (!_glfwCreateContextOSMesa(window, ctxconfig, fbconfig))
+            return GLFW_FALSE;
+    }
+
+    return _glfwRefreshContextAttribs(window, ctxconfig);
+}
+
 // Create the X11 window (and its colormap)
 //
 static GLFWbool createNativeWindow(_GLFWwindow* window,
@@ -591,13 +896,13 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
                                            AllocNone);
 
     window->x11.transparent = _glfwIsVisualTransparentX11(visual);
+    window->x11.visual = visual;
+    window->x11.depth = depth;
+    window->x11.lastPixelBuffer = -1;
 
     XSetWindowAttributes wa = { 0 };
     wa.colormap = window->x11.colormap;
-    wa.event_mask = StructureNotifyMask | KeyPressMask | KeyReleaseMask |
-                    PointerMotionMask | ButtonPressMask | ButtonReleaseMask |
-                    ExposureMask | FocusChangeMask | VisibilityChangeMask |
-                    EnterWindowMask | LeaveWindowMask | PropertyChangeMask;
+    wa.event_mask = getEventMask(window);
 
     _glfwGrabErrorHandlerX11();
 
@@ -784,6 +1089,9 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
     _glfwGetWindowPosX11(window, &window->x11.xpos, &window->x11.ypos);
     _glfwGetWindowSizeX11(window, &window->x11.width, &window->x11.height);
 
+    // From here on the position and size are kept current by ConfigureNotify
+    window->x11.geometryCached = !_glfw.hints.init.x11.strictQueries;
+
     return GLFW_TRUE;
 }
 
@@ -1111,6 +1419,7 @@ static void acquireMonitor(_GLFWwindow* window)
         _glfwGetMonitorPosX11(window->monitor, &xpos, &ypos);
         _glfwGetVideoModeX11(window->monitor, &mode);
 
+        window->x11.configureSerial = NextRequest(_glfw.x11.display);
         XMoveResizeWindow(_glfw.x11.display, window->x11.handle,
                           xpos, ypos, mode.width, mode.height);
     }
@@ -1152,7 +1461,22 @@ static void processEvent(XEvent *event)
     if (event->type == KeyPress || event->type == KeyRelease)
         keycode = event->xkey.keycode;
 
-    filtered = XFilterEvent(event, None);
+    _GLFWwindow* window = NULL;
+
+    // NOTE: Xlib only ever filters core events
+    if (event->type < LASTEvent)
+    {
+        if (XFindContext(_glfw.x11.display,
+                         event->xany.window,
+                         _glfw.x11.context,
+                         (XPointer*) &window) != 0)
+        {
+            window = NULL;
+        }
+
+        if (isEventFilterable(event, window))
+            filtered = XFilterEvent(event, None);
+    }
 
     if (_glfw.x11.randr.available)
     {
@@ -1164,20 +1488,73 @@ static void processEvent(XEvent *event)
         }
     }
 
+    if (_glfw.x11.xshm.available)
+    {
+        // Shared memory images are tracked by request serial instead, which
+        // Xlib updates as these events arrive
+        if (event->type == _glfw.x11.xshm.eventBase + ShmCompletion)
+            return;
+    }
+
     if (_glfw.x11.xkb.available)
     {
         if (event->type == _glfw.x11.xkb.eventBase + XkbEventCode)
         {
-            if (((XkbEvent*) event)->any.xkb_type == XkbStateNotify &&
-                (((XkbEvent*) event)->state.changed & XkbGroupStateMask))
+            const XkbEvent* xkb = (XkbEvent*) event;
+
+            if (xkb->any.xkb_type == XkbStateNotify &&
+                (xkb->state.changed & XkbGroupStateMask))
+            {
+                _glfw.x11.xkb.group = xkb->state.group;
+            }
+            else if (xkb->any.xkb_type == XkbNewKeyboardNotify &&
+                     (xkb->new_kbd.changed & XkbNKN_KeycodesMask))
+            {
+                // The key code range may have changed as well as the names
+                _glfwUpdateKeyTablesX11(0, 255);
+            }
+            else if (xkb->any.xkb_type == XkbMapNotify &&
+                     (xkb->map.changed & XkbKeySymsMask))
+            {
+                _glfwUpdateKeyTablesX11(xkb->map.first_key_sym,
+                                        xkb->map.first_key_sym +
+                                        xkb->map.num_key_syms - 1);
+            }
+            else if (xkb->any.xkb_type == XkbNamesNotify)
             {
-                _glfw.x11.xkb.group = ((XkbEvent*) event)->state.group;
+                if (xkb->names.changed & XkbKeyAliasesMask)
+                    _glfwUpdateKeyTablesX11(0, 255);
+                else if (xkb->names.changed & XkbKeyNamesMask)
+                {
+                    _glfwUpdateKeyTablesX11(xkb->names.first_key,
+                                            xkb->names.first_key +
+                                            xkb->names.num_keys - 1);
+                }
             }
 
             return;
         }
     }
 
+    if (event->type == MappingNotify)
+    {
+        // XKB reports keyboard mapping changes with its own events
+        if (event->xmapping.request == MappingKeyboard)
+        {
+            XRefreshKeyboardMapping(&event->xmapping);
+
+            if (!_glfw.x11.xkb.available &&
+                (_glfw.x11.loadedExtensions & _GLFW_X11_XKB))
+            {
+                _glfwUpdateKeyTablesX11(event->xmapping.first_keycode,
+                                        event->xmapping.first_keycode +
+                                        event->xmapping.count - 1);
+            }
+        }
+
+        return;
+    }
+
     if (event->type == GenericEvent)
     {
         if (_glfw.x11.xi.available)
@@ -1222,11 +1599,7 @@ static void processEvent(XEvent *event)
         return;
     }
 
-    _GLFWwindow* window = NULL;
-    if (XFindContext(_glfw.x11.display,
-                     event->xany.window,
-                     _glfw.x11.context,
-                     (XPointer*) &window) != 0)
+    if (!window)
     {
         // This is an event for a window that has already been destroyed
         return;
@@ -1246,6 +1619,10 @@ static void processEvent(XEvent *event)
             const int mods = translateState(event->xkey.state);
             const int plain = !(mods & (GLFW_MOD_CONTROL | GLFW_MOD_ALT));
 
+            // Key events may be selected only for the input method
+            if (!(window->activeEventMask & GLFW_EVENT_MASK_KEY))
+                return;
+
             if (window->x11.ic)
             {
                 // HACK: Do not report the key press events duplicated by XIM
@@ -1317,6 +1694,10 @@ static void processEvent(XEvent *event)
             const int key = translateKey(keycode);
             const int mods = translateState(event->xkey.state);
 
+            // Key events may be selected only for the input method
+            if (!(window->activeEventMask & GLFW_EVENT_MASK_KEY))
+                return;
+
             if (!_glfw.x11.xkb.detectable)
             {
                 // HACK: Key repeat events will arrive as KeyRelease/KeyPress
@@ -1436,8 +1817,14 @@ static void processEvent(XEvent *event)
             if (window->cursorMode == GLFW_CURSOR_HIDDEN)
                 updateCursorImage(window);
 
-            _glfwInputCursorEnter(window, GLFW_TRUE);
-            _glfwInputCursorPos(window, x, y);
+            window->x11.hovered = GLFW_TRUE;
+            window->x11.cursorCached = GLFW_TRUE;
+
+            // Crossing events may be selected only for the hidden cursor mode
+            if (window->activeEventMask & GLFW_EVENT_MASK_CURSOR_ENTER)
+                _glfwInputCursorEnter(window, GLFW_TRUE);
+            if (window->activeEventMask & GLFW_EVENT_MASK_CURSOR_POS)
+                _glfwInputCursorPos(window, x, y);
 
             window->x11.lastCursorPosX = x;
             window->x11.lastCursorPosY = y;
@@ -1446,7 +1833,11 @@ static void processEvent(XEvent *event)
 
         case LeaveNotify:
         {
-            _glfwInputCursorEnter(window, GLFW_FALSE);
+            window->x11.hovered = GLFW_FALSE;
+            window->x11.cursorCached = GLFW_FALSE;
+
+            if (window->activeEventMask & GLFW_EVENT_MASK_CURSOR_ENTER)
+                _glfwInputCursorEnter(window, GLFW_FALSE);
             return;
         }
 
@@ -1480,11 +1871,20 @@ static void processEvent(XEvent *event)
 
             window->x11.lastCursorPosX = x;
             window->x11.lastCursorPosY = y;
+            window->x11.cursorCached = window->x11.hovered;
             return;
         }
 
         case ConfigureNotify:
         {
+            // Events are received in request order, so this reflects any
+            // pending move or resize request with an earlier serial
+            if (window->x11.configureSerial &&
+                (long) (event->xconfigure.serial - window->x11.configureSerial) >= 0)
+            {
+                window->x11.configureSerial = 0;
+            }
+
             if (event->xconfigure.width != window->x11.width ||
                 event->xconfigure.height != window->x11.height)
             {
@@ -1528,6 +1928,9 @@ static void processEvent(XEvent *event)
                 window->x11.xpos = xpos;
                 window->x11.ypos = ypos;
 
+                // The tracked cursor position is relative to the old position
+                window->x11.cursorCached = GLFW_FALSE;
+
                 _glfwInputWindowPos(window, xpos, ypos);
             }
 
@@ -1789,6 +2192,22 @@ static void processEvent(XEvent *event)
             return;
         }
 
+        case MapNotify:
+        case UnmapNotify:
+        {
+            window->x11.mapped = (event->type == MapNotify);
+            _glfwInputWindowOcclusion(window, _glfwWindowOccludedX11(window));
+            return;
+        }
+
+        case VisibilityNotify:
+        {
+            window->x11.obscured =
+                (event->xvisibility.state == VisibilityFullyObscured);
+            _glfwInputWindowOcclusion(window, _glfwWindowOccludedX11(window));
+            return;
+        }
+
         case PropertyNotify:
         {
             if (event->xproperty.state != PropertyNewValue)
@@ -1813,16 +2232,25 @@ static void processEvent(XEvent *event)
 
                     window->x11.iconified = iconified;
                     _glfwInputWindowIconify(window, iconified);
+                    _glfwInputWindowOcclusion(window, _glfwWindowOccludedX11(window));
                 }
             }
             else if (event->xproperty.atom == _glfw.x11.NET_WM_STATE)
             {
-                const GLFWbool maximized = _glfwWindowMaximizedX11(window);
+                GLFWbool maximized, hidden;
+                getNetWMState(window, &maximized, &hidden);
+
                 if (window->x11.maximized != maximized)
                 {
                     window->x11.maximized = maximized;
                     _glfwInputWindowMaximize(window, maximized);
                 }
+
+                if (window->x11.hidden != hidden)
+                {
+                    window->x11.hidden = hidden;
+                    _glfwInputWindowOcclusion(window, _glfwWindowOccludedX11(window));
+                }
             }
 
             return;
@@ -1834,41 +2262,333 @@ static void processEvent(XEvent *event)
 }
 
 
-//////////////////////////////////////////////////////////////////////////
-//////                       GLFW internal API                      //////
-//////////////////////////////////////////////////////////////////////////
-
-// Retrieve a single window property of the specified type
-// Inspired by fghGetWindowProperty from freeglut
+// Encodes the names of all keys in the specified layout group
 //
-unsigned long _glfwGetWindowPropertyX11(Window window,
-                                        Atom property,
-                                        Atom type,
-                                        unsigned char** value)
+static void buildKeyNames(unsigned int group)
 {
-    Atom actualType;
-    int actualFormat;
-    unsigned long itemCount, bytesAfter;
+    memset(_glfw.x11.keynames[group], 0, sizeof(_glfw.x11.keynames[group]));
 
-    XGetWindowProperty(_glfw.x11.display,
-                       window,
-                       property,
-                       0,
-                       LONG_MAX,
-                       False,
-                       type,
-                       &actualType,
-                       &actualFormat,
-                       &itemCount,
-                       &bytesAfter,
-                       value);
+    for (int scancode = 0;  scancode < 256;  scancode++)
+    {
+        if (_glfw.x11.keycodes[scancode] == GLFW_KEY_UNKNOWN)
+            continue;
 
-    return itemCount;
-}
+        const KeySym keysym = XkbKeycodeToKeysym(_glfw.x11.display,
+                                                 scancode, group, 0);
+        if (keysym == NoSymbol)
+            continue;
 
-GLFWbool _glfwIsVisualTransparentX11(Visual* visual)
-{
-    if (!_glfw.x11.xrender.available)
+        const uint32_t codepoint = _glfwKeySym2Unicode(keysym);
+        if (codepoint == GLFW_INVALID_CODEPOINT)
+            continue;
+
+        char* name = _glfw.x11.keynames[group][scancode];
+        name[_glfwEncodeUTF8(name, codepoint)] = '\0';
+    }
+
+    _glfw.x11.keynamesBuilt[group] = GLFW_TRUE;
+}
+
+// Creates the native cursor for the specified standard shape
+//
+static Cursor createStandardCursor(int shape)
+{
+    Cursor handle = None;
+
+    if (_glfwLoadExtensionX11(_GLFW_X11_XCURSOR))
+    {
+        char* theme = XcursorGetTheme(_glfw.x11.display);
+        if (theme)
+        {
+            const int size = XcursorGetDefaultSize(_glfw.x11.display);
+            const char* name = NULL;
+
+            switch (shape)
+            {
+                case GLFW_ARROW_CURSOR:
+                    name = "default";
+                    break;
+                case GLFW_IBEAM_CURSOR:
+                    name = "text";
+                    break;
+                case GLFW_CROSSHAIR_CURSOR:
+                    name = "crosshair";
+                    break;
+                case GLFW_POINTING_HAND_CURSOR:
+                    name = "pointer";
+                    break;
+                case GLFW_RESIZE_EW_CURSOR:
+                    name = "ew-resize";
+                    break;
+                case GLFW_RESIZE_NS_CURSOR:
+                    name = "ns-resize";
+                    break;
+                case GLFW_RESIZE_NWSE_CURSOR:
+                    name = "nwse-resize";
+                    break;
+                case GLFW_RESIZE_NESW_CURSOR:
+                    name = "nesw-resize";
+                    break;
+                case GLFW_RESIZE_ALL_CURSOR:
+                    name = "all-scroll";
+                    break;
+                case GLFW_NOT_ALLOWED_CURSOR:
+                    name = "not-allowed";
+                    break;
+            }
+
+            XcursorImage* image = XcursorLibraryLoadImage(name, theme, size);
+            if (image)
+            {
+                handle = XcursorImageLoadCursor(_glfw.x11.display, image);
+                XcursorImageDestroy(image);
+            }
+        }
+    }
+
+    if (!handle)
+    {
+        unsigned int native = 0;
+
+        switch (shape)
+        {
+            case GLFW_ARROW_CURSOR:
+                native = XC_left_ptr;
+                break;
+            case GLFW_IBEAM_CURSOR:
+                native = XC_xterm;
+                break;
+            case GLFW_CROSSHAIR_CURSOR:
+                native = XC_crosshair;
+                break;
+            case GLFW_POINTING_HAND_CURSOR:
+                native = XC_hand2;
+                break;
+            case GLFW_RESIZE_EW_CURSOR:
+                native = XC_sb_h_double_arrow;
+                break;
+            case GLFW_RESIZE_NS_CURSOR:
+                native = XC_sb_v_double_arrow;
+                break;
+            case GLFW_RESIZE_ALL_CURSOR:
+                native = XC_fleur;
+                break;
+            default:
+                _glfwInputError(GLFW_CURSOR_UNAVAILABLE,
+                                "X11: Standard cursor shape unavailable");
+                return None;
+        }
+
+        handle = XCreateFontCursor(_glfw.x11.display, native);
+        if (!handle)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "X11: Failed to create standard cursor");
+        }
+    }
+
+    return handle;
+}
+
+
+// Destroys a shared memory image used for presenting software pixels
+//
+static void destroyPixelBuffer(_GLFWpixelbufferX11* buffer)
+{
+    if (!buffer->image)
+        return;
+
+    XShmDetach(_glfw.x11.display, &buffer->shminfo);
+    XDestroyImage(buffer->image);
+    shmdt(buffer->shminfo.shmaddr);
+    memset(buffer, 0, sizeof(_GLFWpixelbufferX11));
+}
+
+// Creates a shared memory image of the specified size for presenting software
+// pixels, or clears the MIT-SHM availability flag if the server cannot use it
+//
+static GLFWbool createPixelBuffer(_GLFWwindow* window,
+                                  _GLFWpixelbufferX11* buffer,
+                                  int width, int height)
+{
+    buffer->image = XShmCreateImage(_glfw.x11.display,
+                                    window->x11.visual,
+                                    window->x11.depth,
+                                    ZPixmap,
+                                    NULL,
+                                    &buffer->shminfo,
+                                    width, height);
+    if (!buffer->image)
+        return GLFW_FALSE;
+
+    buffer->shminfo.shmid = shmget(IPC_PRIVATE,
+                                   buffer->image->bytes_per_line * height,
+                                   IPC_CREAT | 0600);
+    if (buffer->shminfo.shmid == -1)
+    {
+        XDestroyImage(buffer->image);
+        buffer->image = NULL;
+        return GLFW_FALSE;
+    }
+
+    buffer->shminfo.shmaddr = shmat(buffer->shminfo.shmid, NULL, 0);
+    if (buffer->shminfo.shmaddr == (char*) -1)
+    {
+        shmctl(buffer->shminfo.shmid, IPC_RMID, NULL);
+        XDestroyImage(buffer->image);
+        memset(buffer, 0, sizeof(_GLFWpixelbufferX11));
+        return GLFW_FALSE;
+    }
+
+    buffer->shminfo.readOnly = True;
+    buffer->image->data = buffer->shminfo.shmaddr;
+
+    _glfwGrabErrorHandlerX11();
+    XShmAttach(_glfw.x11.display, &buffer->shminfo);
+    XSync(_glfw.x11.display, False);
+    _glfwReleaseErrorHandlerX11();
+
+    // The segment is freed once both we and the server have detached from it
+    shmctl(buffer->shminfo.shmid, IPC_RMID, NULL);
+
+    if (_glfw.x11.errorCode != Success)
+    {
+        shmdt(buffer->shminfo.shmaddr);
+
+        buffer->image->data = NULL;
+        XDestroyImage(buffer->image);
+        memset(buffer, 0, sizeof(_GLFWpixelbufferX11));
+
+        _glfw.x11.xshm.available = GLFW_FALSE;
+        return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Copies the specified rectangles of software pixels into an image
+//
+static void copyPixels(XImage* image,
+                       const unsigned char* pixels,
+                       int stride,
+                       const int* rects,
+                       int count)
+{
+    for (int i = 0;  i < count;  i++)
+    {
+        const int* rect = rects + i * 4;
+
+        for (int y = rect[1];  y < rect[1] + rect[3];  y++)
+        {
+            memcpy(image->data + (size_t) y * image->bytes_per_line + rect[0] * 4,
+                   pixels + (size_t) y * stride + rect[0] * 4,
+                   (size_t) rect[2] * 4);
+        }
+    }
+}
+
+// Presents software pixels through a shared memory image, copying only the
+// damaged areas when the image still holds the previous frame
+//
+static GLFWbool presentPixelsShm(_GLFWwindow* window,
+                                 int width, int height,
+                                 const unsigned char* pixels,
+                                 int stride,
+                                 const int* rects,
+                                 int count)
+{
+    const unsigned long processed = LastKnownRequestProcessed(_glfw.x11.display);
+    const int last = window->x11.lastPixelBuffer;
+    int index;
+
+    // Prefer the image holding the last frame if the server is done with it,
+    // otherwise use the other one
+    if (last >= 0 && window->x11.pixelBuffers[last].serial <= processed)
+        index = last;
+    else
+    {
+        index = last == 0 ? 1 : 0;
+
+        // Wait for the server to finish reading if both images are in use
+        if (window->x11.pixelBuffers[index].serial > processed)
+            XSync(_glfw.x11.display, False);
+    }
+
+    _GLFWpixelbufferX11* buffer = window->x11.pixelBuffers + index;
+    const int whole[4] = { 0, 0, width, height };
+
+    if (buffer->image &&
+        (buffer->image->width != width || buffer->image->height != height))
+    {
+        destroyPixelBuffer(buffer);
+    }
+
+    if (!buffer->image)
+    {
+        if (!createPixelBuffer(window, buffer, width, height))
+            return GLFW_FALSE;
+    }
+
+    if (index == last)
+        copyPixels(buffer->image, pixels, stride, rects, count);
+    else
+        copyPixels(buffer->image, pixels, stride, whole, 1);
+
+    for (int i = 0;  i < count;  i++)
+    {
+        const int* rect = rects + i * 4;
+
+        buffer->serial = NextRequest(_glfw.x11.display);
+        XShmPutImage(_glfw.x11.display,
+                     window->x11.handle,
+                     window->x11.pixelGC,
+                     buffer->image,
+                     rect[0], rect[1],
+                     rect[0], rect[1],
+                     rect[2], rect[3],
+                     True);
+    }
+
+    window->x11.lastPixelBuffer = index;
+    return GLFW_TRUE;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Retrieve a single window property of the specified type
+// Inspired by fghGetWindowProperty from freeglut
+//
+unsigned long _glfwGetWindowPropertyX11(Window window,
+                                        Atom property,
+                                        Atom type,
+                                        unsigned char** value)
+{
+    Atom actualType;
+    int actualFormat;
+    unsigned long itemCount, bytesAfter;
+
+    XGetWindowProperty(_glfw.x11.display,
+                       window,
+                       property,
+                       0,
+                       LONG_MAX,
+                       False,
+                       type,
+                       &actualType,
+                       &actualFormat,
+                       &itemCount,
+                       &bytesAfter,
+                       value);
+
+    return itemCount;
+}
+
+GLFWbool _glfwIsVisualTransparentX11(Visual* visual)
+{
+    if (!_glfwLoadExtensionX11(_GLFW_X11_XRENDER))
         return GLFW_FALSE;
 
     XRenderPictFormat* pf = XRenderFindVisualFormat(_glfw.x11.display, visual);
@@ -1938,15 +2658,13 @@ void _glfwCreateInputContextX11(_GLFWwindow* window)
 
     if (window->x11.ic)
     {
-        XWindowAttributes attribs;
-        XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
-
         unsigned long filter = 0;
         if (XGetICValues(window->x11.ic, XNFilterEvents, &filter, NULL) == NULL)
         {
+            window->x11.imEventMask = (long) filter;
             XSelectInput(_glfw.x11.display,
                          window->x11.handle,
-                         attribs.your_event_mask | filter);
+                         getEventMask(window));
         }
     }
 }
@@ -1964,57 +2682,27 @@ GLFWbool _glfwCreateWindowX11(_GLFWwindow* window,
     Visual* visual = NULL;
     int depth;
 
-    if (ctxconfig->client != GLFW_NO_API)
-    {
-        if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API)
-        {
-            if (!_glfwInitGLX())
-                return GLFW_FALSE;
-            if (!_glfwChooseVisualGLX(wndconfig, ctxconfig, fbconfig, &visual, &depth))
-                return GLFW_FALSE;
-        }
-        else if (ctxconfig->source == GLFW_EGL_CONTEXT_API)
-        {
-            if (!_glfwInitEGL())
-                return GLFW_FALSE;
-            if (!_glfwChooseVisualEGL(wndconfig, ctxconfig, fbconfig, &visual, &depth))
-                return GLFW_FALSE;
-        }
-        else if (ctxconfig->source == GLFW_OSMESA_CONTEXT_API)
-        {
-            if (!_glfwInitOSMesa())
-                return GLFW_FALSE;
-        }
-    }
+    // Key events need the key tables and detectable auto-repeat
+    _glfwLoadExtensionX11(_GLFW_X11_XKB);
 
-    if (!visual)
-    {
-        visual = DefaultVisual(_glfw.x11.display, _glfw.x11.screen);
-        depth = DefaultDepth(_glfw.x11.display, _glfw.x11.screen);
-    }
+    _GLFW_TRACE_BEGIN("chooseVisual");
+    const GLFWbool chosen = chooseVisual(wndconfig, ctxconfig, fbconfig, &visual, &depth);
+    _GLFW_TRACE_END("chooseVisual");
+    if (!chosen)
+        return GLFW_FALSE;
 
-    if (!createNativeWindow(window, wndconfig, visual, depth))
+    _GLFW_TRACE_BEGIN("createNativeWindow");
+    const GLFWbool created = createNativeWindow(window, wndconfig, visual, depth);
+    _GLFW_TRACE_END("createNativeWindow");
+    if (!created)
         return GLFW_FALSE;
 
     if (ctxconfig->client != GLFW_NO_API)
     {
-        if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API)
-        {
-            if (!_glfwCreateContextGLX(window, ctxconfig, fbconfig))
-                return GLFW_FALSE;
-        }
-        else if (ctxconfig->source == GLFW_EGL_CONTEXT_API)
-        {
-            if (!_glfwCreateContextEGL(window, ctxconfig, fbconfig))
-                return GLFW_FALSE;
-        }
-        else if (ctxconfig->source == GLFW_OSMESA_CONTEXT_API)
-        {
-            if (!_glfwCreateContextOSMesa(window, ctxconfig, fbconfig))
-                return GLFW_FALSE;
-        }
-
-        if (!_glfwRefreshContextAttribs(window, ctxconfig))
+        _GLFW_TRACE_BEGIN("createContext");
+        const GLFWbool context = createContext(window, ctxconfig, fbconfig);
+        _GLFW_TRACE_END("createContext");
+        if (!context)
             return GLFW_FALSE;
     }
 
@@ -2061,6 +2749,15 @@ void _glfwDestroyWindowX11(_GLFWwindow* window)
     if (window->context.destroy)
         window->context.destroy(window);
 
+    destroyPixelBuffer(window->x11.pixelBuffers + 0);
+    destroyPixelBuffer(window->x11.pixelBuffers + 1);
+
+    if (window->x11.pixelGC)
+    {
+        XFreeGC(_glfw.x11.display, window->x11.pixelGC);
+        window->x11.pixelGC = NULL;
+    }
+
     if (window->x11.handle)
     {
         XDeleteContext(_glfw.x11.display, window->x11.handle, _glfw.x11.context);
@@ -2098,12 +2795,17 @@ void _glfwSetWindowTitleX11(_GLFWwindow* window, const char* title)
                     _glfw.x11.NET_WM_ICON_NAME, _glfw.x11.UTF8_STRING, 8,
                     PropModeReplace,
                     (unsigned char*) title, strlen(title));
-
-    XFlush(_glfw.x11.display);
 }
 
 void _glfwSetWindowIconX11(_GLFWwindow* window, int count, const GLFWimage* images)
 {
+    // Skip rewriting a possibly large property with the same images
+    const uint64_t hash = hashIconImages(count, images);
+    if (hash == window->x11.iconHash)
+        return;
+
+    window->x11.iconHash = hash;
+
     if (count)
     {
         int longCount = 0;
@@ -2148,17 +2850,18 @@ void _glfwSetWindowIconX11(_GLFWwindow* window, int count, const GLFWimage* imag
         XDeleteProperty(_glfw.x11.display, window->x11.handle,
                         _glfw.x11.NET_WM_ICON);
     }
-
-    XFlush(_glfw.x11.display);
 }
 
 void _glfwGetWindowPosX11(_GLFWwindow* window, int* xpos, int* ypos)
 {
-    Window dummy;
-    int x, y;
+    int x = window->x11.xpos, y = window->x11.ypos;
 
-    XTranslateCoordinates(_glfw.x11.display, window->x11.handle, _glfw.x11.root,
-                          0, 0, &x, &y, &dummy);
+    if (!window->x11.geometryCached || window->x11.configureSerial)
+    {
+        Window dummy;
+        XTranslateCoordinates(_glfw.x11.display, window->x11.handle, _glfw.x11.root,
+                              0, 0, &x, &y, &dummy);
+    }
 
     if (xpos)
         *xpos = x;
@@ -2186,12 +2889,23 @@ void _glfwSetWindowPosX11(_GLFWwindow* window, int xpos, int ypos)
         XFree(hints);
     }
 
+    // The tracked position is stale until the move is reported
+    window->x11.configureSerial = NextRequest(_glfw.x11.display);
     XMoveWindow(_glfw.x11.display, window->x11.handle, xpos, ypos);
-    XFlush(_glfw.x11.display);
 }
 
 void _glfwGetWindowSizeX11(_GLFWwindow* window, int* width, int* height)
 {
+    if (window->x11.geometryCached && !window->x11.configureSerial)
+    {
+        if (width)
+            *width = window->x11.width;
+        if (height)
+            *height = window->x11.height;
+
+        return;
+    }
+
     XWindowAttributes attribs;
     XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
 
@@ -2213,10 +2927,10 @@ void _glfwSetWindowSizeX11(_GLFWwindow* window, int width, int height)
         if (!window->resizable)
             updateNormalHints(window, width, height);
 
+        // The tracked size is stale until the resize is reported
+        window->x11.configureSerial = NextRequest(_glfw.x11.display);
         XResizeWindow(_glfw.x11.display, window->x11.handle, width, height);
     }
-
-    XFlush(_glfw.x11.display);
 }
 
 void _glfwSetWindowSizeLimitsX11(_GLFWwindow* window,
@@ -2226,7 +2940,6 @@ void _glfwSetWindowSizeLimitsX11(_GLFWwindow* window,
     int width, height;
     _glfwGetWindowSizeX11(window, &width, &height);
     updateNormalHints(window, width, height);
-    XFlush(_glfw.x11.display);
 }
 
 void _glfwSetWindowAspectRatioX11(_GLFWwindow* window, int numer, int denom)
@@ -2234,7 +2947,6 @@ void _glfwSetWindowAspectRatioX11(_GLFWwindow* window, int numer, int denom)
     int width, height;
     _glfwGetWindowSizeX11(window, &width, &height);
     updateNormalHints(window, width, height);
-    XFlush(_glfw.x11.display);
 }
 
 void _glfwGetFramebufferSizeX11(_GLFWwindow* window, int* width, int* height)
@@ -2484,6 +3196,7 @@ void _glfwSetWindowMonitorX11(_GLFWwindow* window,
             if (!window->resizable)
                 updateNormalHints(window, width, height);
 
+            window->x11.configureSerial = NextRequest(_glfw.x11.display);
             XMoveResizeWindow(_glfw.x11.display, window->x11.handle,
                               xpos, ypos, width, height);
         }
@@ -2516,6 +3229,7 @@ void _glfwSetWindowMonitorX11(_GLFWwindow* window,
     else
     {
         updateWindowMode(window);
+        window->x11.configureSerial = NextRequest(_glfw.x11.display);
         XMoveResizeWindow(_glfw.x11.display, window->x11.handle,
                           xpos, ypos, width, height);
     }
@@ -2546,64 +3260,31 @@ GLFWbool _glfwWindowVisibleX11(_GLFWwindow* window)
 
 GLFWbool _glfwWindowMaximizedX11(_GLFWwindow* window)
 {
-    Atom* states;
-    GLFWbool maximized = GLFW_FALSE;
-
-    if (!_glfw.x11.NET_WM_STATE ||
-        !_glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
-        !_glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
-    {
-        return maximized;
-    }
-
-    const unsigned long count =
-        _glfwGetWindowPropertyX11(window->x11.handle,
-                                  _glfw.x11.NET_WM_STATE,
-                                  XA_ATOM,
-                                  (unsigned char**) &states);
-
-    for (unsigned long i = 0;  i < count;  i++)
-    {
-        if (states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
-            states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
-        {
-            maximized = GLFW_TRUE;
-            break;
-        }
-    }
-
-    if (states)
-        XFree(states);
+    GLFWbool maximized, hidden;
+    getNetWMState(window, &maximized, &hidden);
 
     return maximized;
 }
 
 GLFWbool _glfwWindowHoveredX11(_GLFWwindow* window)
 {
-    Window w = _glfw.x11.root;
-    while (w)
-    {
-        Window root;
-        int rootX, rootY, childX, childY;
-        unsigned int mask;
-
-        _glfwGrabErrorHandlerX11();
+    if (isHoverCached(window))
+        return window->x11.hovered;
 
-        const Bool result = XQueryPointer(_glfw.x11.display, w,
-                                          &root, &w, &rootX, &rootY,
-                                          &childX, &childY, &mask);
-
-        _glfwReleaseErrorHandlerX11();
+    return queryWindowHovered(window);
+}
 
-        if (_glfw.x11.errorCode == BadWindow)
-            w = _glfw.x11.root;
-        else if (!result)
-            return GLFW_FALSE;
-        else if (w == window->x11.handle)
-            return GLFW_TRUE;
-    }
+GLFWbool _glfwWindowThrottledX11(_GLFWwindow* window)
+{
+    return _glfwWindowOccludedX11(window);
+}
 
-    return GLFW_FALSE;
+GLFWbool _glfwWindowOccludedX11(_GLFWwindow* window)
+{
+    return !window->x11.mapped ||
+           window->x11.iconified ||
+           window->x11.hidden ||
+           window->x11.obscured;
 }
 
 GLFWbool _glfwFramebufferTransparentX11(_GLFWwindow* window)
@@ -2712,7 +3393,7 @@ void _glfwSetWindowFloatingX11(_GLFWwindow* window, GLFWbool enabled)
 
 void _glfwSetWindowMousePassthroughX11(_GLFWwindow* window, GLFWbool enabled)
 {
-    if (!_glfw.x11.xshape.available)
+    if (!_glfwLoadExtensionX11(_GLFW_X11_XSHAPE))
         return;
 
     if (enabled)
@@ -2729,6 +3410,80 @@ void _glfwSetWindowMousePassthroughX11(_GLFWwindow* window, GLFWbool enabled)
     }
 }
 
+void _glfwSetWindowEventMaskX11(_GLFWwindow* window, int mask)
+{
+    selectWindowInput(window);
+}
+
+void _glfwPresentPixelsX11(_GLFWwindow* window,
+                           int width, int height,
+                           const unsigned char* pixels,
+                           int stride,
+                           const int* rects,
+                           int count)
+{
+    const Visual* visual = window->x11.visual;
+
+    if (visual->class != TrueColor ||
+        (window->x11.depth != 24 && window->x11.depth != 32) ||
+        visual->red_mask != 0xff0000 ||
+        visual->green_mask != 0x00ff00 ||
+        visual->blue_mask != 0x0000ff)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "X11: The window visual does not match the pixel format");
+        return;
+    }
+
+    if (!window->x11.pixelGC)
+        window->x11.pixelGC = XCreateGC(_glfw.x11.display, window->x11.handle, 0, NULL);
+
+    if (_glfwLoadExtensionX11(_GLFW_X11_XSHM) && _glfw.x11.xshm.available)
+    {
+        if (presentPixelsShm(window, width, height, pixels, stride, rects, count))
+        {
+            XFlush(_glfw.x11.display);
+            return;
+        }
+    }
+
+    // Without shared memory the pixels are sent over the connection directly
+    // from the caller's memory
+    XImage* image = XCreateImage(_glfw.x11.display,
+                                 window->x11.visual,
+                                 window->x11.depth,
+                                 ZPixmap,
+                                 0,
+                                 (char*) pixels,
+                                 width, height,
+                                 32,
+                                 stride);
+    if (!image)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR, "X11: Failed to create image");
+        return;
+    }
+
+    for (int i = 0;  i < count;  i++)
+    {
+        const int* rect = rects + i * 4;
+
+        XPutImage(_glfw.x11.display,
+                  window->x11.handle,
+                  window->x11.pixelGC,
+                  image,
+                  rect[0], rect[1],
+                  rect[0], rect[1],
+                  rect[2], rect[3]);
+    }
+
+    // The pixel data belongs to the caller
+    image->data = NULL;
+    XDestroyImage(image);
+
+    XFlush(_glfw.x11.display);
+}
+
 float _glfwGetWindowOpacityX11(_GLFWwindow* window)
 {
     float opacity = 1.f;
@@ -2762,7 +3517,7 @@ void _glfwSetWindowOpacityX11(_GLFWwindow* window, float opacity)
 
 void _glfwSetRawMouseMotionX11(_GLFWwindow *window, GLFWbool enabled)
 {
-    if (!_glfw.x11.xi.available)
+    if (!_glfwLoadExtensionX11(_GLFW_X11_XI))
         return;
 
     if (_glfw.x11.disabledCursorWindow != window)
@@ -2776,7 +3531,7 @@ void _glfwSetRawMouseMotionX11(_GLFWwindow *window, GLFWbool enabled)
 
 GLFWbool _glfwRawMouseMotionSupportedX11(void)
 {
-    return _glfw.x11.xi.available;
+    return _glfwLoadExtensionX11(_GLFW_X11_XI);
 }
 
 void _glfwPollEventsX11(void)
@@ -2793,7 +3548,11 @@ void _glfwPollEventsX11(void)
     {
         XEvent event;
         XNextEvent(_glfw.x11.display, &event);
+        _glfw.eventCount++;
+
+        _GLFW_TRACE_BEGIN("processEvent");
         processEvent(&event);
+        _GLFW_TRACE_END("processEvent");
     }
 
     _GLFWwindow* window = _glfw.x11.disabledCursorWindow;
@@ -2831,8 +3590,26 @@ void _glfwPostEmptyEventX11(void)
     writeEmptyEvent();
 }
 
+void _glfwFlushX11(void)
+{
+    XFlush(_glfw.x11.display);
+}
+
 void _glfwGetCursorPosX11(_GLFWwindow* window, double* xpos, double* ypos)
 {
+    // Motion events are only delivered while the cursor is over the window
+    if (window->x11.cursorCached &&
+        isHoverCached(window) &&
+        (getEventMask(window) & PointerMotionMask))
+    {
+        if (xpos)
+            *xpos = window->x11.lastCursorPosX;
+        if (ypos)
+            *ypos = window->x11.lastCursorPosY;
+
+        return;
+    }
+
     Window root, child;
     int rootX, rootY, childX, childY;
     unsigned int mask;
@@ -2854,9 +3631,11 @@ void _glfwSetCursorPosX11(_GLFWwindow* window, double x, double y)
     window->x11.warpCursorPosX = (int) x;
     window->x11.warpCursorPosY = (int) y;
 
+    // The tracked position is stale until the warp is reported
+    window->x11.cursorCached = GLFW_FALSE;
+
     XWarpPointer(_glfw.x11.display, None, window->x11.handle,
                  0,0,0,0, (int) x, (int) y);
-    XFlush(_glfw.x11.display);
 }
 
 void _glfwSetCursorModeX11(_GLFWwindow* window, int mode)
@@ -2895,12 +3674,13 @@ void _glfwSetCursorModeX11(_GLFWwindow* window, int mode)
     }
 
     updateCursorImage(window);
+    selectWindowInput(window);
     XFlush(_glfw.x11.display);
 }
 
 const char* _glfwGetScancodeNameX11(int scancode)
 {
-    if (!_glfw.x11.xkb.available)
+    if (!_glfwLoadExtensionX11(_GLFW_X11_XKB))
         return NULL;
 
     if (scancode < 0 || scancode > 0xff)
@@ -2909,29 +3689,24 @@ const char* _glfwGetScancodeNameX11(int scancode)
         return NULL;
     }
 
-    const int key = _glfw.x11.keycodes[scancode];
-    if (key == GLFW_KEY_UNKNOWN)
+    const unsigned int group = _glfw.x11.xkb.group;
+    if (group >= XkbNumKbdGroups)
         return NULL;
 
-    const KeySym keysym = XkbKeycodeToKeysym(_glfw.x11.display,
-                                             scancode, _glfw.x11.xkb.group, 0);
-    if (keysym == NoSymbol)
-        return NULL;
+    if (!_glfw.x11.keynamesBuilt[group])
+        buildKeyNames(group);
 
-    const uint32_t codepoint = _glfwKeySym2Unicode(keysym);
-    if (codepoint == GLFW_INVALID_CODEPOINT)
+    const char* name = _glfw.x11.keynames[group][scancode];
+    if (name[0] == '\0')
         return NULL;
 
-    const size_t count = _glfwEncodeUTF8(_glfw.x11.keynames[key], codepoint);
-    if (count == 0)
-        return NULL;
-
-    _glfw.x11.keynames[key][count] = '\0';
-    return _glfw.x11.keynames[key];
+    return name;
 }
 
 int _glfwGetKeyScancodeX11(int key)
 {
+    // The key tables are built along with XKB initialization
+    _glfwLoadExtensionX11(_GLFW_X11_XKB);
     return _glfw.x11.scancodes[key];
 }
 
@@ -2946,106 +3721,60 @@ GLFWbool _glfwCreateCursorX11(_GLFWcursor* cursor,
     return GLFW_TRUE;
 }
 
-GLFWbool _glfwCreateStandardCursorX11(_GLFWcursor* cursor, int shape)
+GLFWbool _glfwCreateAnimatedCursorX11(_GLFWcursor* cursor,
+                                      const GLFWimage* images,
+                                      const int* delays,
+                                      int count,
+                                      int xhot, int yhot)
 {
-    if (_glfw.x11.xcursor.handle)
+    cursor->x11.handle =
+        _glfwCreateNativeAnimatedCursorX11(images, delays, count, xhot, yhot);
+    if (!cursor->x11.handle)
     {
-        char* theme = XcursorGetTheme(_glfw.x11.display);
-        if (theme)
-        {
-            const int size = XcursorGetDefaultSize(_glfw.x11.display);
-            const char* name = NULL;
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Failed to create animated cursor");
+        return GLFW_FALSE;
+    }
 
-            switch (shape)
-            {
-                case GLFW_ARROW_CURSOR:
-                    name = "default";
-                    break;
-                case GLFW_IBEAM_CURSOR:
-                    name = "text";
-                    break;
-                case GLFW_CROSSHAIR_CURSOR:
-                    name = "crosshair";
-                    break;
-                case GLFW_POINTING_HAND_CURSOR:
-                    name = "pointer";
-                    break;
-                case GLFW_RESIZE_EW_CURSOR:
-                    name = "ew-resize";
-                    break;
-                case GLFW_RESIZE_NS_CURSOR:
-                    name = "ns-resize";
-                    break;
-                case GLFW_RESIZE_NWSE_CURSOR:
-                    name = "nwse-resize";
-                    break;
-                case GLFW_RESIZE_NESW_CURSOR:
-                    name = "nesw-resize";
-                    break;
-                case GLFW_RESIZE_ALL_CURSOR:
-                    name = "all-scroll";
-                    break;
-                case GLFW_NOT_ALLOWED_CURSOR:
-                    name = "not-allowed";
-                    break;
-            }
+    return GLFW_TRUE;
+}
 
-            XcursorImage* image = XcursorLibraryLoadImage(name, theme, size);
-            if (image)
-            {
-                cursor->x11.handle = XcursorImageLoadCursor(_glfw.x11.display, image);
-                XcursorImageDestroy(image);
-            }
-        }
-    }
+GLFWbool _glfwCreateStandardCursorX11(_GLFWcursor* cursor, int shape)
+{
+    const int index = shape - GLFW_ARROW_CURSOR;
 
-    if (!cursor->x11.handle)
+    if (!_glfw.x11.standardCursors[index].handle)
     {
-        unsigned int native = 0;
-
-        switch (shape)
-        {
-            case GLFW_ARROW_CURSOR:
-                native = XC_left_ptr;
-                break;
-            case GLFW_IBEAM_CURSOR:
-                native = XC_xterm;
-                break;
-            case GLFW_CROSSHAIR_CURSOR:
-                native = XC_crosshair;
-                break;
-            case GLFW_POINTING_HAND_CURSOR:
-                native = XC_hand2;
-                break;
-            case GLFW_RESIZE_EW_CURSOR:
-                native = XC_sb_h_double_arrow;
-                break;
-            case GLFW_RESIZE_NS_CURSOR:
-                native = XC_sb_v_double_arrow;
-                break;
-            case GLFW_RESIZE_ALL_CURSOR:
-                native = XC_fleur;
-                break;
-            default:
-                _glfwInputError(GLFW_CURSOR_UNAVAILABLE,
-                                "X11: Standard cursor shape unavailable");
-                return GLFW_FALSE;
-        }
+        _GLFW_TRACE_BEGIN("createStandardCursor");
+        _glfw.x11.standardCursors[index].handle = createStandardCursor(shape);
+        _GLFW_TRACE_END("createStandardCursor");
 
-        cursor->x11.handle = XCreateFontCursor(_glfw.x11.display, native);
-        if (!cursor->x11.handle)
-        {
-            _glfwInputError(GLFW_PLATFORM_ERROR,
-                            "X11: Failed to create standard cursor");
+        if (!_glfw.x11.standardCursors[index].handle)
             return GLFW_FALSE;
-        }
     }
 
+    _glfw.x11.standardCursors[index].count++;
+    cursor->x11.handle = _glfw.x11.standardCursors[index].handle;
+    cursor->x11.shape = shape;
     return GLFW_TRUE;
 }
 
 void _glfwDestroyCursorX11(_GLFWcursor* cursor)
 {
+    if (cursor->x11.shape)
+    {
+        const int index = cursor->x11.shape - GLFW_ARROW_CURSOR;
+
+        // The native cursor is freed along with its last cursor object
+        if (--_glfw.x11.standardCursors[index].count == 0)
+        {
+            XFreeCursor(_glfw.x11.display, _glfw.x11.standardCursors[index].handle);
+            _glfw.x11.standardCursors[index].handle = None;
+        }
+
+        return;
+    }
+
     if (cursor->x11.handle)
         XFreeCursor(_glfw.x11.display, cursor->x11.handle);
 }
@@ -3054,10 +3783,7 @@ void _glfwSetCursorX11(_GLFWwindow* window, _GLFWcursor* cursor)
 {
     if (window->cursorMode == GLFW_CURSOR_NORMAL ||
         window->cursorMode == GLFW_CURSOR_CAPTURED)
-    {
         updateCursorImage(window);
-        XFlush(_glfw.x11.display);
-    }
 }
 
 void _glfwSetClipboardStringX11(const char* string)
@@ -3138,7 +3864,7 @@ void _glfwGetRequiredInstanceExtensionsX11(char** extensions)
     if (!_glfw.vk.KHR_surface)
         return;
 
-    if (!_glfw.vk.KHR_xcb_surface || !_glfw.x11.x11xcb.handle)
+    if (!_glfw.vk.KHR_xcb_surface || !_glfwLoadExtensionX11(_GLFW_X11_X11XCB))
     {
         if (!_glfw.vk.KHR_xlib_surface)
             return;
@@ -3148,7 +3874,7 @@ void _glfwGetRequiredInstanceExtensionsX11(char** extensions)
 
     // NOTE: VK_KHR_xcb_surface is preferred due to some early ICDs exposing but
     //       not correctly implementing VK_KHR_xlib_surface
-    if (_glfw.vk.KHR_xcb_surface && _glfw.x11.x11xcb.handle)
+    if (_glfw.vk.KHR_xcb_surface && _glfwLoadExtensionX11(_GLFW_X11_X11XCB))
         extensions[1] = "VK_KHR_xcb_surface";
     else
         extensions[1] = "VK_KHR_xlib_surface";
@@ -3161,7 +3887,7 @@ GLFWbool _glfwGetPhysicalDevicePresentationSupportX11(VkInstance instance,
     VisualID visualID = XVisualIDFromVisual(DefaultVisual(_glfw.x11.display,
                                                           _glfw.x11.screen));
 
-    if (_glfw.vk.KHR_xcb_surface && _glfw.x11.x11xcb.handle)
+    if (_glfw.vk.KHR_xcb_surface && _glfwLoadExtensionX11(_GLFW_X11_X11XCB))
     {
         PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR
             vkGetPhysicalDeviceXcbPresentationSupportKHR =
@@ -3212,7 +3938,7 @@ VkResult _glfwCreateWindowSurfaceX11(VkInstance instance,
                                      const VkAllocationCallbacks* allocator,
                                      VkSurfaceKHR* surface)
 {
-    if (_glfw.vk.KHR_xcb_surface && _glfw.x11.x11xcb.handle)
+    if (_glfw.vk.KHR_xcb_surface && _glfwLoadExtensionX11(_GLFW_X11_X11XCB))
     {
         VkResult err;
         VkXcbSurfaceCreateInfoKHR sci;
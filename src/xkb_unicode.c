@@ -29,6 +29,8 @@
 
 #if defined(_GLFW_X11) || defined(_GLFW_WAYLAND)
 
+#include <assert.h>
+
 /*
  * Marcus: This code was originally written by Markus G. Kuhn.
  * I have made some slight changes (trimmed it down a bit from >60 KB to
@@ -40,9 +42,10 @@
  * (UCS, Unicode) values.
  *
  * The array keysymtab[] contains pairs of X11 keysym values for graphical
- * characters and the corresponding Unicode value. The function
- * _glfwKeySym2Unicode() maps a keysym onto a Unicode value using a binary
- * search, therefore keysymtab[] must remain SORTED by keysym value.
+ * characters and the corresponding Unicode value. It is expanded into
+ * a two-level table indexed by keysym page by _glfwInitKeySym2Unicode(), which
+ * the function _glfwKeySym2Unicode() then uses to map a keysym onto a Unicode
+ * value. Keep keysymtab[] SORTED by keysym value.
  *
  * We allow to represent any UCS character in the range U-00000000 to
  * U-00FFFFFF by a keysym value in the range 0x01000000 to 0x01ffffff.
@@ -900,39 +903,69 @@ static const struct codepair {
 };
 
 
+// Maximum number of keysym pages with Unicode values, including Latin-1
+//
+#define KEYSYM_PAGE_COUNT 32
+
+// The Unicode values of keysyms 0x0000 to 0xffff, split into pages of 256
+// keysyms that are only allocated for pages with any Unicode values
+//
+static uint8_t keysymPages[256];
+static uint16_t keysymPageTable[KEYSYM_PAGE_COUNT][256];
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
 
-// Convert XKB KeySym to Unicode
+// Builds the keysym to Unicode page table
 //
-uint32_t _glfwKeySym2Unicode(unsigned int keysym)
+void _glfwInitKeySym2Unicode(void)
 {
-    int min = 0;
-    int max = sizeof(keysymtab) / sizeof(struct codepair) - 1;
-    int mid;
+    int pageCount = 1;
+
+    if (keysymPages[0])
+        return;
 
-    // First check for Latin-1 characters (1:1 mapping)
-    if ((keysym >= 0x0020 && keysym <= 0x007e) ||
-        (keysym >= 0x00a0 && keysym <= 0x00ff))
+    // Latin-1 characters map 1:1 and share the first page
+    keysymPages[0] = pageCount;
+    for (unsigned int keysym = 0x0020;  keysym <= 0x007e;  keysym++)
+        keysymPageTable[0][keysym] = keysym;
+    for (unsigned int keysym = 0x00a0;  keysym <= 0x00ff;  keysym++)
+        keysymPageTable[0][keysym] = keysym;
+
+    for (size_t i = 0;  i < sizeof(keysymtab) / sizeof(keysymtab[0]);  i++)
     {
-        return keysym;
+        const unsigned int page = keysymtab[i].keysym >> 8;
+
+        if (!keysymPages[page])
+        {
+            assert(pageCount < KEYSYM_PAGE_COUNT);
+            keysymPages[page] = ++pageCount;
+        }
+
+        keysymPageTable[keysymPages[page] - 1][keysymtab[i].keysym & 0xff] =
+            keysymtab[i].ucs;
     }
+}
 
-    // Also check for directly encoded 24-bit UCS characters
+// Convert XKB KeySym to Unicode
+//
+uint32_t _glfwKeySym2Unicode(unsigned int keysym)
+{
+    // Check for directly encoded 24-bit UCS characters
     if ((keysym & 0xff000000) == 0x01000000)
         return keysym & 0x00ffffff;
 
-    // Binary search in table
-    while (max >= min)
+    if (keysym <= 0xffff)
     {
-        mid = (min + max) / 2;
-        if (keysymtab[mid].keysym < keysym)
-            min = mid + 1;
-        else if (keysymtab[mid].keysym > keysym)
-            max = mid - 1;
-        else
-            return keysymtab[mid].ucs;
+        const unsigned int page = keysymPages[keysym >> 8];
+        if (page)
+        {
+            const uint32_t ucs = keysymPageTable[page - 1][keysym & 0xff];
+            if (ucs)
+                return ucs;
+        }
     }
 
     // No matching Unicode value found
@@ -26,5 +26,6 @@
 
 #define GLFW_INVALID_CODEPOINT 0xffffffffu
 
+void _glfwInitKeySym2Unicode(void);
 uint32_t _glfwKeySym2Unicode(unsigned int keysym);
 
@@ -72,6 +72,7 @@ static int animate_cursor = GLFW_FALSE;
 static int track_cursor = GLFW_FALSE;
 static GLFWcursor* standard_cursors[10];
 static GLFWcursor* tracking_cursor = NULL;
+static GLFWcursor* animated_cursor = NULL;
 
 static void error_callback(int error, const char* description)
 {
@@ -94,15 +95,13 @@ static float star(int x, int y, float t)
     return (float) fmax(0.f, fmin(1.f, i * salpha * 0.2f + salpha * xalpha * yalpha));
 }
 
-static GLFWcursor* create_cursor_frame(float t)
+static void draw_cursor_frame(unsigned char* buffer, float t)
 {
     int i = 0, x, y;
-    unsigned char buffer[64 * 64 * 4];
-    const GLFWimage image = { 64, 64, buffer };
 
-    for (y = 0;  y < image.width;  y++)
+    for (y = 0;  y < 64;  y++)
     {
-        for (x = 0;  x < image.height;  x++)
+        for (x = 0;  x < 64;  x++)
         {
             buffer[i++] = 255;
             buffer[i++] = 255;
@@ -110,10 +109,40 @@ static GLFWcursor* create_cursor_frame(float t)
             buffer[i++] = (unsigned char) (255 * star(x, y, t));
         }
     }
+}
+
+static GLFWcursor* create_cursor_frame(float t)
+{
+    unsigned char buffer[64 * 64 * 4];
+    const GLFWimage image = { 64, 64, buffer };
 
+    draw_cursor_frame(buffer, t);
     return glfwCreateCursor(&image, image.width / 2, image.height / 2);
 }
 
+static GLFWcursor* create_animated_cursor(void)
+{
+    int i;
+    GLFWimage images[CURSOR_FRAME_COUNT];
+    int delays[CURSOR_FRAME_COUNT];
+    GLFWcursor* cursor;
+    unsigned char* buffer = malloc(CURSOR_FRAME_COUNT * 64 * 64 * 4);
+
+    for (i = 0;  i < CURSOR_FRAME_COUNT;  i++)
+    {
+        images[i].width = 64;
+        images[i].height = 64;
+        images[i].pixels = buffer + i * 64 * 64 * 4;
+        delays[i] = 1000 / 30;
+
+        draw_cursor_frame(images[i].pixels, i / (float) CURSOR_FRAME_COUNT);
+    }
+
+    cursor = glfwCreateAnimatedCursor(images, delays, CURSOR_FRAME_COUNT, 32, 32);
+    free(buffer);
+    return cursor;
+}
+
 static GLFWcursor* create_tracking_cursor(void)
 {
     int i = 0, x, y;
@@ -170,6 +199,16 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
             break;
         }
 
+        case GLFW_KEY_S:
+        {
+            // This animation is stepped by GLFW without any further calls
+            animate_cursor = GLFW_FALSE;
+            if (animated_cursor)
+                glfwSetCursor(window, animated_cursor);
+
+            break;
+        }
+
         case GLFW_KEY_ESCAPE:
         {
             const int mode = glfwGetInputMode(window, GLFW_CURSOR);
@@ -355,6 +394,9 @@ int main(void)
         }
     }
 
+    // This may not be supported on every platform
+    animated_cursor = create_animated_cursor();
+
     for (i = 0;  i < sizeof(standard_cursors) / sizeof(standard_cursors[0]);  i++)
     {
         const int shapes[] = {
@@ -486,6 +528,8 @@ int main(void)
     for (i = 0;  i < CURSOR_FRAME_COUNT;  i++)
         glfwDestroyCursor(star_cursors[i]);
 
+    glfwDestroyCursor(animated_cursor);
+
     for (i = 0;  i < sizeof(standard_cursors) / sizeof(standard_cursors[0]);  i++)
         glfwDestroyCursor(standard_cursors[i]);
 
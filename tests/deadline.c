@@ -0,0 +1,136 @@
+//========================================================================
+// Event wait deadline test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test waits for events until a deadline a few milliseconds after the
+// current raw timer value and fails if any wait returns much later than that
+//
+// It can run headless on the Null platform, although that platform returns
+// from waits immediately as it has no events to wait for
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: deadline [-h] [-n] [-s MICROSECONDS] [-c COUNT]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n use the Null platform\n");
+    printf("  -s the spin margin before each deadline, in microseconds\n");
+    printf("  -c the number of waits\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, count = 100, late = 0;
+    int visible = GLFW_TRUE;
+    double worst = 0.0;
+    GLFWwindow* window;
+
+    while ((ch = getopt(argc, argv, "hns:c:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+                visible = GLFW_FALSE;
+                break;
+
+            case 's':
+                glfwInitHint(GLFW_WAIT_SPIN_MARGIN, atoi(optarg));
+                break;
+
+            case 'c':
+                count = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+    glfwWindowHint(GLFW_VISIBLE, visible);
+
+    window = glfwCreateWindow(200, 200, "Event Wait Deadline", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    const uint64_t frequency = glfwGetTimerFrequency();
+    const uint64_t period = frequency / 200;
+
+    for (i = 0;  i < count && !glfwWindowShouldClose(window);  i++)
+    {
+        const uint64_t deadline = glfwGetTimerValue() + period;
+        glfwWaitEventsUntil(deadline);
+
+        const uint64_t now = glfwGetTimerValue();
+        if (now > deadline)
+        {
+            const double overshoot = (now - deadline) / (double) frequency;
+            if (overshoot > worst)
+                worst = overshoot;
+
+            // Allow for scheduling delays but not for sleeping past the frame
+            if (overshoot > 0.05)
+                late++;
+        }
+    }
+
+    printf("%i waits of %.3f ms, worst overshoot %.3f ms, %i late\n",
+           i, period * 1000.0 / frequency, worst * 1000.0, late);
+
+    glfwTerminate();
+
+    if (late)
+        exit(EXIT_FAILURE);
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,151 @@
+//========================================================================
+// Window event throughput benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This benchmark measures how fast window system events are processed by
+// generating a stream of window move and title change events and timing
+// the event processing that handles them
+//
+// It is best run without a window manager, for example under Xvfb on X11
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static unsigned long moves = 0;
+
+static void usage(void)
+{
+    printf("Usage: eventbench [-h] [-n BATCHES] [-b SIZE]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n the number of batches of requests\n");
+    printf("  -b the number of window moves per batch\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void window_pos_callback(GLFWwindow* window, int xpos, int ypos)
+{
+    moves++;
+}
+
+int main(int argc, char** argv)
+{
+    int ch;
+    unsigned long i, j, batches = 1000, size = 100;
+    double start, polling = 0.0;
+    GLFWwindow* window;
+
+    while ((ch = getopt(argc, argv, "hn:b:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                batches = strtoul(optarg, NULL, 10);
+                break;
+
+            case 'b':
+                size = strtoul(optarg, NULL, 10);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (!batches || !size)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    window = glfwCreateWindow(200, 200, "Event Benchmark", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetWindowPosCallback(window, window_pos_callback);
+    glfwPollEvents();
+    moves = 0;
+
+    start = glfwGetTime();
+
+    for (i = 0;  i < batches;  i++)
+    {
+        double before;
+
+        for (j = 0;  j < size;  j++)
+        {
+            const int offset = (int) (j & 1) * 10;
+
+            // Each move and title change generates at least one event
+            glfwSetWindowPos(window, 100 + offset, 100 + offset);
+            glfwSetWindowTitle(window, (j & 1) ? "Odd" : "Even");
+        }
+
+        glfwFlush();
+
+        before = glfwGetTime();
+        glfwWaitEventsTimeout(0.1);
+        glfwPollEvents();
+        polling += glfwGetTime() - before;
+    }
+
+    // Collect any stragglers before reporting
+    for (i = 0;  i < 10;  i++)
+        glfwWaitEventsTimeout(0.01);
+
+    printf("%lu of %lu window moves reported in %.3f seconds\n",
+           moves, batches * size, glfwGetTime() - start);
+    printf("%.1f ns of event processing per reported move\n",
+           moves ? polling * 1e9 / moves : 0.0);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
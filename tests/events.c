@@ -365,6 +365,14 @@ static void window_maximize_callback(GLFWwindow* window, int maximized)
            maximized ? "maximized" : "unmaximized");
 }
 
+static void window_occlusion_callback(GLFWwindow* window, int occluded)
+{
+    Slot* slot = glfwGetWindowUserPointer(window);
+    printf("%08x to %i at %0.3f: Window was %s\n",
+           counter++, slot->number, glfwGetTime(),
+           occluded ? "occluded" : "unoccluded");
+}
+
 static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
 {
     Slot* slot = glfwGetWindowUserPointer(window);
@@ -643,6 +651,7 @@ int main(int argc, char** argv)
         glfwSetWindowFocusCallback(slots[i].window, window_focus_callback);
         glfwSetWindowIconifyCallback(slots[i].window, window_iconify_callback);
         glfwSetWindowMaximizeCallback(slots[i].window, window_maximize_callback);
+        glfwSetWindowOcclusionCallback(slots[i].window, window_occlusion_callback);
         glfwSetMouseButtonCallback(slots[i].window, mouse_button_callback);
         glfwSetCursorPosCallback(slots[i].window, cursor_position_callback);
         glfwSetCursorEnterCallback(slots[i].window, cursor_enter_callback);
@@ -0,0 +1,198 @@
+//========================================================================
+// Buffer swap statistics test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test swaps the buffers of a window for a number of frames and then
+// prints the frame statistics collected by GLFW
+//
+// It can run headless on the Null platform with OSMesa or EGL
+//
+// With damage enabled it only redraws a small square when the buffer age is
+// known and passes that square as damage to the swap
+//
+//========================================================================
+
+#define GLAD_GL_IMPLEMENTATION
+#include <glad/gl.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: framestats [-h] [-n] [-e] [-d] [-f FRAMES] [-i INTERVAL]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n use the Null platform\n");
+    printf("  -e use EGL for context creation\n");
+    printf("  -d swap with damage and redraw using the buffer age\n");
+    printf("  -f the number of frames to swap\n");
+    printf("  -i the swap interval\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, interval = 1, visible = GLFW_TRUE, egl = GLFW_FALSE;
+    int damage = GLFW_FALSE;
+    unsigned long frame, frames = 300, partial = 0;
+    GLFWwindow* window;
+    GLFWframestats stats;
+
+    while ((ch = getopt(argc, argv, "hnedf:i:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+                visible = GLFW_FALSE;
+                break;
+
+            case 'e':
+                egl = GLFW_TRUE;
+                break;
+
+            case 'd':
+                damage = GLFW_TRUE;
+                break;
+
+            case 'f':
+                frames = strtoul(optarg, NULL, 10);
+                break;
+
+            case 'i':
+                interval = (int) strtol(optarg, NULL, 10);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_VISIBLE, visible);
+
+    if (egl)
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+
+    window = glfwCreateWindow(640, 480, "Frame Statistics", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwMakeContextCurrent(window);
+    gladLoadGL(glfwGetProcAddress);
+    glfwSwapInterval(interval);
+
+    for (frame = 0;  frame < frames && !glfwWindowShouldClose(window);  frame++)
+    {
+        if (damage)
+        {
+            const int rect[4] = { 0, 0, 64, 64 };
+
+            // Only the square changes between frames, so any buffer that has
+            // been shown before needs nothing else redrawn
+            if (glfwGetBufferAge(window) > 0)
+            {
+                glEnable(GL_SCISSOR_TEST);
+                glScissor(rect[0], rect[1], rect[2], rect[3]);
+                partial++;
+            }
+            else
+            {
+                glClearColor(0.f, 0.f, 0.f, 1.f);
+                glClear(GL_COLOR_BUFFER_BIT);
+                glEnable(GL_SCISSOR_TEST);
+                glScissor(rect[0], rect[1], rect[2], rect[3]);
+            }
+
+            glClearColor((frame & 1) ? 1.f : 0.f, 0.f, 0.f, 1.f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glDisable(GL_SCISSOR_TEST);
+
+            glfwSwapBuffersWithDamage(window, rect, 1);
+        }
+        else
+        {
+            glClearColor((frame & 1) ? 1.f : 0.f, 0.f, 0.f, 1.f);
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            glfwSwapBuffers(window);
+        }
+
+        glfwPollEvents();
+    }
+
+    glfwGetFrameStats(window, &stats);
+
+    printf("%llu frames\n", (unsigned long long) stats.frames);
+    printf("Swap time: last %.3f ms, average %.3f ms, max %.3f ms\n",
+           stats.swapTime * 1e3, stats.averageSwapTime * 1e3, stats.maxSwapTime * 1e3);
+    printf("Frame time: last %.3f ms, average %.3f ms\n",
+           stats.frameTime * 1e3, stats.averageFrameTime * 1e3);
+
+    printf("Frame time histogram:\n");
+    for (i = 0;  i < GLFW_FRAME_HISTOGRAM_SIZE;  i++)
+    {
+        if (stats.histogram[i])
+        {
+            printf("  %2i%s ms: %u\n",
+                   i, i == GLFW_FRAME_HISTOGRAM_SIZE - 1 ? "+" : " ",
+                   stats.histogram[i]);
+        }
+    }
+
+    if (stats.syncValues)
+    {
+        printf("UST %lld MSC %lld SBC %lld\n",
+               (long long) stats.ust, (long long) stats.msc, (long long) stats.sbc);
+    }
+    else
+        printf("Presentation counters not available\n");
+
+    if (damage)
+        printf("%lu frames were partially redrawn\n", partial);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
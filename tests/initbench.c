@@ -0,0 +1,211 @@
+//========================================================================
+// Initialization benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//========================================================================
+//
+// This test measures how long it takes to initialize and terminate GLFW
+//
+// It is mainly useful for comparing the startup cost of programs that only
+// need a monitor list or the clipboard, which should not pay for libraries
+// and extensions used only by windows
+//
+// With -k it also measures building the keyboard translation tables, which
+// happens the first time a key scancode or name is needed
+//
+// With -s it also measures creating two of every standard cursor, which loads
+// the cursor theme on platforms that have one
+//
+// The peak resident set size is printed at the end where it is available, for
+// comparing how much memory is held by libraries and themes that were loaded
+//
+//========================================================================
+
+#include "tinycthread.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if !defined(_WIN32)
+ #include <sys/resource.h>
+#endif
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: initbench [-h] [-n] [-k] [-r] [-s] [-v] [-c CYCLES]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n use the Null platform\n");
+    printf("  -k look up a key scancode each cycle\n");
+    printf("  -r keep client API libraries loaded between cycles\n");
+    printf("  -s create two of every standard cursor each cycle\n");
+    printf("  -v query Vulkan support each cycle\n");
+    printf("  -c the number of init and terminate cycles\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+// The GLFW timer is not available while the library is not initialized
+static double get_time(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_REALTIME, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, cycle, cycles = 20, platform = GLFW_ANY_PLATFORM;
+    int retain = GLFW_FALSE, vulkan = GLFW_FALSE, keys = GLFW_FALSE, cursors = GLFW_FALSE;
+    double minInit = 1e9, totalInit = 0.0, totalKeys = 0.0, totalCursors = 0.0;
+    double totalTerminate = 0.0;
+
+    while ((ch = getopt(argc, argv, "hnkrsvc:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                platform = GLFW_PLATFORM_NULL;
+                break;
+
+            case 'k':
+                keys = GLFW_TRUE;
+                break;
+
+            case 'r':
+                retain = GLFW_TRUE;
+                break;
+
+            case 's':
+                cursors = GLFW_TRUE;
+                break;
+
+            case 'v':
+                vulkan = GLFW_TRUE;
+                break;
+
+            case 'c':
+                cycles = (int) strtol(optarg, NULL, 10);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (cycles < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    for (cycle = 0;  cycle < cycles;  cycle++)
+    {
+        const double start = get_time();
+
+        glfwInitHint(GLFW_PLATFORM, platform);
+        glfwInitHint(GLFW_RETAIN_LIBRARIES, retain);
+        if (!glfwInit())
+            exit(EXIT_FAILURE);
+
+        if (vulkan)
+            glfwVulkanSupported();
+
+        const double initialized = get_time();
+
+        if (keys)
+            glfwGetKeyScancode(GLFW_KEY_A);
+
+        const double keyed = get_time();
+
+        if (cursors)
+        {
+            int shape;
+
+            // The second cursor of each shape should be much cheaper to create
+            for (shape = GLFW_ARROW_CURSOR;  shape <= GLFW_NOT_ALLOWED_CURSOR;  shape++)
+            {
+                glfwCreateStandardCursor(shape);
+                glfwCreateStandardCursor(shape);
+            }
+        }
+
+        const double cursored = get_time();
+
+        int count;
+        glfwGetMonitors(&count);
+
+        const double queried = get_time();
+        glfwTerminate();
+        const double terminated = get_time();
+
+        const double init = initialized - start;
+        if (init < minInit)
+            minInit = init;
+
+        totalInit += init;
+        totalKeys += keyed - initialized;
+        totalCursors += cursored - keyed;
+        totalTerminate += terminated - queried;
+    }
+
+    printf("%i cycles\n", cycles);
+    printf("Init: average %.3f ms, min %.3f ms\n",
+           totalInit / cycles * 1e3, minInit * 1e3);
+    if (keys)
+        printf("Key tables: average %.3f ms\n", totalKeys / cycles * 1e3);
+    if (cursors)
+        printf("Cursors: average %.3f ms\n", totalCursors / cycles * 1e3);
+    printf("Terminate: average %.3f ms\n", totalTerminate / cycles * 1e3);
+
+#if !defined(_WIN32)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#if defined(__APPLE__)
+        // macOS reports the peak resident set size in bytes instead of KiB
+        const long peak = (long) (usage.ru_maxrss / 1024);
+#else
+        const long peak = (long) usage.ru_maxrss;
+#endif
+        printf("Peak resident set: %li KiB\n", peak);
+    }
+#endif
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,207 @@
+//========================================================================
+// Joystick API benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This benchmark measures the cost per call of the joystick and gamepad
+// query functions, including retrieving the state of every gamepad one
+// joystick at a time and with a single call to glfwGetAllGamepadStates
+//
+// Connect one or more joysticks before running it
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+typedef struct
+{
+    const char* name;
+    int (*function)(void);
+    int calls;
+} Method;
+
+static GLFWgamepadstate states[GLFW_JOYSTICK_LAST + 1];
+
+static int joystick_present(void)
+{
+    int jid, result = 0;
+
+    for (jid = GLFW_JOYSTICK_1;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+        result += glfwJoystickPresent(jid);
+
+    return result;
+}
+
+static int get_joystick_axes(void)
+{
+    int jid, count, result = 0;
+
+    for (jid = GLFW_JOYSTICK_1;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (glfwGetJoystickAxes(jid, &count))
+            result += count;
+    }
+
+    return result;
+}
+
+static int get_joystick_buttons(void)
+{
+    int jid, count, result = 0;
+
+    for (jid = GLFW_JOYSTICK_1;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (glfwGetJoystickButtons(jid, &count))
+            result += count;
+    }
+
+    return result;
+}
+
+static int get_joystick_hats(void)
+{
+    int jid, count, result = 0;
+
+    for (jid = GLFW_JOYSTICK_1;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (glfwGetJoystickHats(jid, &count))
+            result += count;
+    }
+
+    return result;
+}
+
+static int get_gamepad_state(void)
+{
+    int jid, result = 0;
+
+    for (jid = GLFW_JOYSTICK_1;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+        result += glfwGetGamepadState(jid, states + jid);
+
+    return result;
+}
+
+static int get_all_gamepad_states(void)
+{
+    return glfwGetAllGamepadStates(states, GLFW_JOYSTICK_LAST + 1);
+}
+
+static void usage(void)
+{
+    printf("Usage: joystickbench [-h] [-n ITERATIONS]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n the number of iterations of each method\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, jid, joysticks = 0;
+    unsigned long i, count = 100000, checksum = 0;
+    size_t m;
+    const Method methods[] =
+    {
+        { "glfwJoystickPresent", joystick_present, GLFW_JOYSTICK_LAST + 1 },
+        { "glfwGetJoystickAxes", get_joystick_axes, GLFW_JOYSTICK_LAST + 1 },
+        { "glfwGetJoystickButtons", get_joystick_buttons, GLFW_JOYSTICK_LAST + 1 },
+        { "glfwGetJoystickHats", get_joystick_hats, GLFW_JOYSTICK_LAST + 1 },
+        { "glfwGetGamepadState", get_gamepad_state, GLFW_JOYSTICK_LAST + 1 },
+        { "glfwGetAllGamepadStates", get_all_gamepad_states, 1 }
+    };
+
+    while ((ch = getopt(argc, argv, "hn:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                count = strtoul(optarg, NULL, 10);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (!count)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    for (jid = GLFW_JOYSTICK_1;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (glfwJoystickPresent(jid))
+        {
+            printf("Joystick %i: %s\n", jid, glfwGetJoystickName(jid));
+            joysticks++;
+        }
+    }
+
+    if (!joysticks)
+        printf("No joysticks connected, measuring call overhead only\n");
+
+    printf("Each pass queries all %i joystick IDs once\n",
+           GLFW_JOYSTICK_LAST + 1);
+
+    for (m = 0;  m < sizeof(methods) / sizeof(methods[0]);  m++)
+    {
+        double elapsed;
+        const double start = glfwGetTime();
+
+        for (i = 0;  i < count;  i++)
+            checksum += methods[m].function();
+
+        elapsed = (glfwGetTime() - start) * 1e9;
+
+        printf("%-24s %10.1f ns per pass %10.1f ns per call\n",
+               methods[m].name,
+               elapsed / count,
+               elapsed / ((double) count * methods[m].calls));
+    }
+
+    glfwTerminate();
+
+    printf("(checksum %lu)\n", checksum);
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,202 @@
+//========================================================================
+// Keysym translation test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test checks that the keysym to Unicode translation gives the same
+// result as a binary search of the keysym table for every keysym, and then
+// measures the translation of Cyrillic, kana and Hangul keysym streams
+//
+// The translation is internal to GLFW, so this test builds its source directly
+//
+//========================================================================
+
+#include "xkb_unicode.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "getopt.h"
+
+#define STREAM_LENGTH 4096
+
+static void usage(void)
+{
+    printf("Usage: keysyms [-h] [-i ITERATIONS]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -i the number of times to translate each stream\n");
+}
+
+// The translation as done before the page table, used as the reference
+static uint32_t search_keysym_table(unsigned int keysym)
+{
+    int min = 0;
+    int max = sizeof(keysymtab) / sizeof(struct codepair) - 1;
+
+    if ((keysym >= 0x0020 && keysym <= 0x007e) ||
+        (keysym >= 0x00a0 && keysym <= 0x00ff))
+    {
+        return keysym;
+    }
+
+    if ((keysym & 0xff000000) == 0x01000000)
+        return keysym & 0x00ffffff;
+
+    while (max >= min)
+    {
+        const int mid = (min + max) / 2;
+        if (keysymtab[mid].keysym < keysym)
+            min = mid + 1;
+        else if (keysymtab[mid].keysym > keysym)
+            max = mid - 1;
+        else
+            return keysymtab[mid].ucs;
+    }
+
+    return GLFW_INVALID_CODEPOINT;
+}
+
+// Fills a stream with random keysyms from the specified range that are in the
+// keysym table, mixed with some space and punctuation like typed text
+static void fill_stream(unsigned int* stream, unsigned int first, unsigned int last)
+{
+    int i = 0;
+
+    while (i < STREAM_LENGTH)
+    {
+        const unsigned int keysym = first + rand() % (last - first + 1);
+
+        if (rand() % 8 == 0)
+            stream[i++] = rand() % 2 ? 0x0020 : 0x002e;
+        else if (search_keysym_table(keysym) != GLFW_INVALID_CODEPOINT)
+            stream[i++] = keysym;
+    }
+}
+
+static double translate_stream(const char* name,
+                               const unsigned int* stream,
+                               unsigned long iterations,
+                               uint32_t (*translate)(unsigned int))
+{
+    unsigned long i;
+    int j;
+    uint32_t sum = 0;
+    const clock_t start = clock();
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        for (j = 0;  j < STREAM_LENGTH;  j++)
+            sum += translate(stream[j]);
+    }
+
+    const double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+    const double count = (double) iterations * STREAM_LENGTH;
+
+    printf("  %-8s %7.2f ns per keysym (checksum %08x)\n",
+           name, elapsed / count * 1e9, sum);
+
+    return elapsed;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, failures = 0;
+    unsigned long keysym, iterations = 2000;
+    unsigned int stream[STREAM_LENGTH];
+
+    const struct
+    {
+        const char* name;
+        unsigned int first, last;
+    } scripts[] =
+    {
+        { "Cyrillic", 0x06a1, 0x06ff },
+        { "Kana", 0x04a1, 0x04df },
+        { "Hangul", 0x0ea1, 0x0efa }
+    };
+
+    while ((ch = getopt(argc, argv, "hi:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'i':
+                iterations = strtoul(optarg, NULL, 10);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    _glfwInitKeySym2Unicode();
+
+    // Check every keysym up to and including the directly encoded UCS range,
+    // plus some above it
+    for (keysym = 0;  keysym <= 0x02000100;  keysym++)
+    {
+        const uint32_t expected = search_keysym_table((unsigned int) keysym);
+        const uint32_t actual = _glfwKeySym2Unicode((unsigned int) keysym);
+
+        if (actual != expected)
+        {
+            if (failures < 10)
+            {
+                printf("Keysym 0x%08lx: expected 0x%08x, got 0x%08x\n",
+                       keysym, expected, actual);
+            }
+
+            failures++;
+        }
+    }
+
+    if (failures)
+    {
+        printf("%i keysyms translated differently\n", failures);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("All keysyms translated identically\n");
+
+    srand(1);
+
+    for (i = 0;  i < sizeof(scripts) / sizeof(scripts[0]);  i++)
+    {
+        fill_stream(stream, scripts[i].first, scripts[i].last);
+
+        printf("%s:\n", scripts[i].name);
+        const double search = translate_stream("Search", stream, iterations,
+                                               search_keysym_table);
+        const double table = translate_stream("Table", stream, iterations,
+                                              _glfwKeySym2Unicode);
+        printf("  %.1fx faster\n", search / table);
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,223 @@
+//========================================================================
+// Software pixel presentation test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test presents a square moving across a gradient in a window without
+// a context, passing only the areas covered by the square as damage
+//
+// It can optionally wait for the window system to be ready for each frame and
+// reports how many frames were skipped while the window was throttled
+//
+// It can run headless on the Null platform
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "getopt.h"
+
+#define SQUARE_SIZE 64
+
+static void usage(void)
+{
+    printf("Usage: pixels [-h] [-n] [-f] [-w] [-F FRAMES]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n use the Null platform\n");
+    printf("  -f present the whole image every frame\n");
+    printf("  -w wait for the window system to be ready for each frame\n");
+    printf("  -F the number of frames to present\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, GLFW_TRUE);
+}
+
+static void fill_background(unsigned char* pixels, int width, int height,
+                            int x, int y, int w, int h)
+{
+    int i, j;
+
+    for (j = y;  j < y + h;  j++)
+    {
+        unsigned char* pixel = pixels + ((size_t) j * width + x) * 4;
+
+        for (i = x;  i < x + w;  i++)
+        {
+            *pixel++ = (unsigned char) (j * 255 / height);
+            *pixel++ = 0x40;
+            *pixel++ = (unsigned char) (i * 255 / width);
+            *pixel++ = 0xff;
+        }
+    }
+}
+
+static void fill_square(unsigned char* pixels, int width, int x, int y)
+{
+    int i;
+
+    for (i = y;  i < y + SQUARE_SIZE;  i++)
+        memset(pixels + ((size_t) i * width + x) * 4, 0xff, SQUARE_SIZE * 4);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, width = 0, height = 0, x = 0, y = 0, dx = 3, dy = 2;
+    int visible = GLFW_TRUE, full = GLFW_FALSE, wait = GLFW_FALSE;
+    unsigned long frame, frames = ~0ul, skipped = 0;
+    unsigned char* pixels = NULL;
+    GLFWwindow* window;
+    double start;
+
+    while ((ch = getopt(argc, argv, "hnfwF:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+                visible = GLFW_FALSE;
+                break;
+
+            case 'f':
+                full = GLFW_TRUE;
+                break;
+
+            case 'w':
+                wait = GLFW_TRUE;
+                break;
+
+            case 'F':
+                frames = strtoul(optarg, NULL, 10);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+    glfwWindowHint(GLFW_VISIBLE, visible);
+
+    window = glfwCreateWindow(640, 480, "Software Pixels", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetKeyCallback(window, key_callback);
+
+    start = glfwGetTime();
+
+    for (frame = 0;  frame < frames && !glfwWindowShouldClose(window);  frame++)
+    {
+        int fbWidth, fbHeight, rects[8];
+
+        if (wait && !glfwWaitForFrame(window, 0.1))
+        {
+            skipped++;
+            continue;
+        }
+
+        glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+        if (fbWidth < SQUARE_SIZE || fbHeight < SQUARE_SIZE)
+        {
+            glfwWaitEvents();
+            continue;
+        }
+
+        if (fbWidth != width || fbHeight != height)
+        {
+            width = fbWidth;
+            height = fbHeight;
+            x = y = 0;
+
+            free(pixels);
+            pixels = malloc((size_t) width * height * 4);
+            fill_background(pixels, width, height, 0, 0, width, height);
+            fill_square(pixels, width, x, y);
+
+            glfwPresentPixels(window, width, height, pixels, width * 4, NULL, 0);
+            glfwPollEvents();
+            continue;
+        }
+
+        // Erase the square at its old position and draw it at the new one
+        rects[0] = x;
+        rects[1] = y;
+        rects[2] = rects[3] = SQUARE_SIZE;
+        fill_background(pixels, width, height, x, y, SQUARE_SIZE, SQUARE_SIZE);
+
+        if (x + dx < 0 || x + dx > width - SQUARE_SIZE)
+            dx = -dx;
+        if (y + dy < 0 || y + dy > height - SQUARE_SIZE)
+            dy = -dy;
+
+        x += dx;
+        y += dy;
+
+        rects[4] = x;
+        rects[5] = y;
+        rects[6] = rects[7] = SQUARE_SIZE;
+        fill_square(pixels, width, x, y);
+
+        if (full)
+            glfwPresentPixels(window, width, height, pixels, width * 4, NULL, 0);
+        else
+            glfwPresentPixels(window, width, height, pixels, width * 4, rects, 2);
+
+        glfwPollEvents();
+    }
+
+    printf("Presented %lu frames in %.3f seconds\n",
+           frame - skipped, glfwGetTime() - start);
+    if (wait)
+        printf("Skipped %lu frames while throttled\n", skipped);
+
+    free(pixels);
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,185 @@
+//========================================================================
+// Entry point loading benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test measures how long it takes to load every OpenGL entry point known
+// to the bundled glad loader, first for a single context and then for a number
+// of additional contexts sharing the entry point cache of the first
+//
+// It can run headless on the Null platform with OSMesa or EGL
+//
+//========================================================================
+
+#define GLAD_GL_IMPLEMENTATION
+#include <glad/gl.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "getopt.h"
+
+#define MAX_NAMES 4096
+
+static const char* names[MAX_NAMES];
+static GLFWglproc procs[MAX_NAMES];
+static int name_count = 0;
+
+static void usage(void)
+{
+    printf("Usage: procbench [-h] [-n] [-e] [-c CONTEXTS]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n use the Null platform\n");
+    printf("  -e use EGL for context creation\n");
+    printf("  -c the number of additional contexts to create\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static GLADapiproc record_proc(void* userptr, const char* name)
+{
+    if (name_count < MAX_NAMES)
+    {
+        names[name_count] = strdup(name);
+        name_count++;
+    }
+
+    return (GLADapiproc) glfwGetProcAddress(name);
+}
+
+static double time_bulk(void)
+{
+    const double start = glfwGetTime();
+    glfwGetProcAddresses(names, procs, name_count);
+    return glfwGetTime() - start;
+}
+
+static double time_single(void)
+{
+    int i;
+    const double start = glfwGetTime();
+
+    for (i = 0;  i < name_count;  i++)
+        procs[i] = glfwGetProcAddress(names[i]);
+
+    return glfwGetTime() - start;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, found, contexts = 16, visible = GLFW_TRUE, egl = GLFW_FALSE;
+    GLFWwindow* first;
+    GLFWwindow** windows;
+    double total = 0.0;
+
+    while ((ch = getopt(argc, argv, "hnec:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+                visible = GLFW_FALSE;
+                break;
+
+            case 'e':
+                egl = GLFW_TRUE;
+                break;
+
+            case 'c':
+                contexts = (int) strtol(optarg, NULL, 10);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_VISIBLE, visible);
+
+    if (egl)
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+
+    first = glfwCreateWindow(640, 480, "Entry Point Benchmark", NULL, NULL);
+    if (!first)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwMakeContextCurrent(first);
+
+    // Record the name of every entry point glad asks for
+    {
+        const double start = glfwGetTime();
+        gladLoadGLUserPtr(record_proc, NULL);
+        printf("First context: %i entry points loaded by glad in %.3f ms\n",
+               name_count, (glfwGetTime() - start) * 1e3);
+    }
+
+    found = glfwGetProcAddresses(names, procs, name_count);
+    printf("First context: %i of %i entry points found\n", found, name_count);
+    printf("First context: bulk reload in %.3f ms\n", time_bulk() * 1e3);
+    printf("First context: one at a time in %.3f ms\n", time_single() * 1e3);
+
+    windows = calloc(contexts, sizeof(GLFWwindow*));
+
+    for (i = 0;  i < contexts;  i++)
+    {
+        windows[i] = glfwCreateWindow(640, 480, "Entry Point Benchmark", NULL, NULL);
+        if (!windows[i])
+            break;
+
+        glfwMakeContextCurrent(windows[i]);
+        total += time_bulk();
+    }
+
+    if (i > 0)
+    {
+        printf("%i additional contexts: %.3f ms per context\n",
+               i, total / i * 1e3);
+    }
+
+    for (i = 0;  i < name_count;  i++)
+        free((void*) names[i]);
+
+    free(windows);
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
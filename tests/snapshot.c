@@ -0,0 +1,215 @@
+//========================================================================
+// Gamepad state snapshot stress test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test hammers glfwGetGamepadStateSnapshot from many reader threads
+// while the main thread (and optionally the joystick service thread)
+// publishes new state, and verifies that no torn state is ever observed
+//
+// Move the sticks and press buttons on connected gamepads while it runs
+//
+//========================================================================
+
+#include "tinycthread.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+#define MAX_THREADS 64
+
+typedef struct
+{
+    thrd_t id;
+    unsigned long reads;
+    unsigned long present;
+    unsigned long invalid;
+} Reader;
+
+static volatile int running = GLFW_TRUE;
+
+static void usage(void)
+{
+    printf("Usage: snapshot [-h] [-s] [-n THREADS] [-t SECONDS]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -s use the joystick service thread\n");
+    printf("  -n the number of reader threads\n");
+    printf("  -t the number of seconds to run\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static int is_valid_state(const GLFWgamepadstate* state)
+{
+    int i;
+
+    for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
+    {
+        if (state->buttons[i] != GLFW_PRESS && state->buttons[i] != GLFW_RELEASE)
+            return GLFW_FALSE;
+    }
+
+    for (i = 0;  i <= GLFW_GAMEPAD_AXIS_LAST;  i++)
+    {
+        if (!(state->axes[i] >= -1.f && state->axes[i] <= 1.f))
+            return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
+static int reader_main(void* data)
+{
+    Reader* reader = data;
+
+    while (running)
+    {
+        int jid;
+
+        for (jid = GLFW_JOYSTICK_1;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+        {
+            GLFWgamepadstate state;
+
+            if (glfwGetGamepadStateSnapshot(jid, &state))
+                reader->present++;
+
+            if (!is_valid_state(&state))
+                reader->invalid++;
+
+            reader->reads++;
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, count = 8, threaded = GLFW_FALSE;
+    double duration = 5.0, start;
+    unsigned long reads = 0, present = 0, invalid = 0, publishes = 0;
+    Reader readers[MAX_THREADS] = {{0}};
+
+    while ((ch = getopt(argc, argv, "hsn:t:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 's':
+                threaded = GLFW_TRUE;
+                break;
+
+            case 'n':
+                count = (int) strtoul(optarg, NULL, 10);
+                break;
+
+            case 't':
+                duration = atof(optarg);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (count < 1 || count > MAX_THREADS)
+    {
+        fprintf(stderr, "Reader thread count must be between 1 and %i\n",
+                MAX_THREADS);
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+    glfwInitHint(GLFW_JOYSTICK_THREAD, threaded);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    for (i = 0;  i < count;  i++)
+    {
+        if (thrd_create(&readers[i].id, reader_main, readers + i) != thrd_success)
+        {
+            fprintf(stderr, "Failed to create reader thread\n");
+
+            glfwTerminate();
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    start = glfwGetTime();
+
+    while (glfwGetTime() - start < duration)
+    {
+        int jid;
+
+        glfwPollEvents();
+
+        // Publish from the main thread as well, concurrently with any
+        // publishing done by the joystick service thread
+        for (jid = GLFW_JOYSTICK_1;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+        {
+            GLFWgamepadstate state;
+            glfwGetGamepadState(jid, &state);
+            publishes++;
+        }
+    }
+
+    running = GLFW_FALSE;
+
+    for (i = 0;  i < count;  i++)
+    {
+        int result;
+        thrd_join(readers[i].id, &result);
+
+        reads += readers[i].reads;
+        present += readers[i].present;
+        invalid += readers[i].invalid;
+    }
+
+    glfwTerminate();
+
+    printf("%i reader threads, %s\n",
+           count, threaded ? "joystick service thread" : "main thread publishing");
+    printf("%lu snapshot reads (%.0f per second), %lu with a gamepad present\n",
+           reads, reads / duration, present);
+    printf("%lu main thread polls\n", publishes);
+    printf("%lu invalid snapshots\n", invalid);
+
+    if (invalid)
+        exit(EXIT_FAILURE);
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,202 @@
+//========================================================================
+// Tracing test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test sets a trace callback, creates a window and swaps its buffers for
+// a number of frames and then prints the time spent in each traced span
+//
+// It can run headless on the Null platform with OSMesa or EGL
+//
+//========================================================================
+
+#define GLAD_GL_IMPLEMENTATION
+#include <glad/gl.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "getopt.h"
+
+#define MAX_SPANS 32
+#define MAX_DEPTH 32
+
+typedef struct Span
+{
+    const char* name;
+    unsigned long count;
+    uint64_t total;
+    uint64_t max;
+} Span;
+
+static Span spans[MAX_SPANS];
+static int span_count;
+static uint64_t stack[MAX_DEPTH];
+static int depth;
+
+static void usage(void)
+{
+    printf("Usage: tracing [-h] [-n] [-e] [-f FRAMES]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n use the Null platform\n");
+    printf("  -e use EGL for context creation\n");
+    printf("  -f the number of frames to swap\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static Span* find_span(const char* name)
+{
+    int i;
+
+    for (i = 0;  i < span_count;  i++)
+    {
+        if (strcmp(spans[i].name, name) == 0)
+            return spans + i;
+    }
+
+    if (span_count == MAX_SPANS)
+        return NULL;
+
+    spans[span_count].name = name;
+    return spans + span_count++;
+}
+
+static void trace_callback(int event, const char* name, uint64_t time)
+{
+    if (event == GLFW_TRACE_BEGIN)
+    {
+        if (depth < MAX_DEPTH)
+            stack[depth] = time;
+
+        depth++;
+    }
+    else
+    {
+        depth--;
+
+        if (depth < MAX_DEPTH)
+        {
+            Span* span = find_span(name);
+            if (span)
+            {
+                const uint64_t elapsed = time - stack[depth];
+
+                span->count++;
+                span->total += elapsed;
+                if (elapsed > span->max)
+                    span->max = elapsed;
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, visible = GLFW_TRUE, egl = GLFW_FALSE;
+    unsigned long frame, frames = 300;
+    GLFWwindow* window;
+
+    while ((ch = getopt(argc, argv, "hnef:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+                visible = GLFW_FALSE;
+                break;
+
+            case 'e':
+                egl = GLFW_TRUE;
+                break;
+
+            case 'f':
+                frames = strtoul(optarg, NULL, 10);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwSetTraceCallback(trace_callback);
+
+    glfwWindowHint(GLFW_VISIBLE, visible);
+
+    if (egl)
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+
+    window = glfwCreateWindow(640, 480, "Tracing", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwMakeContextCurrent(window);
+    gladLoadGL(glfwGetProcAddress);
+
+    for (frame = 0;  frame < frames && !glfwWindowShouldClose(window);  frame++)
+    {
+        glClearColor((frame & 1) ? 1.f : 0.f, 0.f, 0.f, 1.f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+    }
+
+    if (span_count == 0)
+        printf("No spans traced\n");
+
+    for (i = 0;  i < span_count;  i++)
+    {
+        const double frequency = (double) glfwGetTimerFrequency();
+
+        printf("%-24s %8lu calls, total %9.3f ms, average %7.3f ms, max %7.3f ms\n",
+               spans[i].name,
+               spans[i].count,
+               spans[i].total / frequency * 1e3,
+               spans[i].total / frequency * 1e3 / spans[i].count,
+               spans[i].max / frequency * 1e3);
+    }
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}